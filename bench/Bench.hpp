@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+/**
+ * Minimal benchmark helpers shared by the bench executable
+ */
+namespace bench {
+
+// Keep a value alive so the optimizer cannot drop the computation
+template <typename T> inline void doNotOptimize(const T &value) {
+  static volatile const T *sink;
+  sink = &value;
+  (void)sink;
+}
+
+// Average nanoseconds per call of fn over the given iterations
+template <typename Fn> double nsPerOp(std::size_t iterations, Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         static_cast<double>(iterations);
+}
+
+inline void reportTime(const char *name, double ns) {
+  std::printf("  %-36s %10.2f ns/op\n", name, ns);
+}
+
+inline void reportError(const char *name, double maxError, double bound) {
+  std::printf("  %-36s %10.3g max  (bound %.3g) %s\n", name, maxError, bound,
+              maxError <= bound ? "ok" : "EXCEEDED");
+}
+
+} // namespace bench
+
+// Benchmark suites
+void runMathBenchmarks();
+void runPlayerBenchmarks();
+void runEntityBenchmarks();
+void runSnapshotBenchmarks();
+void runRollbackBenchmarks();
+void runParticleBenchmarks();
+void runLogBenchmarks();
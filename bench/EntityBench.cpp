@@ -0,0 +1,71 @@
+#include "Bench.hpp"
+#include "entities/Systems.hpp"
+
+namespace {
+
+constexpr std::size_t ENTITIES = 50000;
+constexpr std::size_t PASSES = 200;
+
+// Fill a world with moving obstacles split over a few archetypes
+void populate(EntityWorld &world) {
+  constexpr ComponentMask obstacle =
+      componentMask<Transform, Velocity, Collider, Renderable>();
+  constexpr ComponentMask timed =
+      componentMask<Transform, Velocity, Renderable, Lifetime>();
+  world.reserve(obstacle, ENTITIES);
+  world.reserve(timed, ENTITIES);
+
+  for (std::size_t i = 0; i < ENTITIES; ++i) {
+    bool isTimed = i % 4 == 0;
+    Entity entity = world.create(isTimed ? timed : obstacle);
+    Transform *transform = world.get<Transform>(entity);
+    transform->position = Vec2<SimScalar>(SimScalar(float(i % 1280)),
+                                          SimScalar(float(i % 720)));
+    world.get<Velocity>(entity)->linear =
+        Vec2<SimScalar>(SimScalar(10.0f), SimScalar(-5.0f));
+    if (isTimed)
+      world.get<Lifetime>(entity)->remaining = SimScalar(1000.0f);
+  }
+}
+
+} // namespace
+
+void runEntityBenchmarks() {
+  std::printf("== Entity systems (%zu entities) ==\n", ENTITIES);
+
+  EntityWorld world;
+  populate(world);
+  const SimScalar dt = scalar::fromRatio<SimScalar>(1, 60);
+
+  double ns = bench::nsPerOp(PASSES, [&](std::size_t) {
+    systems::integrateMotion(world, dt);
+  });
+  bench::reportTime("integrateMotion per entity", ns / ENTITIES);
+
+  ns = bench::nsPerOp(PASSES, [&](std::size_t) {
+    systems::updateLifetimes(world, dt);
+  });
+  bench::reportTime("updateLifetimes per entity", ns / ENTITIES);
+
+  std::vector<RenderInstance> instances;
+  ns = bench::nsPerOp(PASSES, [&](std::size_t) {
+    systems::buildRenderList(world, instances);
+  });
+  bench::doNotOptimize(instances.size());
+  bench::reportTime("buildRenderList per entity", ns / ENTITIES);
+
+  // Churn: destroy and recreate a tenth of the world
+  std::vector<Entity> victims;
+  world.each<Collider>(
+      [&victims](std::size_t count, const Entity *entities, Collider *) {
+        for (std::size_t i = 0; i < count; i += 10)
+          victims.push_back(entities[i]);
+      });
+  constexpr ComponentMask obstacle =
+      componentMask<Transform, Velocity, Collider, Renderable>();
+  ns = bench::nsPerOp(victims.size(), [&](std::size_t i) {
+    world.destroy(victims[i]);
+    world.create(obstacle);
+  });
+  bench::reportTime("destroy + create", ns);
+}
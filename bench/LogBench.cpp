@@ -0,0 +1,49 @@
+#include "Bench.hpp"
+#include "core/Log.hpp"
+#include <filesystem>
+#include <thread>
+
+namespace {
+
+constexpr std::size_t BURSTS = 20;
+constexpr std::size_t BURST_SIZE = 512; // Half a thread's ring
+
+} // namespace
+
+void runLogBenchmarks() {
+  std::printf("== Diagnostic logging ==\n");
+
+  LogConfig config;
+  config.path = std::filesystem::temp_directory_path() / "neondrift-bench.log";
+  config.level = LogLevel::Debug;
+  config.flushInterval = std::chrono::milliseconds(10);
+  Log::start(config);
+
+  // Bursts the writer can keep up with, as in a frame; the first one
+  // registers this thread's buffer
+  double total = 0.0;
+  for (std::size_t burst = 0; burst < BURSTS; ++burst) {
+    total += bench::nsPerOp(BURST_SIZE, [](std::size_t i) {
+      ND_LOG(Debug, "bench", "Tick {} at {} px/s, drifting {}", i, 412.5f,
+             (i & 1) != 0);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  }
+  bench::reportTime("ND_LOG, 3 arguments", total / BURSTS);
+
+  double ns = bench::nsPerOp(BURST_SIZE * BURSTS, [](std::size_t i) {
+    ND_LOG_EVERY(1.0, Debug, "bench", "Tick {}", i);
+  });
+  bench::reportTime("ND_LOG_EVERY, rate limited", ns);
+
+  ns = bench::nsPerOp(BURST_SIZE * BURSTS, [](std::size_t i) {
+    ND_LOG(Trace, "bench", "Tick {}", i);
+  });
+  bench::reportTime("ND_LOG below the level", ns);
+
+  Log::stop();
+  std::printf("  %-36s %10llu written, %llu dropped\n", "messages",
+              static_cast<unsigned long long>(Log::getWrittenCount()),
+              static_cast<unsigned long long>(Log::getDroppedCount()));
+  std::filesystem::remove(config.path);
+}
@@ -0,0 +1,129 @@
+#include "Bench.hpp"
+#include "math/FastMath.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t COUNT = 4096;
+constexpr std::size_t ROUNDS = 2000;
+
+void accuracy() {
+  std::printf("Accuracy (vs double-precision std)\n");
+
+  double sinCosErr = 0.0, sinCos4Err = 0.0;
+  for (double x = -8192.0; x < 8192.0; x += 0.0137) {
+    float xf = static_cast<float>(x);
+    float s, c;
+    fastmath::sincos(xf, s, c);
+    sinCosErr = std::fmax(sinCosErr, std::fabs(s - std::sin(double(xf))));
+    sinCosErr = std::fmax(sinCosErr, std::fabs(c - std::cos(double(xf))));
+
+    float xs[4] = {xf, xf + 0.25f, xf + 0.5f, xf + 0.75f}, ss[4], cs[4];
+    fastmath::sincos4(xs, ss, cs);
+    for (int i = 0; i < 4; ++i) {
+      sinCos4Err =
+          std::fmax(sinCos4Err, std::fabs(ss[i] - std::sin(double(xs[i]))));
+      sinCos4Err =
+          std::fmax(sinCos4Err, std::fabs(cs[i] - std::cos(double(xs[i]))));
+    }
+  }
+  bench::reportError("sincos  |x| <= 8192", sinCosErr, 1.5e-7);
+  bench::reportError("sincos4 |x| <= 8192", sinCos4Err, 1.5e-7);
+
+  double degErr = 0.0;
+  for (double d = -1e5; d < 1e5; d += 0.173) {
+    float df = static_cast<float>(d);
+    float s, c;
+    fastmath::sincosDeg(df, s, c);
+    double r = std::fmod(double(df), 360.0) * 3.14159265358979323846 / 180.0;
+    degErr = std::fmax(degErr, std::fabs(s - std::sin(r)));
+    degErr = std::fmax(degErr, std::fabs(c - std::cos(r)));
+  }
+  bench::reportError("sincosDeg |x| <= 1e5", degErr, 2.5e-7);
+
+  double atanErr = 0.0, atan4Err = 0.0;
+  auto angleDiff = [](double a, double b) {
+    double d = std::fabs(a - b);
+    return d > 3.14159265358979 ? 6.28318530717959 - d : d;
+  };
+  for (double a = -3.2; a < 3.2; a += 0.0003) {
+    for (double m : {1e-3, 1.0, 1e4}) {
+      float y = static_cast<float>(m * std::sin(a));
+      float x = static_cast<float>(m * std::cos(a));
+      atanErr = std::fmax(atanErr, angleDiff(fastmath::atan2(y, x),
+                                             std::atan2(double(y), double(x))));
+
+      float ys[4] = {y, -y, y, -y}, xs[4] = {x, x, -x, -x}, out[4];
+      fastmath::atan2_4(ys, xs, out);
+      for (int i = 0; i < 4; ++i) {
+        atan4Err = std::fmax(
+            atan4Err,
+            angleDiff(out[i], std::atan2(double(ys[i]), double(xs[i]))));
+      }
+    }
+  }
+  bench::reportError("atan2", atanErr, 2.5e-6);
+  bench::reportError("atan2_4", atan4Err, 2.5e-6);
+}
+
+void speed() {
+  std::printf("Speed (%zu values per op, reported per value)\n", COUNT);
+
+  std::vector<float> x(COUNT), y(COUNT), s(COUNT), c(COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    x[i] = static_cast<float>(i) * 0.01f - 20.0f;
+    y[i] = static_cast<float>(COUNT - i) * 0.013f - 10.0f;
+  }
+
+  double ns = bench::nsPerOp(ROUNDS, [&](std::size_t) {
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      s[i] = std::sin(x[i]);
+      c[i] = std::cos(x[i]);
+    }
+    bench::doNotOptimize(s[0]);
+  });
+  bench::reportTime("std::sin + std::cos", ns / COUNT);
+
+  ns = bench::nsPerOp(ROUNDS, [&](std::size_t) {
+    for (std::size_t i = 0; i < COUNT; ++i)
+      fastmath::sincos(x[i], s[i], c[i]);
+    bench::doNotOptimize(s[0]);
+  });
+  bench::reportTime("fastmath::sincos", ns / COUNT);
+
+  ns = bench::nsPerOp(ROUNDS, [&](std::size_t) {
+    fastmath::sincosBatch(x.data(), s.data(), c.data(), COUNT);
+    bench::doNotOptimize(s[0]);
+  });
+  bench::reportTime("fastmath::sincosBatch (4-wide)", ns / COUNT);
+
+  ns = bench::nsPerOp(ROUNDS, [&](std::size_t) {
+    for (std::size_t i = 0; i < COUNT; ++i)
+      s[i] = std::atan2(y[i], x[i]);
+    bench::doNotOptimize(s[0]);
+  });
+  bench::reportTime("std::atan2", ns / COUNT);
+
+  ns = bench::nsPerOp(ROUNDS, [&](std::size_t) {
+    for (std::size_t i = 0; i < COUNT; ++i)
+      s[i] = fastmath::atan2(y[i], x[i]);
+    bench::doNotOptimize(s[0]);
+  });
+  bench::reportTime("fastmath::atan2", ns / COUNT);
+
+  ns = bench::nsPerOp(ROUNDS, [&](std::size_t) {
+    for (std::size_t i = 0; i < COUNT; i += 4)
+      fastmath::atan2_4(&y[i], &x[i], &s[i]);
+    bench::doNotOptimize(s[0]);
+  });
+  bench::reportTime("fastmath::atan2_4", ns / COUNT);
+}
+
+} // namespace
+
+void runMathBenchmarks() {
+  std::printf("== Fast math ==\n");
+  accuracy();
+  speed();
+}
@@ -0,0 +1,100 @@
+#include "Bench.hpp"
+#include "graphics/ParticleSystem.hpp"
+#include <vector>
+
+namespace {
+
+constexpr std::size_t TICKS = 3600;        // A minute at 60 Hz
+constexpr std::size_t BURST_INTERVAL = 30; // Ticks between collisions
+constexpr int TRAILS = 24;                 // Drifting emitters, enough to fill
+constexpr float DT = 1.0f / 60.0f;
+constexpr std::size_t LARGE_POOL = std::size_t(1) << 20;
+constexpr std::size_t LARGE_ITERATIONS = 5;
+
+const char *policyName(PoolPolicy policy) {
+  switch (policy) {
+  case PoolPolicy::Drop:
+    return "drop";
+  case PoolPolicy::EvictOldest:
+    return "evict";
+  case PoolPolicy::Grow:
+    return "grow";
+  }
+  return "?";
+}
+
+} // namespace
+
+void runParticleBenchmarks() {
+  std::printf("== Particle pool (saturating drift trails + collisions) ==\n");
+
+  std::vector<sf::Vertex> vertices;
+  for (PoolPolicy policy :
+       {PoolPolicy::Drop, PoolPolicy::EvictOldest, PoolPolicy::Grow}) {
+    ParticleSystem particles;
+    particles.seed(1);
+    particles.setPoolPolicy(policy);
+    ParticleSystem::EmitterId trail = particles.findEmitter("drift_trail");
+    ParticleSystem::EmitterId burst = particles.findEmitter("collision_burst");
+
+    // Share of each collision burst that actually appeared
+    std::size_t burstsSeen = 0, burstsFull = 0;
+    double burstShare = 0.0;
+    double ns = bench::nsPerOp(TICKS, [&](std::size_t tick) {
+      particles.update(DT);
+      for (int i = 0; i < TRAILS; ++i) {
+        EmitParams params;
+        params.position = sf::Vector2f(100.0f * i, 300.0f);
+        params.direction = 180.0f;
+        params.intensity = 1.0f;
+        particles.emitContinuous(trail, params, DT);
+      }
+      if (tick % BURST_INTERVAL == 0) {
+        std::size_t before = particles.getActiveCount(burst);
+        ParticleSystem::PoolStats stats = particles.getPoolStats();
+        particles.emitCollisionBurst({400.0f, 300.0f}, sf::Color::White);
+        std::size_t spawned = particles.getActiveCount(burst) - before;
+        std::size_t missed = particles.getPoolStats().dropped - stats.dropped;
+        burstShare += static_cast<double>(spawned) / (spawned + missed);
+        burstsFull += missed == 0 ? 1 : 0;
+        ++burstsSeen;
+      }
+      bench::doNotOptimize(particles.buildVertices(vertices));
+    });
+
+    ParticleSystem::PoolStats stats = particles.getPoolStats();
+    std::printf("  %-6s %8.2f us/tick  peak %5zu live  chunks %2zu/%2zu  "
+                "dropped %7zu  evicted %7zu  collisions %3.0f%% shown "
+                "(%zu/%zu whole)\n",
+                policyName(policy), ns * 1.0e-3, stats.peakLive,
+                stats.allocatedChunks, stats.maxChunks, stats.dropped,
+                stats.evicted, 100.0 * burstShare / burstsSeen, burstsFull,
+                burstsSeen);
+  }
+
+  // A million-particle pool: footprint and per-particle pass costs
+  ParticleSystem large(LARGE_POOL);
+  large.seed(1);
+  ParticleSystem::EmitterId burst = large.findEmitter("collision_burst");
+  EmitParams params;
+  for (std::size_t i = 0; large.getActiveCount() < LARGE_POOL * 9 / 10; ++i) {
+    params.position = sf::Vector2f(static_cast<float>(i % 1000),
+                                   static_cast<float>(i / 1000 % 600));
+    large.emitBurst(burst, params);
+  }
+  std::size_t live = large.getActiveCount();
+  ParticleSystem::PoolStats stats = large.getPoolStats();
+  std::printf("  %zu-byte particles: %zu live in %.1f MiB of chunks\n",
+              sizeof(StoredParticle), live,
+              stats.allocatedChunks * ParticleChunkPool::CHUNK_SIZE *
+                  sizeof(StoredParticle) / (1024.0 * 1024.0));
+
+  // Tiny steps so the pool stays full while timing
+  double updateNs = bench::nsPerOp(LARGE_ITERATIONS,
+                                   [&](std::size_t) { large.update(1.0e-5f); });
+  double buildNs = bench::nsPerOp(LARGE_ITERATIONS, [&](std::size_t) {
+    bench::doNotOptimize(large.buildVertices(vertices));
+  });
+  bench::reportTime("update, per particle", updateNs / live);
+  bench::reportTime("vertex expansion, per particle", buildNs / live);
+}
@@ -0,0 +1,59 @@
+#include "Bench.hpp"
+#include "core/InputManager.hpp"
+#include "entities/Player.hpp"
+#include <cmath>
+#include <initializer_list>
+
+namespace {
+
+constexpr std::size_t TICKS = 200000;
+
+// Drives a player with the given keys held and reports ns per tick
+void timeUpdate(const char *name,
+                std::initializer_list<sf::Keyboard::Key> keys) {
+  Player player;
+  InputManager input;
+  for (auto key : keys)
+    input.keyPressed(key);
+  const ControlInput controls = input.getControls();
+
+  const SimScalar dt = scalar::fromRatio<SimScalar>(1, 60);
+  double ns = bench::nsPerOp(TICKS, [&](std::size_t) {
+    player.update(dt, controls);
+  });
+  bench::doNotOptimize(player.getRotation());
+  bench::reportTime(name, ns);
+}
+
+// The cached heading must match the rotation it was derived from
+void headingAccuracy() {
+  Player player;
+  InputManager input;
+  input.keyPressed(sf::Keyboard::Key::W);
+  input.keyPressed(sf::Keyboard::Key::D);
+  const ControlInput controls = input.getControls();
+
+  const SimScalar dt = scalar::fromRatio<SimScalar>(1, 60);
+  double maxErr = 0.0;
+  for (std::size_t i = 0; i < 20000; ++i) {
+    player.update(dt, controls);
+
+    double rad = player.getRotation() * 3.14159265358979323846 / 180.0;
+    sf::Vector2f heading = player.getHeading();
+    maxErr = std::fmax(maxErr, std::fabs(heading.x - std::cos(rad)));
+    maxErr = std::fmax(maxErr, std::fabs(heading.y - std::sin(rad)));
+  }
+  bench::reportError("cached heading vs std trig", maxErr, 1e-4);
+}
+
+} // namespace
+
+void runPlayerBenchmarks() {
+  std::printf("== Player update ==\n");
+  timeUpdate("straight (heading cached)", {sf::Keyboard::Key::W});
+  timeUpdate("turning (heading refreshed)",
+             {sf::Keyboard::Key::W, sf::Keyboard::Key::D});
+  timeUpdate("drifting + turning", {sf::Keyboard::Key::W, sf::Keyboard::Key::D,
+                                    sf::Keyboard::Key::Space});
+  headingAccuracy();
+}
@@ -0,0 +1,75 @@
+#include "Bench.hpp"
+#include "net/RollbackSession.hpp"
+#include <array>
+
+namespace {
+
+constexpr std::size_t WARMUP_TICKS = 3600; // A minute of bot play
+constexpr std::size_t ITERATIONS = 200;
+constexpr double FRAME_NS = 1.0e9 / Simulation::TICK_RATE;
+
+// Opponent controls that change every few ticks, like a real player
+ControlInput opponentControls(std::size_t tick) {
+  ControlInput controls;
+  controls.bits = ControlInput::Accelerate;
+  if ((tick / 20) % 3 == 1)
+    controls.bits |= ControlInput::TurnLeft | ControlInput::Drift;
+  else if ((tick / 20) % 3 == 2)
+    controls.bits |= ControlInput::TurnRight;
+  return controls;
+}
+
+} // namespace
+
+void runRollbackBenchmarks() {
+  std::printf("== Rollback re-simulation ==\n");
+
+  Simulation simulation(1);
+  simulation.enableVersus(0, 1);
+  simulation.enableBot(1);
+  for (std::size_t i = 0; i < WARMUP_TICKS; ++i)
+    simulation.stepVersus(simulation.pollLocalControls(), opponentControls(i));
+
+  // The last MAX_PREDICTION ticks as a session keeps them: state before
+  // each tick plus both inputs
+  constexpr std::size_t DEPTH = RollbackSession::MAX_PREDICTION;
+  std::array<std::vector<std::uint8_t>, DEPTH> states;
+  std::array<ControlInput, DEPTH> local;
+  for (std::size_t i = 0; i < DEPTH; ++i) {
+    simulation.saveState(states[i]);
+    local[i] = simulation.pollLocalControls();
+    simulation.stepVersus(local[i], opponentControls(WARMUP_TICKS + i));
+  }
+  std::vector<std::uint8_t> present;
+  simulation.saveState(present);
+
+  // A normal tick: snapshot, step, checksum
+  std::vector<std::uint8_t> scratch;
+  double tickNs = bench::nsPerOp(ITERATIONS, [&](std::size_t i) {
+    simulation.saveState(scratch);
+    simulation.stepVersus(local[0], opponentControls(i), true);
+    bench::doNotOptimize(simulation.getVersusChecksum());
+  });
+  bench::reportTime("tick (save + step + checksum)", tickNs);
+
+  // Rolling back `depth` ticks: restore, then replay each tick the same way
+  for (std::size_t depth : {std::size_t(1), std::size_t(2), std::size_t(4),
+                            std::size_t(8), DEPTH}) {
+    std::size_t first = DEPTH - depth;
+    double ns = bench::nsPerOp(ITERATIONS, [&](std::size_t) {
+      simulation.loadState(states[first], true);
+      for (std::size_t t = first; t < DEPTH; ++t) {
+        if (t != first)
+          simulation.saveState(states[t]);
+        simulation.stepVersus(local[t], opponentControls(WARMUP_TICKS + t),
+                              true);
+        bench::doNotOptimize(simulation.getVersusChecksum());
+      }
+    });
+    char name[48];
+    std::snprintf(name, sizeof(name), "rollback %zu ticks", depth);
+    std::printf("  %-36s %10.2f ns/op  (%.2f%% of a frame)\n", name, ns,
+                100.0 * ns / FRAME_NS);
+  }
+  simulation.loadState(present);
+}
@@ -0,0 +1,50 @@
+#include "Bench.hpp"
+#include "core/Simulation.hpp"
+
+namespace {
+
+constexpr std::size_t WARMUP_TICKS = 3600; // A minute of bot play
+constexpr std::size_t ITERATIONS = 2000;
+
+} // namespace
+
+void runSnapshotBenchmarks() {
+  std::printf("== Simulation snapshots ==\n");
+
+  Simulation simulation(1);
+  simulation.enableBot(1);
+  simulation.handleKey(sf::Keyboard::Key::Enter, true);
+  for (std::size_t i = 0; i < WARMUP_TICKS; ++i)
+    simulation.step();
+
+  std::vector<std::uint8_t> state;
+  double ns = bench::nsPerOp(ITERATIONS, [&](std::size_t) {
+    simulation.saveState(state);
+  });
+  bench::reportTime("saveState", ns);
+  std::printf("  %-36s %10zu bytes\n", "state size", state.size());
+
+  ns = bench::nsPerOp(ITERATIONS, [&](std::size_t) {
+    simulation.loadState(state);
+  });
+  bench::reportTime("loadState", ns);
+
+  // Tick cost with and without capturing every tick into the rewind ring
+  ns = bench::nsPerOp(ITERATIONS, [&](std::size_t) { simulation.step(); });
+  bench::reportTime("step", ns);
+
+  simulation.enableRewind(10.0f);
+  ns = bench::nsPerOp(ITERATIONS, [&](std::size_t) { simulation.step(); });
+  bench::reportTime("step + rewind capture", ns);
+
+  const RewindBuffer &rewind = simulation.getRewindBuffer();
+  std::printf("  %-36s %10zu bytes (%zu ticks, %.1f%% of raw)\n",
+              "rewind ring", rewind.getStoredBytes(), rewind.size(),
+              100.0 * rewind.getStoredBytes() /
+                  (static_cast<double>(state.size()) * rewind.size()));
+
+  ns = bench::nsPerOp(1, [&](std::size_t) {
+    simulation.rewind(Simulation::TICK_RATE * 5);
+  });
+  bench::reportTime("rewind 5 s", ns);
+}
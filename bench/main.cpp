@@ -0,0 +1,17 @@
+/**
+ * NeonDrift - Benchmarks
+ * Accuracy and speed checks for hot gameplay code
+ */
+
+#include "Bench.hpp"
+
+int main() {
+  runMathBenchmarks();
+  runPlayerBenchmarks();
+  runEntityBenchmarks();
+  runSnapshotBenchmarks();
+  runRollbackBenchmarks();
+  runParticleBenchmarks();
+  runLogBenchmarks();
+  return 0;
+}
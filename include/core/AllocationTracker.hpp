@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Subsystem charged for a heap allocation (see AllocationScope)
+ */
+enum class AllocTag : std::uint8_t {
+  Other,      // Outside any scope
+  Simulation, // Tick logic not covered below
+  Particles,
+  Entities,
+  Ui,
+  Render,
+  Growth, // Reused buffers and pools reaching a new high-water mark
+          // (expected, never flagged)
+  Count
+};
+
+/**
+ * Debug heap allocation counter, per thread and subsystem
+ * With NEONDRIFT_TRACK_ALLOCATIONS the global operator new is replaced to
+ * count every allocation against the calling thread's current AllocTag.
+ * Loops hand each finished frame to a FrameAllocationCheck, which asserts
+ * that steady-state frames allocate nothing. Without the flag everything
+ * here compiles to no-ops.
+ */
+class AllocationTracker {
+public:
+  using Counts = std::array<std::uint32_t, static_cast<std::size_t>(
+                                               AllocTag::Count)>;
+
+#ifdef NEONDRIFT_TRACK_ALLOCATIONS
+  static constexpr bool ENABLED = true;
+#else
+  static constexpr bool ENABLED = false;
+#endif
+
+  // Allocations made by this thread since the last call, by tag
+  static Counts take();
+
+  static const char *tagName(AllocTag tag);
+
+private:
+  friend class AllocationScope;
+  static AllocTag exchangeTag(AllocTag tag);
+};
+
+/**
+ * Charges this thread's allocations to a subsystem until it goes out of
+ * scope (scopes nest)
+ */
+class AllocationScope {
+public:
+  explicit AllocationScope(AllocTag tag)
+      : m_previous(AllocationTracker::ENABLED
+                       ? AllocationTracker::exchangeTag(tag)
+                       : AllocTag::Other) {}
+  ~AllocationScope() {
+    if (AllocationTracker::ENABLED)
+      AllocationTracker::exchangeTag(m_previous);
+  }
+
+  AllocationScope(const AllocationScope &) = delete;
+  AllocationScope &operator=(const AllocationScope &) = delete;
+
+private:
+  AllocTag m_previous;
+};
+
+/**
+ * Per-loop steady-state check
+ * A loop is steady once it has run WARMUP_FRAMES consecutive frames in
+ * steady conditions (e.g. Playing); from then on any allocation outside
+ * AllocTag::Growth is reported to stderr with its subsystem, and asserts.
+ */
+class FrameAllocationCheck {
+public:
+  static constexpr std::uint32_t WARMUP_FRAMES = 120;
+
+  explicit FrameAllocationCheck(const char *loopName)
+      : m_loopName(loopName), m_steadyFrames(0) {}
+
+  // Ignore what this thread allocated before the frame's own work
+  void beginFrame() { AllocationTracker::take(); }
+
+  // Close this thread's frame; steady is false while conditions change
+  // (state transitions, loading), which restarts the warmup
+  void endFrame(bool steady);
+
+private:
+  const char *m_loopName;
+  std::uint32_t m_steadyFrames;
+};
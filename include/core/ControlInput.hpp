@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Driving controls for one tick, independent of the keys that produced
+ * them (recorded and replayed as one byte per tick)
+ */
+struct ControlInput {
+  enum : std::uint8_t {
+    Accelerate = 1u << 0,
+    Brake = 1u << 1,
+    TurnLeft = 1u << 2,
+    TurnRight = 1u << 3,
+    Drift = 1u << 4,
+  };
+
+  std::uint8_t bits = 0;
+
+  bool isAccelerating() const { return (bits & Accelerate) != 0; }
+  bool isBraking() const { return (bits & Brake) != 0; }
+  bool isTurningLeft() const { return (bits & TurnLeft) != 0; }
+  bool isTurningRight() const { return (bits & TurnRight) != 0; }
+  bool isDrifting() const { return (bits & Drift) != 0; }
+
+  bool operator==(const ControlInput &o) const { return bits == o.bits; }
+  bool operator!=(const ControlInput &o) const { return bits != o.bits; }
+};
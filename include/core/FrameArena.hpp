@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+/**
+ * Linear scratch memory for one rendered frame
+ * Allocations bump a pointer through a buffer reserved once; reset() at the
+ * end of the frame releases them all at once, so per-frame temporaries
+ * (formatted HUD strings, scratch arrays) never reach the heap. When the
+ * buffer runs out, requests fail instead of growing it and the shortfall is
+ * counted, so a too-small arena shows up without slowing the frame.
+ */
+class FrameArena {
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024; // Bytes
+
+  explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+
+  // Uninitialized storage, or nullptr when the frame's share is used up
+  void *allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t));
+  template <typename T> T *allocate(std::size_t count) {
+    return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+  }
+
+  // printf-style text valid until reset(); "" when it does not fit
+  const char *format(const char *pattern, ...);
+
+  // Release everything allocated this frame
+  void reset();
+
+  std::size_t getCapacity() const { return m_capacity; }
+  std::size_t getPeakUsed() const { return m_peak; }
+  std::size_t getFailedRequests() const { return m_failed; }
+
+private:
+  std::unique_ptr<unsigned char[]> m_buffer;
+  std::size_t m_capacity;
+  std::size_t m_used;
+  std::size_t m_peak;   // Most used by any frame
+  std::size_t m_failed; // Requests that did not fit, ever
+};
@@ -1,64 +1,171 @@
 #pragma once
 
-#include "core/GameState.hpp"
-#include "core/InputManager.hpp"
-#include "core/ScoreManager.hpp"
-#include "entities/Player.hpp"
-#include "graphics/ParticleSystem.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/FrameArena.hpp"
+#include "core/LatencyTracker.hpp"
+#include "core/Log.hpp"
+#include "core/Simulation.hpp"
+#include "core/SpscRing.hpp"
+#include "core/TripleBuffer.hpp"
+#include "graphics/BackgroundLayer.hpp"
+#include "graphics/EntityRenderer.hpp"
+#include "graphics/FrameCapture.hpp"
+#include "graphics/ParticleBudget.hpp"
+#include "graphics/RenderBackend.hpp"
+#include "graphics/ResolutionScaler.hpp"
+#include "graphics/SkidMarkLayer.hpp"
+#include "net/RollbackSession.hpp"
+#include "net/UdpLink.hpp"
 #include "ui/UIManager.hpp"
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Startup options (from the command line)
+ */
+struct GameOptions {
+  bool lateInputSampling = false; // Poll control keys right before each tick
+  bool reportLatency = false;     // Print input latency percentiles on exit
+  bool adaptiveParticles = true;  // Thin out particles when frames run long
+  bool dynamicResolution = true;  // Render the world smaller when they do
+  PoolPolicy particlePool = PoolPolicy::EvictOldest; // At the particle cap
+  std::filesystem::path physicsPath = "assets/physics/handling.ini";
+  std::filesystem::path recordPath; // Save Playing-tick controls on exit
+  std::filesystem::path capturePath; // Record Playing frames as video
+  std::filesystem::path logPath;     // Diagnostics (empty = stderr)
+  LogLevel logLevel = LogLevel::Info;
+
+  // Two-player versus over UDP; both players pass the same seed and
+  // different slots
+  bool versus = false;
+  unsigned short localPort = 0;
+  std::string peerHost;
+  unsigned short peerPort = 0;
+  int versusSlot = 0;
+  std::uint32_t versusSeed = 1;
+  LinkConditions network; // Simulated latency and loss (testing)
+};
 
 /**
  * Main Game class
- * Manages window, game loop, and state transitions
+ * Owns the window and render loop; the simulation runs on its own thread and
+ * hands finished ticks over through a triple-buffered FrameSnapshot, so
+ * rendering never waits on a tick and a tick never waits on vsync.
+ * When the simulation is idle (menus, pause, game over) both threads sleep
+ * until input arrives; the frozen world is cached and only overlays redraw.
+ * In versus mode the ticks go through a RollbackSession instead.
+ * During play the world may be drawn at reduced resolution into an
+ * offscreen layer and upscaled, with the HUD on top at native resolution.
+ * The world is drawn over a backdrop of cached tiles that scroll with the
+ * camera, and skid marks are stamped into a similar tiled layer.
+ * Neither loop allocates during steady play; builds with
+ * NEONDRIFT_TRACK_ALLOCATIONS assert it.
  */
 class Game {
 public:
-  Game();
-  ~Game() = default;
+  explicit Game(const GameOptions &options = GameOptions());
+  ~Game();
 
   // Main entry point - runs the game
   void run();
 
 private:
-  // Core loop methods
-  void processEvents();
-  void update(float deltaTime);
-  void render();
+  // Render thread (waits up to idleWait for the first event when idle)
+  void processEvents(sf::Time idleWait);
+  void render(const FrameSnapshot &snapshot);
+  // World (and optionally HUD) into target; below full scale the world
+  // fills only the top-left part of the target, at that fraction of its size
+  void renderWorld(sf::RenderTarget &target, const FrameSnapshot &snapshot,
+                   bool withHud, float scale = 1.0f);
+  void renderHud(sf::RenderTarget &target, const FrameSnapshot &snapshot);
+  void renderScaledWorld(const FrameSnapshot &snapshot);
+  void updateResolution(GameState state, std::int64_t presentNs);
+  void renderFrozenWorld(const FrameSnapshot &snapshot, bool withHud);
+  void startCapture();
+  void printCaptureStats() const;
+
+  // Simulation thread
+  void simulationLoop();
+  void stopSimulation();
+  void sampleControls(std::uint64_t tick, std::int64_t tickNs);
+  bool startVersus();
+  void updateParticleBudget(float simWorkMs);
+  void printVersusStats() const;
 
-  // State handling
-  void handleStateTransition();
+  GameOptions m_options;
 
   // Window
   sf::RenderWindow m_window;
+  std::atomic<bool> m_windowFocused;
+  std::atomic<std::uint64_t> m_frameCount; // Frames presented
 
-  // Game state
-  GameState m_currentState;
-  GameState m_pendingState;
-  bool m_stateChangeRequested;
+  // Simulation and hand-off between threads
+  Simulation m_simulation;
+  ParticleBudget m_particleBudget; // Simulation thread
+  TripleBuffer<FrameSnapshot> m_snapshots;
+  SpscRing<InputEvent, 256> m_inputQueue;
+  std::thread m_simThread;
+  std::atomic<bool> m_simRunning;
+  std::atomic<bool> m_quitRequested;
+  std::uint64_t m_inputSequence; // Input events sent (render thread only)
 
-  // Input
-  InputManager m_inputManager;
+  // Versus networking (simulation thread)
+  UdpLink m_link;
+  RollbackSession m_session;
 
-  // Game entities
-  Player m_player;
+  // Input-to-display measurement
+  LatencyTracker m_latency;
 
-  // Visual effects
-  ParticleSystem m_particles;
-  sf::Vector2f m_screenShake;
-  float m_shakeIntensity;
+  // Video of displayed Playing frames (render thread)
+  FrameCapture m_capture;
 
-  // Scoring and UI
-  ScoreManager m_scoreManager;
+  // Render thread frame work, for the particle budget (milliseconds)
+  std::atomic<float> m_renderWorkMs;
+  std::atomic<float> m_particleDrawMs;
+  float m_particleDrawTime; // Accumulates during a frame
+
+  // Wakes the simulation thread while it idles
+  std::mutex m_inputMutex;
+  std::condition_variable m_inputReady;
+
+  // Presentation
+  FrameArena m_frameArena; // Render thread scratch, reset every frame
   UIManager m_uiManager;
-  bool m_wasDrifting;
+  EntityRenderer m_entities;
+  CommandList m_commands; // World geometry, reused every frame
+  BackgroundLayer m_background; // Neon grid tiles, redrawn as they appear
+  SkidMarkLayer m_skidMarks;     // Tire marks stamped once, faded in bulk
+
+  // World layer at dynamic resolution (render thread)
+  sf::RenderTexture m_worldLayer;
+  bool m_worldLayerAvailable;
+  ResolutionScaler m_resolution;
+  std::int64_t m_lastPresentNs; // 0 unless the last frame was Playing
+
+  // Idle presentation
+  sf::RenderTexture m_frozenWorld; // World + HUD at the frozen step
+  bool m_frozenWorldAvailable;
+  bool m_frozenWorldValid;
+  std::uint64_t m_frozenStep;
+  GameState m_frozenState;
+  sf::Clock m_idleClock;
+  float m_idlePulse;
+
+  // Idle waits: animated screens keep the pulse smooth, static ones only
+  // redraw for events
+  static constexpr int ANIMATED_IDLE_WAIT_MS = 33;
+  static constexpr int STATIC_IDLE_WAIT_MS = 250;
 
-  // Timing
-  sf::Clock m_clock;
-  static constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
-  float m_accumulator;
+  // Play history kept for rewinding (Backspace)
+  static constexpr float REWIND_SECONDS = 10.0f;
 
   // Window settings
+  static constexpr unsigned int FRAME_RATE = 60;
   static constexpr unsigned int WINDOW_WIDTH = 1280;
   static constexpr unsigned int WINDOW_HEIGHT = 720;
 };
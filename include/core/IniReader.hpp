@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/**
+ * Minimal reader for the INI-style config files ([section], key = value)
+ * Comments start at '#' or ';' and run to the end of the line; names and
+ * values are trimmed. Interpreting the values is left to the caller.
+ */
+namespace ini {
+
+// Text without leading or trailing whitespace
+std::string trim(const std::string &text);
+
+// Calls onSection(name) for each "[name]" line and onKey(section, key,
+// value) for each "key = value" line, in file order. Keys before the first
+// section get an empty section; other lines are skipped. Returns false if
+// the file cannot be opened.
+template <typename OnSection, typename OnKey>
+bool read(const std::filesystem::path &path, OnSection onSection,
+          OnKey onKey) {
+  std::ifstream file(path);
+  if (!file)
+    return false;
+
+  std::string section;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::size_t comment = line.find_first_of("#;");
+    if (comment != std::string::npos)
+      line.erase(comment);
+    line = trim(line);
+    if (line.empty())
+      continue;
+
+    if (line.front() == '[' && line.back() == ']') {
+      section = trim(line.substr(1, line.size() - 2));
+      onSection(section);
+      continue;
+    }
+    std::size_t equals = line.find('=');
+    if (equals == std::string::npos)
+      continue; // Malformed
+    onKey(section, trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+  }
+  return true;
+}
+
+} // namespace ini
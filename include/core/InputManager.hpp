@@ -1,22 +1,48 @@
 #pragma once
 
+#include "core/ControlInput.hpp"
+#include "core/StateStream.hpp"
 #include <SFML/Window/Keyboard.hpp>
-#include <unordered_set>
+#include <array>
+#include <bitset>
 
 /**
  * Centralized input handling
- * Tracks currently pressed keys for smooth gameplay
+ * Tracks currently pressed keys for smooth gameplay (a fixed bit per key,
+ * so key events never touch the heap)
  */
 class InputManager {
 public:
+  // Keys read by the driving controls below (held state, not edges)
+  static constexpr std::array<sf::Keyboard::Key, 9> CONTROL_KEYS = {
+      sf::Keyboard::Key::W,     sf::Keyboard::Key::Up,
+      sf::Keyboard::Key::S,     sf::Keyboard::Key::Down,
+      sf::Keyboard::Key::A,     sf::Keyboard::Key::Left,
+      sf::Keyboard::Key::D,     sf::Keyboard::Key::Right,
+      sf::Keyboard::Key::Space};
+
+  static bool isControlKey(sf::Keyboard::Key key) {
+    for (sf::Keyboard::Key control : CONTROL_KEYS) {
+      if (control == key)
+        return true;
+    }
+    return false;
+  }
+
   // Update key states based on events
-  void keyPressed(sf::Keyboard::Key key) { m_pressedKeys.insert(key); }
+  void keyPressed(sf::Keyboard::Key key) {
+    if (isTracked(key))
+      m_pressedKeys.set(static_cast<std::size_t>(key));
+  }
 
-  void keyReleased(sf::Keyboard::Key key) { m_pressedKeys.erase(key); }
+  void keyReleased(sf::Keyboard::Key key) {
+    if (isTracked(key))
+      m_pressedKeys.reset(static_cast<std::size_t>(key));
+  }
 
   // Check if a key is currently held
   bool isKeyHeld(sf::Keyboard::Key key) const {
-    return m_pressedKeys.count(key) > 0;
+    return isTracked(key) && m_pressedKeys.test(static_cast<std::size_t>(key));
   }
 
   // Convenience methods for game controls
@@ -41,8 +67,47 @@ public:
 
   bool isDrifting() const { return isKeyHeld(sf::Keyboard::Key::Space); }
 
-  void clear() { m_pressedKeys.clear(); }
+  // Current controls as a compact value (what the player simulation reads)
+  ControlInput getControls() const {
+    ControlInput controls;
+    if (isAccelerating())
+      controls.bits |= ControlInput::Accelerate;
+    if (isBraking())
+      controls.bits |= ControlInput::Brake;
+    if (isTurningLeft())
+      controls.bits |= ControlInput::TurnLeft;
+    if (isTurningRight())
+      controls.bits |= ControlInput::TurnRight;
+    if (isDrifting())
+      controls.bits |= ControlInput::Drift;
+    return controls;
+  }
+
+  void clear() { m_pressedKeys.reset(); }
+
+  // Snapshot held keys
+  void saveState(StateWriter &writer) const {
+    writer.write(static_cast<std::uint32_t>(m_pressedKeys.count()));
+    for (std::size_t i = 0; i < m_pressedKeys.size(); ++i) {
+      if (m_pressedKeys.test(i))
+        writer.write(static_cast<sf::Keyboard::Key>(i));
+    }
+  }
+  bool loadState(StateReader &reader) {
+    std::uint32_t count = 0;
+    reader.read(count);
+    m_pressedKeys.reset();
+    sf::Keyboard::Key key;
+    for (std::uint32_t i = 0; i < count && reader.read(key); ++i)
+      keyPressed(key);
+    return reader.ok();
+  }
 
 private:
-  std::unordered_set<sf::Keyboard::Key> m_pressedKeys;
+  static bool isTracked(sf::Keyboard::Key key) {
+    return key != sf::Keyboard::Key::Unknown &&
+           static_cast<std::size_t>(key) < sf::Keyboard::KeyCount;
+  }
+
+  std::bitset<sf::Keyboard::KeyCount> m_pressedKeys;
 };
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "core/ControlInput.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/**
+ * Driving controls for consecutive Playing ticks, for headless replay
+ * Stored run-length encoded: held controls change rarely between ticks
+ */
+struct InputRecording {
+  std::uint32_t tickRate = 60;
+  std::vector<ControlInput> ticks;
+
+  bool save(const std::filesystem::path &path) const;
+  bool load(const std::filesystem::path &path);
+};
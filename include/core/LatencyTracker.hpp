@@ -0,0 +1,105 @@
+#pragma once
+
+#include "core/SpscRing.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Percentiles of one latency measurement, in milliseconds
+ */
+struct LatencyPercentiles {
+  float p50 = 0.0f;
+  float p90 = 0.0f;
+  float p99 = 0.0f;
+  float max = 0.0f;
+};
+
+// Nearest-rank percentile (fraction in [0, 1], index rounded down), shared
+// by the latency report and the tools so they agree on the definition.
+// Reorders values; 0 when there are none.
+template <typename T> T percentile(std::vector<T> &values, float fraction) {
+  if (values.empty())
+    return T();
+  auto index = static_cast<std::size_t>(fraction * (values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+/**
+ * Summary over the most recent input samples
+ */
+struct LatencyReport {
+  std::size_t samples = 0;
+  LatencyPercentiles inputToTick;    // Input timestamp to consuming tick
+  LatencyPercentiles inputToDisplay; // Input timestamp to displayed frame
+  float withinOneFrame = 0.0f;       // Fraction displayed within one frame
+  std::uint32_t maxFrames = 0;       // Worst case in displayed frames
+  std::size_t dropped = 0;           // Inputs lost before measurement
+};
+
+/**
+ * Input-to-display latency measurement across the simulation and render
+ * threads. The simulation reports each input when a tick consumes it; the
+ * render thread completes it with the first presented frame whose snapshot
+ * includes that tick.
+ */
+class LatencyTracker {
+public:
+  static constexpr std::size_t HISTORY = 4096; // Samples kept for the report
+
+  // Monotonic timestamp shared by both threads
+  static std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // Simulation thread: input taken at inputNs (during render frame
+  // inputFrame) was applied by tick, which started at tickNs
+  void onConsumed(std::int64_t inputNs, std::uint64_t inputFrame,
+                  std::uint64_t tick, std::int64_t tickNs) {
+    if (!m_consumed.tryPush({inputNs, inputFrame, tick, tickNs}))
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Render thread: frame showing the snapshot of step was presented
+  void onDisplayed(std::uint64_t step, std::uint64_t frame,
+                   std::int64_t displayNs);
+
+  // Render thread
+  LatencyReport report(float framePeriodMs) const;
+  void print(std::FILE *out, float framePeriodMs) const;
+
+private:
+  struct ConsumedInput {
+    std::int64_t inputNs;
+    std::uint64_t inputFrame;
+    std::uint64_t tick;
+    std::int64_t tickNs;
+  };
+
+  struct Sample {
+    float toTickMs;
+    float toDisplayMs;
+    std::uint32_t frames;
+  };
+
+  static constexpr std::size_t QUEUE_SIZE = 256;
+
+  SpscRing<ConsumedInput, QUEUE_SIZE> m_consumed;
+  std::atomic<std::size_t> m_dropped{0};
+
+  // Render thread: consumed inputs whose tick has not been displayed yet
+  std::array<ConsumedInput, QUEUE_SIZE> m_waiting{};
+  std::size_t m_waitingCount = 0;
+
+  // Render thread: ring of completed samples
+  std::array<Sample, HISTORY> m_samples{};
+  std::size_t m_sampleCount = 0; // Total ever recorded
+};
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <type_traits>
+
+// Lowest level compiled in (0 = Trace ... 5 = Off); messages below it cost
+// nothing. Set through the NEONDRIFT_LOG_LEVEL CMake cache variable.
+#ifndef NEONDRIFT_LOG_LEVEL
+#define NEONDRIFT_LOG_LEVEL 1
+#endif
+
+/**
+ * Diagnostic message severity
+ */
+enum class LogLevel : std::uint8_t { Trace, Debug, Info, Warn, Error, Off };
+
+/**
+ * One message on its way from the logging thread to the writer (72 bytes)
+ * Nothing is formatted on the hot path: the record keeps the format string's
+ * address, which identifies the message, and the raw argument values. The
+ * writer thread substitutes the arguments for the format's "{}" markers.
+ */
+struct LogRecord {
+  static constexpr std::size_t MAX_ARGS = 4;
+
+  enum class ArgType : std::uint8_t { Int, Unsigned, Float, Bool, Text };
+
+  std::int64_t timestampNs;
+  const char *format;
+  const char *category;
+  union {
+    std::int64_t i;
+    std::uint64_t u;
+    double f;
+    const char *text;
+  } args[MAX_ARGS];
+  std::uint32_t suppressed; // Messages a rate limit held back before this
+  LogLevel level;
+  std::uint8_t argCount;
+  ArgType types[MAX_ARGS];
+};
+static_assert(sizeof(LogRecord) <= 72, "LogRecord must stay 72B");
+
+/**
+ * Logger settings
+ */
+struct LogConfig {
+  std::filesystem::path path; // Empty = stderr
+  LogLevel level = LogLevel::Info;
+  std::chrono::milliseconds flushInterval{50};
+};
+
+/**
+ * Structured asynchronous logger
+ * Each thread that logs gets its own lock-free ring, registered on its
+ * first message; the hot path only stamps the time and copies a LogRecord
+ * into that ring, so a message costs tens of nanoseconds and never waits
+ * on I/O. A background thread polls the rings, merges them in time order,
+ * formats and writes the lines. When a ring is full the message is
+ * dropped and counted, as with Telemetry. Use the ND_LOG macros rather
+ * than calling write() directly.
+ */
+class Log {
+public:
+  static constexpr LogLevel COMPILED_LEVEL =
+      static_cast<LogLevel>(NEONDRIFT_LOG_LEVEL);
+
+  // Start/stop the writer thread (stop drains what is queued)
+  static bool start(const LogConfig &config = LogConfig());
+  static void stop();
+  static bool isRunning() { return s_running.load(std::memory_order_relaxed); }
+
+  // Runtime filter on top of the compiled one
+  static void setLevel(LogLevel level) {
+    s_level.store(level, std::memory_order_relaxed);
+  }
+
+  static constexpr bool isCompiled(LogLevel level) {
+    return level >= COMPILED_LEVEL && level != LogLevel::Off;
+  }
+  static bool isEnabled(LogLevel level) {
+    return level >= s_level.load(std::memory_order_relaxed) &&
+           s_running.load(std::memory_order_relaxed);
+  }
+
+  static std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // Queue a message. Arguments are arithmetic, enums or string literals
+  // (only the pointer is kept, so the text must outlive the writer).
+  template <typename... Args>
+  static void writeAt(std::int64_t timestampNs, std::uint32_t suppressed,
+                      LogLevel level, const char *category,
+                      const char *format, const Args &...args) {
+    static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS,
+                  "Too many log arguments");
+    LogRecord record;
+    record.timestampNs = timestampNs;
+    record.format = format;
+    record.category = category;
+    record.suppressed = suppressed;
+    record.level = level;
+    record.argCount = static_cast<std::uint8_t>(sizeof...(Args));
+    std::size_t index = 0;
+    (encode(record, index++, args), ...);
+    push(record);
+  }
+  template <typename... Args>
+  static void write(LogLevel level, const char *category, const char *format,
+                    const Args &...args) {
+    writeAt(now(), 0, level, category, format, args...);
+  }
+
+  static const char *levelName(LogLevel level);
+  static bool parseLevel(const char *name, LogLevel &level); // "debug"
+
+  // Stats
+  static std::uint64_t getDroppedCount();
+  static std::uint64_t getWrittenCount() {
+    return s_written.load(std::memory_order_relaxed);
+  }
+
+private:
+  template <typename V>
+  static void encode(LogRecord &record, std::size_t index, const V &value) {
+    if constexpr (std::is_same_v<V, bool>) {
+      record.types[index] = LogRecord::ArgType::Bool;
+      record.args[index].u = value ? 1 : 0;
+    } else if constexpr (std::is_enum_v<V>) {
+      encode(record, index, static_cast<std::underlying_type_t<V>>(value));
+    } else if constexpr (std::is_floating_point_v<V>) {
+      record.types[index] = LogRecord::ArgType::Float;
+      record.args[index].f = static_cast<double>(value);
+    } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+      record.types[index] = LogRecord::ArgType::Int;
+      record.args[index].i = static_cast<std::int64_t>(value);
+    } else if constexpr (std::is_integral_v<V>) {
+      record.types[index] = LogRecord::ArgType::Unsigned;
+      record.args[index].u = static_cast<std::uint64_t>(value);
+    } else if constexpr (std::is_convertible_v<V, const char *>) {
+      record.types[index] = LogRecord::ArgType::Text;
+      record.args[index].text = value;
+    } else {
+      static_assert(!std::is_same_v<V, V>, "Unsupported log argument type");
+    }
+  }
+
+  static void push(const LogRecord &record);
+  static void writerLoop();
+
+  static std::atomic<bool> s_running;
+  static std::atomic<LogLevel> s_level;
+  static std::atomic<std::uint64_t> s_written;
+};
+
+/**
+ * Per-thread, per-call-site rate limit for messages logged every tick
+ * Lets one message through per interval and counts the rest, so the next
+ * one that goes out reports how many were held back.
+ */
+class LogRateLimit {
+public:
+  explicit LogRateLimit(double seconds)
+      : m_intervalNs(static_cast<std::int64_t>(seconds * 1e9)), m_nextNs(0),
+        m_suppressed(0) {}
+
+  bool allow(std::int64_t now, std::uint32_t &suppressed) {
+    if (now < m_nextNs) {
+      ++m_suppressed;
+      return false;
+    }
+    m_nextNs = now + m_intervalNs;
+    suppressed = m_suppressed;
+    m_suppressed = 0;
+    return true;
+  }
+
+private:
+  std::int64_t m_intervalNs;
+  std::int64_t m_nextNs;
+  std::uint32_t m_suppressed;
+};
+
+// ND_LOG(Info, "net", "Rolled back {} ticks", depth)
+// The level is a LogLevel name; "{}" marks each argument in the format.
+#define ND_LOG(level, category, ...)                                           \
+  do {                                                                         \
+    if constexpr (Log::isCompiled(LogLevel::level)) {                          \
+      if (Log::isEnabled(LogLevel::level))                                     \
+        Log::write(LogLevel::level, category, __VA_ARGS__);                    \
+    }                                                                          \
+  } while (false)
+
+// ND_LOG_EVERY(1.0, Debug, "player", "Drifting at {} px/s", speed)
+// At most one message per interval (seconds) from this line on this thread
+#define ND_LOG_EVERY(seconds, level, category, ...)                            \
+  do {                                                                         \
+    if constexpr (Log::isCompiled(LogLevel::level)) {                          \
+      if (Log::isEnabled(LogLevel::level)) {                                   \
+        static thread_local LogRateLimit ndLogLimit(seconds);                  \
+        std::int64_t ndLogNow = Log::now();                                    \
+        std::uint32_t ndLogSuppressed = 0;                                     \
+        if (ndLogLimit.allow(ndLogNow, ndLogSuppressed))                       \
+          Log::writeAt(ndLogNow, ndLogSuppressed, LogLevel::level, category,   \
+                       __VA_ARGS__);                                           \
+      }                                                                        \
+    }                                                                          \
+  } while (false)
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Ring of recent simulation states for instant rewind
+ * Each capture is stored as an XOR delta against the capture before it
+ * (consecutive ticks share most bytes), with a full keyframe every
+ * KEYFRAME_INTERVAL captures to bound reconstruction work. Slot buffers
+ * are reused, so once the ring has wrapped, pushing does not allocate.
+ */
+class RewindBuffer {
+public:
+  explicit RewindBuffer(std::size_t capacity = 0);
+
+  // Captures kept (clears the history)
+  void setCapacity(std::size_t capacity);
+  std::size_t getCapacity() const { return m_slots.size(); }
+
+  // Append the newest state
+  void push(const std::vector<std::uint8_t> &state);
+
+  // Captures that can be restored, newest included
+  std::size_t size() const;
+
+  // Reconstruct the state `back` captures before the newest (0 = newest)
+  // and drop everything after it, so capturing continues from there
+  bool rewind(std::size_t back, std::vector<std::uint8_t> &state);
+
+  void clear();
+
+  // Encoded bytes held across all slots
+  std::size_t getStoredBytes() const;
+
+  static constexpr std::size_t KEYFRAME_INTERVAL = 30;
+
+private:
+  struct Slot {
+    std::vector<std::uint8_t> encoded;
+    std::uint32_t rawSize = 0;
+    bool keyframe = false;
+  };
+
+  // Slot holding the capture `back` steps before the newest
+  std::size_t slotIndex(std::size_t back) const;
+
+  std::vector<Slot> m_slots;
+  std::size_t m_newest; // Slot of the newest capture
+  std::size_t m_count;  // Captures held
+  std::size_t m_sinceKeyframe;
+  std::vector<std::uint8_t> m_previous; // Newest raw state (delta base)
+};
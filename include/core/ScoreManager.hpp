@@ -1,44 +1,56 @@
 #pragma once
 
+#include "core/StateStream.hpp"
+#include "math/Scalar.hpp"
 #include <cstdint>
 
 /**
  * Manages scoring, combo system, and difficulty progression
+ * Scoring state is templated on the scalar type (float or Fixed); fractional
+ * points are carried between ticks instead of being truncated
  */
-class ScoreManager {
+template <typename T> class BasicScoreManager {
 public:
-  ScoreManager();
+  BasicScoreManager();
 
   // Update scoring (call each frame while playing)
-  void update(float deltaTime, float playerSpeed, bool isDrifting,
-              float driftAmount);
+  void update(T deltaTime, T playerSpeed, bool isDrifting, T driftAmount);
 
   // Score events
-  void onDriftEnd(float driftDuration, float averageSpeed);
+  void onDriftEnd(T driftDuration, T averageSpeed);
   void onCollision();
+  void onComboPickup();
 
   // Getters
   std::uint64_t getScore() const { return m_score; }
-  float getComboMultiplier() const { return m_comboMultiplier; }
-  float getComboTimer() const { return m_comboTimer; }
+  float getComboMultiplier() const {
+    return scalar::toFloat(m_comboMultiplier);
+  }
+  float getComboTimer() const { return scalar::toFloat(m_comboTimer); }
   float getMaxComboTimer() const { return MAX_COMBO_TIME; }
-  float getDifficulty() const { return m_difficulty; }
-  float getDriftMeter() const { return m_driftMeter; }
-  bool isComboActive() const { return m_comboTimer > 0.0f; }
+  float getDifficulty() const { return scalar::toFloat(m_difficulty); }
+  T getSimDifficulty() const { return m_difficulty; }
+  float getDriftMeter() const { return scalar::toFloat(m_driftMeter); }
+  bool isComboActive() const { return m_comboTimer > T(0.0f); }
 
   // Reset for new game
   void reset();
 
+  // Snapshot scoring state
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
 private:
-  void addScore(std::uint64_t points);
-  void updateDifficulty(float deltaTime);
+  void addScore(T points);
+  void updateDifficulty(T deltaTime);
 
   std::uint64_t m_score;
-  float m_comboMultiplier;
-  float m_comboTimer;
-  float m_driftMeter; // Fills up while drifting
-  float m_difficulty; // 0.0 to 2.0, increases over time
-  float m_gameTime;
+  T m_pendingPoints; // Fractional points not yet added to m_score
+  T m_comboMultiplier;
+  T m_comboTimer;
+  T m_driftMeter; // Fills up while drifting
+  T m_difficulty; // 0.0 to 2.0, increases over time
+  T m_gameTime;
 
   // Scoring constants
   static constexpr float MAX_COMBO_TIME = 3.0f;
@@ -47,3 +59,8 @@ private:
   static constexpr float DIFFICULTY_INCREASE_RATE = 0.01f;
   static constexpr float MAX_DIFFICULTY = 2.0f;
 };
+
+extern template class BasicScoreManager<float>;
+extern template class BasicScoreManager<Fixed>;
+
+using ScoreManager = BasicScoreManager<SimScalar>;
@@ -0,0 +1,303 @@
+#pragma once
+
+#include "core/GameState.hpp"
+#include "core/InputManager.hpp"
+#include "core/InputRecording.hpp"
+#include "core/RewindBuffer.hpp"
+#include "core/ScoreManager.hpp"
+#include "core/Telemetry.hpp"
+#include "core/TickProfile.hpp"
+#include "entities/BotDriver.hpp"
+#include "entities/EntityWorld.hpp"
+#include "entities/PhysicsProfile.hpp"
+#include "entities/Player.hpp"
+#include "entities/Spawner.hpp"
+#include "graphics/DriftRibbon.hpp"
+#include "graphics/ParticleSystem.hpp"
+#include "graphics/SkidMarkLayer.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/**
+ * Key event forwarded from the window thread to the simulation
+ */
+struct InputEvent {
+  std::int64_t timestampNs; // steady_clock time the event was polled
+  std::uint64_t frame;      // Render frame that polled it
+  sf::Keyboard::Key key;
+  bool pressed;
+};
+
+/**
+ * Immutable view of one simulation tick, everything the renderer needs
+ */
+struct FrameSnapshot {
+  GameState state = GameState::Menu;
+  std::uint64_t step = 0; // Simulation step that produced this snapshot
+  sf::Vector2f cameraCenter; // World point at the center of the screen
+  sf::Vector2f screenShake;
+  std::vector<RenderInstance> entities; // World entities, player included
+  float playerSpeed = 0.0f;
+  ScoreManager score;
+  float uiPulse = 0.0f;
+  bool idle = false; // Nothing will change until new input arrives
+  std::uint64_t inputSequence = 0; // Input events applied (set by the driver)
+  bool versus = false;             // Two-player mode
+  std::uint64_t opponentScore = 0; // Versus only
+  std::vector<sf::Vertex> particleVertices; // Sized once, reused
+  std::size_t particleVertexCount = 0;
+  std::vector<sf::Vertex> trailVertices; // Drift ribbons, one triangle strip
+  std::size_t trailVertexCount = 0;
+  SkidSource skids[SkidMarkLayer::MAX_SOURCES]; // Local car, then the rival
+  std::size_t skidCount = 0;
+};
+
+/**
+ * Gameplay simulation: state machine, entities, scoring and effects
+ * Runs at a fixed timestep with no window or rendering dependency, so it
+ * can live on its own thread (or headless) and publish FrameSnapshots
+ */
+class Simulation {
+public:
+  static constexpr unsigned int TICK_RATE = 60;
+  static constexpr float FIXED_TIMESTEP = 1.0f / TICK_RATE;
+
+  Simulation();
+  explicit Simulation(std::uint32_t seed); // Seeds obstacle spawning
+
+  // Setup
+  void loadEffects(const std::filesystem::path &path);
+  void startTelemetry();
+
+  // Load vehicle handling; the file is watched and reloaded when it changes
+  // (keeps the current profile if it cannot be read)
+  bool loadPhysics(const std::filesystem::path &path);
+
+  // Let a scripted driver steer instead of the keyboard (for soak runs)
+  void enableBot(std::uint32_t seed);
+
+  // Record the driving controls of every Playing tick from now on
+  void startRecording();
+  const InputRecording &getRecording() const { return m_recording; }
+
+  // Input (state machine transitions are applied at the next step)
+  void handleKey(sf::Keyboard::Key key, bool pressed);
+
+  // Advance one fixed tick
+  void step();
+
+  // Advance one fixed tick with given controls for the local car instead
+  // of polling them (replaying a recording). Handling is not reloaded and
+  // nothing is captured for rewinding.
+  void step(const ControlInput &controls);
+
+  // Two-player mode: this simulation drives the car in localSlot (0 or 1),
+  // the other car follows the controls passed to stepVersus. Both peers
+  // must use the same seed. Play starts immediately.
+  void enableVersus(int localSlot, std::uint32_t seed);
+  bool isVersus() const { return m_versus; }
+
+  // Controls the local car uses this tick (keyboard, or the bot if enabled)
+  ControlInput pollLocalControls();
+
+  // One versus tick with both cars' controls. A resimulated tick (rollback)
+  // is not counted as a step and records no telemetry or input.
+  void stepVersus(const ControlInput &local, const ControlInput &opponent,
+                  bool resimulated = false);
+
+  // Hash of the state both peers share (cars in slot order, scores,
+  // spawned entities), for desync detection
+  std::uint32_t getVersusChecksum() const;
+
+  // Copy renderable state into a snapshot
+  void writeSnapshot(FrameSnapshot &snapshot) const;
+
+  // Complete gameplay state as a compact binary blob (replaces the buffer's
+  // contents, reusing its capacity). Configuration - handling profile,
+  // effects, recording, telemetry - and the step counter are not included.
+  void saveState(std::vector<std::uint8_t> &state) const;
+
+  // Restore a blob from saveState; on failure the state is left unchanged.
+  // keepHeldKeys leaves the live keyboard state alone (rewind, rollback)
+  bool loadState(const std::vector<std::uint8_t> &state,
+                 bool keepHeldKeys = false);
+
+  // Capture every Playing tick, keeping the last `seconds` for rewinding
+  void enableRewind(float seconds);
+
+  // Step back up to `ticks` Playing ticks (held keys are kept)
+  bool rewind(std::size_t ticks);
+  const RewindBuffer &getRewindBuffer() const { return m_rewind; }
+
+  // Particle density under load (see ParticleSystem::setBudget)
+  void setParticleBudget(float budget) { m_particles.setBudget(budget); }
+  float getParticleCostMs() const { return m_particles.getCostMs(); }
+  std::size_t getParticleCount() const { return m_particles.getActiveCount(); }
+
+  // What spawning does at the particle cap (clears live particles)
+  void setParticlePool(PoolPolicy policy) {
+    m_particles.setPoolPolicy(policy);
+  }
+  ParticleSystem::PoolStats getParticlePoolStats() const {
+    return m_particles.getPoolStats();
+  }
+
+  // Time each phase of Playing ticks (perf runs; off by default)
+  void enableProfiling() { m_profiling = true; }
+  const TickProfile &getTickProfile() const { return m_profile; }
+
+  GameState getState() const { return m_currentState; }
+  const InputManager &getInput() const { return m_inputManager; }
+
+  // True when stepping would change nothing (menus and frozen world) until
+  // the next input event
+  bool isIdle() const {
+    return m_currentState != GameState::Playing && !m_stateChangeRequested;
+  }
+  bool isQuitRequested() const { return m_quitRequested; }
+  std::uint64_t getStepCount() const { return m_stepCount; }
+  std::uint64_t getScore() const { return m_scoreManager.getScore(); }
+
+private:
+  /**
+   * Second car in versus mode, driven by the remote peer's controls
+   */
+  struct Opponent {
+    Player player;
+    Entity entity;
+    ScoreManager score;
+    bool wasDrifting = false;
+    DriftRibbon trail;
+  };
+
+  void update(float deltaTime, const ControlInput &local,
+              const ControlInput &opponent, bool resimulated);
+  void handleStateTransition();
+
+  // Charge the time since start to phase when profiling (start moves on)
+  void endPhase(TickPhase phase, std::int64_t &start);
+
+  // Entity for a car (player or opponent)
+  Entity createCar();
+
+  // Copy the player controller's state into its entity
+  void syncPlayerEntity();
+  void syncOpponentEntity();
+
+  // React to obstacles and pickups touching a car; only the local car
+  // shakes the screen
+  void resolveContacts(Player &player, Entity entity, ScoreManager &score,
+                       bool local);
+
+  // Versus: advance the opponent's car and scoring
+  void updateOpponent(SimScalar deltaTime, const ControlInput &controls);
+
+  // Score one car's tick, with the drift-end bonus; both versus cars go
+  // through here so they score identically
+  void scoreCar(const Player &player, ScoreManager &score, bool &wasDrifting,
+                SimScalar deltaTime);
+
+  // Age a car's drift ribbon and extend it while the car drifts
+  void updateTrail(const Player &player, DriftRibbon &trail, float deltaTime);
+
+  // A car's tires for skid marks (they mark where the ribbon is drawn)
+  static SkidSource skidSource(const Player &player);
+
+  // Gameplay telemetry (call once per Playing tick, after scoring, with the
+  // drift state before the tick)
+  void recordTelemetry(bool wasDrifting);
+
+  // Reload the physics profile if its file changed on disk
+  void pollPhysicsProfile();
+
+  // Parse a state blob over the current state (may stop part-way)
+  bool readState(StateReader &reader);
+
+  // Fresh game from the initial state, with new obstacle layouts
+  void restart();
+
+  // Game state
+  GameState m_currentState;
+  GameState m_pendingState;
+  bool m_stateChangeRequested;
+  bool m_quitRequested;
+  std::uint64_t m_stepCount;
+
+  // Input
+  InputManager m_inputManager;
+  InputRecording m_recording;
+  bool m_recordingEnabled;
+  BotDriver m_bot;
+  bool m_botEnabled;
+
+  // Vehicle handling (hot reloaded)
+  std::filesystem::path m_physicsPath;
+  std::filesystem::file_time_type m_physicsWriteTime;
+  static constexpr std::uint64_t PHYSICS_POLL_INTERVAL = 30; // Ticks
+
+  // Game entities
+  EntityWorld m_world;
+  Player m_player;
+  Entity m_playerEntity;
+  Spawner m_spawner;
+  sf::Vector2f m_cameraCenter;
+
+  // Versus
+  bool m_versus;
+  std::int32_t m_localSlot;
+  Opponent m_opponent;
+
+  // Visual effects
+  ParticleSystem m_particles;
+  DriftRibbon m_trail; // Behind the local car
+  sf::Vector2f m_screenShake;
+  float m_shakeIntensity;
+  Pcg32 m_shakeRng;
+
+  // Scoring and UI animation
+  ScoreManager m_scoreManager;
+  float m_uiPulse;
+  bool m_wasDrifting;
+
+  // Telemetry
+  Telemetry m_telemetry;
+  std::uint32_t m_tick;
+  std::uint32_t m_driftStartTick;
+  float m_driftSpeedSum;
+  float m_lastComboMultiplier;
+  std::uint16_t m_speedHistogram[Telemetry::SPEED_BUCKETS];
+  std::uint32_t m_histogramTicks;
+  static constexpr std::uint32_t HISTOGRAM_INTERVAL = 60; // Ticks per report
+
+  // Profiling
+  bool m_profiling;
+  TickProfile m_profile;
+
+  // Snapshots and rewind
+  RewindBuffer m_rewind;
+  bool m_rewindRequested;
+  std::vector<std::uint8_t> m_initialState; // Restored on restart
+  std::vector<std::uint8_t> m_stateScratch; // Capture/rewind buffer
+  std::vector<std::uint8_t> m_stateBackup;  // Undo for loadState
+  static constexpr std::size_t REWIND_TICKS = TICK_RATE * 2; // Per press
+
+  // Contact response
+  static constexpr std::size_t MAX_CONTACTS = 8;
+
+  // Recording storage reserved up front (one byte per tick)
+  static constexpr std::size_t RECORDING_RESERVE_TICKS = TICK_RATE * 60 * 30;
+  static constexpr float IMPACT_SPEED_KEPT = 0.35f;
+  static constexpr float BOOST_IMPULSE = 400.0f;
+  static constexpr float IMPACT_SHAKE = 12.0f;
+  static constexpr float TRAIL_MIN_SPEED = 100.0f; // Drifts slower leave none
+
+  // Local car, plus the rival in versus mode
+  static constexpr std::size_t MAX_CARS = 2;
+
+  // Versus start grid, slot 0 then slot 1 (pixels)
+  static constexpr float GRID_X[MAX_CARS] = {600.0f, 680.0f};
+  static constexpr float GRID_Y = 400.0f;
+  static constexpr sf::Color OPPONENT_COLOR = sf::Color(255, 60, 200);
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Lock-free single-producer/single-consumer ring buffer
+ * Fixed capacity (power of two), never allocates or blocks
+ */
+template <typename T, std::size_t Capacity> class SpscRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscRing capacity must be a power of two");
+
+public:
+  // Producer side - returns false when the ring is full
+  bool tryPush(const T &item) {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_cachedTail == Capacity) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      if (head - m_cachedTail == Capacity)
+        return false;
+    }
+    m_items[head & MASK] = item;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side - returns false when the ring is empty
+  bool tryPop(T &item) {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_cachedHead) {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      if (tail == m_cachedHead)
+        return false;
+    }
+    item = m_items[tail & MASK];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side - pops up to maxCount items, returns how many were read
+  std::size_t popBatch(T *out, std::size_t maxCount) {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::size_t head = m_head.load(std::memory_order_acquire);
+    std::size_t count = head - tail;
+    if (count > maxCount)
+      count = maxCount;
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = m_items[(tail + i) & MASK];
+    }
+    m_tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // Approximate number of queued items (exact when called from one side)
+  std::size_t size() const {
+    return m_head.load(std::memory_order_acquire) -
+           m_tail.load(std::memory_order_acquire);
+  }
+
+  static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+  static constexpr std::size_t MASK = Capacity - 1;
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  // Producer and consumer indices live on separate cache lines so the two
+  // threads never false-share
+  alignas(CACHE_LINE) std::atomic<std::size_t> m_head{0};
+  std::size_t m_cachedTail = 0; // producer's view of m_tail
+  alignas(CACHE_LINE) std::atomic<std::size_t> m_tail{0};
+  std::size_t m_cachedHead = 0; // consumer's view of m_head
+  alignas(CACHE_LINE) std::array<T, Capacity> m_items{};
+};
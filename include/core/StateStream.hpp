@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Appends plain data to a byte buffer (simulation snapshots)
+ * Values are written in native layout: snapshots restore into the same
+ * build, they are not an interchange format
+ */
+class StateWriter {
+public:
+  explicit StateWriter(std::vector<std::uint8_t> &buffer) : m_buffer(buffer) {}
+
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "plain data only");
+    writeBytes(&value, sizeof(T));
+  }
+
+  // Element count followed by the elements
+  template <typename T> void writeVector(const std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable_v<T>, "plain data only");
+    write(static_cast<std::uint32_t>(values.size()));
+    writeBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  void writeBytes(const void *data, std::size_t size) {
+    if (size == 0)
+      return;
+    std::size_t offset = m_buffer.size();
+    m_buffer.resize(offset + size);
+    std::memcpy(m_buffer.data() + offset, data, size);
+  }
+
+private:
+  std::vector<std::uint8_t> &m_buffer;
+};
+
+/**
+ * Reads back what a StateWriter wrote
+ * Failure is sticky: once a read runs past the end every later read fails,
+ * so callers check ok() once at the end
+ */
+class StateReader {
+public:
+  StateReader(const std::uint8_t *data, std::size_t size)
+      : m_data(data), m_size(size), m_offset(0), m_ok(true) {}
+
+  template <typename T> bool read(T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "plain data only");
+    return readBytes(&value, sizeof(T));
+  }
+
+  // Replaces the vector's contents (reuses its capacity)
+  template <typename T> bool readVector(std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable_v<T>, "plain data only");
+    std::uint32_t count = 0;
+    if (!read(count) || count > (m_size - m_offset) / sizeof(T))
+      return m_ok = false;
+    values.resize(count);
+    return readBytes(values.data(), count * sizeof(T));
+  }
+
+  bool readBytes(void *data, std::size_t size) {
+    if (!m_ok || size > m_size - m_offset)
+      return m_ok = false;
+    if (size > 0)
+      std::memcpy(data, m_data + m_offset, size);
+    m_offset += size;
+    return true;
+  }
+
+  // Read a value and fail unless it equals the expected one
+  template <typename T> bool expect(const T &expected) {
+    T value;
+    if (read(value) && !(value == expected))
+      m_ok = false;
+    return m_ok;
+  }
+
+  // Reject the stream after a value read from it failed validation
+  bool fail() { return m_ok = false; }
+
+  bool ok() const { return m_ok; }
+  bool atEnd() const { return m_offset == m_size; }
+
+private:
+  const std::uint8_t *m_data;
+  std::size_t m_size;
+  std::size_t m_offset;
+  bool m_ok;
+};
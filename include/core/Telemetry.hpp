@@ -0,0 +1,144 @@
+#pragma once
+
+#include "core/SpscRing.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+
+/**
+ * Gameplay telemetry event types
+ */
+enum class TelemetryEvent : std::uint16_t {
+  SessionStart,
+  DriftStart,
+  DriftEnd,
+  ComboChanged,
+  Difficulty,
+  SpeedHistogram
+};
+
+/**
+ * Fixed-size binary telemetry record (24 bytes)
+ * Payload layout depends on the event type:
+ *   DriftStart     f[0] = speed
+ *   DriftEnd       f[0] = duration (s), f[1] = average speed,
+ *                  f[2] = drift meter
+ *   ComboChanged   f[0] = new multiplier, f[1] = previous multiplier
+ *   Difficulty     f[0] = difficulty
+ *   SpeedHistogram u16[] = tick counts per speed bucket
+ */
+struct TelemetryRecord {
+  std::uint32_t tick;
+  TelemetryEvent type;
+  std::uint16_t reserved;
+  union {
+    float f[4];
+    std::uint16_t u16[8];
+  } data;
+};
+static_assert(sizeof(TelemetryRecord) == 24, "TelemetryRecord must stay 24B");
+
+/**
+ * Telemetry stream settings
+ */
+struct TelemetryConfig {
+  std::filesystem::path directory = "telemetry";
+  std::size_t maxFileBytes = 4 * 1024 * 1024; // Rotate after this size
+  std::size_t maxFiles = 8;                   // Oldest files are deleted
+  std::chrono::milliseconds flushInterval{100};
+};
+
+/**
+ * Gameplay telemetry channel
+ * The game thread pushes records into a lock-free ring; a background thread
+ * batches, compresses and writes them to rotating files. Pushing never
+ * blocks: when the ring is full the record is dropped and counted.
+ */
+class Telemetry {
+public:
+  static constexpr std::size_t SPEED_BUCKETS = 8;
+  static constexpr float SPEED_BUCKET_SIZE = 100.0f; // px/s per bucket
+
+  Telemetry() = default;
+  ~Telemetry();
+
+  Telemetry(const Telemetry &) = delete;
+  Telemetry &operator=(const Telemetry &) = delete;
+
+  // Start/stop the writer thread
+  bool start(const TelemetryConfig &config = TelemetryConfig());
+  void stop();
+  bool isRunning() const { return m_running.load(std::memory_order_relaxed); }
+
+  // Event recording (game thread only)
+  void driftStart(std::uint32_t tick, float speed) {
+    push(makeRecord(tick, TelemetryEvent::DriftStart, speed));
+  }
+  void driftEnd(std::uint32_t tick, float duration, float averageSpeed,
+                float driftMeter) {
+    push(makeRecord(tick, TelemetryEvent::DriftEnd, duration, averageSpeed,
+                    driftMeter));
+  }
+  void comboChanged(std::uint32_t tick, float multiplier, float previous) {
+    push(makeRecord(tick, TelemetryEvent::ComboChanged, multiplier, previous));
+  }
+  void difficulty(std::uint32_t tick, float value) {
+    push(makeRecord(tick, TelemetryEvent::Difficulty, value));
+  }
+  void speedHistogram(std::uint32_t tick,
+                      const std::uint16_t (&buckets)[SPEED_BUCKETS]) {
+    TelemetryRecord record = makeRecord(tick, TelemetryEvent::SpeedHistogram);
+    for (std::size_t i = 0; i < SPEED_BUCKETS; ++i) {
+      record.data.u16[i] = buckets[i];
+    }
+    push(record);
+  }
+
+  // Bucket index for a speed value
+  static std::size_t speedBucket(float speed) {
+    std::size_t bucket = static_cast<std::size_t>(speed / SPEED_BUCKET_SIZE);
+    return bucket < SPEED_BUCKETS ? bucket : SPEED_BUCKETS - 1;
+  }
+
+  // Stats
+  std::uint64_t getDroppedCount() const {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+  std::uint64_t getWrittenCount() const {
+    return m_written.load(std::memory_order_relaxed);
+  }
+
+private:
+  static TelemetryRecord makeRecord(std::uint32_t tick, TelemetryEvent type,
+                                    float a = 0.0f, float b = 0.0f,
+                                    float c = 0.0f) {
+    TelemetryRecord record{};
+    record.tick = tick;
+    record.type = type;
+    record.data.f[0] = a;
+    record.data.f[1] = b;
+    record.data.f[2] = c;
+    return record;
+  }
+
+  void push(const TelemetryRecord &record) {
+    if (!m_running.load(std::memory_order_relaxed))
+      return;
+    if (!m_ring.tryPush(record)) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void writerLoop();
+
+  static constexpr std::size_t RING_CAPACITY = 4096;
+
+  SpscRing<TelemetryRecord, RING_CAPACITY> m_ring;
+  TelemetryConfig m_config;
+  std::thread m_writer;
+  std::atomic<bool> m_running{false};
+  std::atomic<std::uint64_t> m_dropped{0};
+  std::atomic<std::uint64_t> m_written{0};
+};
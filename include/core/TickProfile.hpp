@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Part of a Playing tick timed by TickProfile
+ */
+enum class TickPhase : std::uint8_t {
+  Particles, // Particle update and screen shake
+  Player,    // Local car handling
+  Entities,  // Spawning, motion, lifetimes, contacts (and the rival car)
+  Scoring,   // Score, combo and telemetry
+  Effects,   // Drift ribbons and speed lines
+  Count
+};
+
+/**
+ * Time spent in each phase of the last Playing tick, in milliseconds
+ * (filled by Simulation when profiling is enabled)
+ */
+struct TickProfile {
+  std::array<float, static_cast<std::size_t>(TickPhase::Count)> ms{};
+
+  float &operator[](TickPhase phase) {
+    return ms[static_cast<std::size_t>(phase)];
+  }
+  float operator[](TickPhase phase) const {
+    return ms[static_cast<std::size_t>(phase)];
+  }
+
+  static const char *phaseName(TickPhase phase) {
+    switch (phase) {
+    case TickPhase::Particles:
+      return "particles";
+    case TickPhase::Player:
+      return "player";
+    case TickPhase::Entities:
+      return "entities";
+    case TickPhase::Scoring:
+      return "scoring";
+    case TickPhase::Effects:
+      return "effects";
+    case TickPhase::Count:
+      break;
+    }
+    return "?";
+  }
+};
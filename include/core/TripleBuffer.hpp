@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/**
+ * Lock-free triple buffer for handing whole snapshots from one producer
+ * thread to one consumer thread. The producer always has a slot to write
+ * and the consumer always has a complete slot to read; neither ever waits.
+ */
+template <typename T> class TripleBuffer {
+public:
+  // Producer: slot to fill before publish()
+  T &writeBuffer() { return m_slots[m_back]; }
+
+  // Producer: make the written slot the newest snapshot
+  void publish() {
+    unsigned previous =
+        m_middle.exchange(m_back | FRESH_BIT, std::memory_order_acq_rel);
+    m_back = previous & INDEX_MASK;
+  }
+
+  // Consumer: switch to the newest snapshot, returns false if none is new
+  bool acquire() {
+    if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+      return false;
+    unsigned previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & INDEX_MASK;
+    return true;
+  }
+
+  // Consumer: most recently acquired snapshot
+  const T &readBuffer() const { return m_slots[m_front]; }
+
+private:
+  static constexpr unsigned FRESH_BIT = 4;
+  static constexpr unsigned INDEX_MASK = 3;
+
+  std::array<T, 3> m_slots{};
+  unsigned m_back = 0;                // Producer only
+  std::atomic<unsigned> m_middle{1};  // Shared hand-off slot
+  unsigned m_front = 2;               // Consumer only
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "core/ControlInput.hpp"
+#include "entities/EntityWorld.hpp"
+#include "entities/Player.hpp"
+#include "math/Random.hpp"
+#include <cstdint>
+
+/**
+ * Scripted driver producing controls from the player's state
+ * Follows a weaving racing line of waypoints ahead of the car, drifts
+ * through sharp corners, swerves around obstacles in its path and detours
+ * for nearby pickups. Decisions use only the simulation scalar (no trig),
+ * so a seeded bot drives identically in float and fixed-point builds.
+ */
+class BotDriver {
+public:
+  explicit BotDriver(std::uint32_t seed = 0);
+
+  // Controls for the next tick
+  ControlInput decide(const Player &player, const EntityWorld &world);
+
+  // Snapshot generator and racing-line state
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
+private:
+  // Pick the next racing-line point ahead of the car
+  void nextWaypoint(const Player &player);
+
+  // Nearest obstacle in the path; lateral is its signed offset (positive to
+  // the right). Returns false if the path is clear
+  bool findThreat(const Player &player, const EntityWorld &world,
+                  SimScalar &lateral) const;
+
+  // Closest pickup ahead within reach (leaves position alone if none)
+  bool findPickup(const Player &player, const EntityWorld &world,
+                  Vec2<SimScalar> &position) const;
+
+  Pcg32 m_rng;
+  Vec2<SimScalar> m_waypoint;
+  bool m_hasWaypoint;
+  bool m_drifting; // Held until the corner opens up (drift builds over time)
+
+  // Racing line (pixels)
+  static constexpr float WAYPOINT_AHEAD_MIN = 500.0f;
+  static constexpr float WAYPOINT_AHEAD_MAX = 900.0f;
+  static constexpr float WAYPOINT_LATERAL = 700.0f;
+  static constexpr float WAYPOINT_REACHED = 120.0f;
+
+  // Steering thresholds as lateral/forward ratios (tangent of the angle)
+  static constexpr float STEER_DEADZONE = 0.08f; // ~5 degrees
+  static constexpr float DRIFT_ANGLE = 0.6f;     // ~30 degrees
+  static constexpr float DRIFT_EXIT_ANGLE = 0.2f; // ~11 degrees
+  static constexpr float DRIFT_MIN_SPEED = 250.0f;
+  static constexpr float BRAKE_SPEED = 450.0f; // Brake into corners behind
+
+  // Avoidance (pixels)
+  static constexpr float LOOKAHEAD = 420.0f;
+  static constexpr float CLEARANCE = 30.0f;
+  static constexpr float PICKUP_REACH = 500.0f;
+};
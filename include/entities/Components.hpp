@@ -0,0 +1,87 @@
+#pragma once
+
+#include "math/Vec2.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+/**
+ * Plain-data components for world entities
+ * Gameplay values use the simulation scalar so the deterministic build stays
+ * bit-exact; render data is float
+ */
+
+using ComponentMask = std::uint32_t;
+
+struct Transform {
+  Vec2<SimScalar> position;
+  SimScalar rotation = SimScalar(0.0f); // degrees
+};
+
+struct Velocity {
+  Vec2<SimScalar> linear;
+  SimScalar angular = SimScalar(0.0f); // degrees per second
+};
+
+// Collision layers
+namespace CollisionLayer {
+enum : std::uint32_t {
+  Player = 1u << 0,
+  Obstacle = 1u << 1,
+  BoostPickup = 1u << 2, // Speed boost
+  ComboPickup = 1u << 3, // Combo multiplier
+};
+constexpr std::uint32_t PICKUPS = BoostPickup | ComboPickup;
+} // namespace CollisionLayer
+
+struct Collider {
+  SimScalar radius = SimScalar(0.0f);
+  std::uint32_t layer = 0; // Layers this collider is on
+  std::uint32_t mask = 0;  // Layers it reports overlaps with
+};
+
+enum class RenderShape : std::uint8_t { Vehicle, Circle, Diamond, Square };
+
+struct Renderable {
+  RenderShape shape = RenderShape::Circle;
+  sf::Color color = sf::Color::White;
+  float size = 10.0f; // Radius in pixels
+};
+
+struct Lifetime {
+  SimScalar remaining = SimScalar(0.0f); // Seconds until despawn
+};
+
+/**
+ * Component bits; an archetype is the set of components an entity has
+ */
+template <typename C> struct ComponentBit;
+template <> struct ComponentBit<Transform> {
+  static constexpr ComponentMask value = 1u << 0;
+};
+template <> struct ComponentBit<Velocity> {
+  static constexpr ComponentMask value = 1u << 1;
+};
+template <> struct ComponentBit<Collider> {
+  static constexpr ComponentMask value = 1u << 2;
+};
+template <> struct ComponentBit<Renderable> {
+  static constexpr ComponentMask value = 1u << 3;
+};
+template <> struct ComponentBit<Lifetime> {
+  static constexpr ComponentMask value = 1u << 4;
+};
+
+template <typename... C> constexpr ComponentMask componentMask() {
+  return (ComponentBit<C>::value | ... | 0u);
+}
+
+/**
+ * Render-ready entity (what the entity renderer draws)
+ */
+struct RenderInstance {
+  sf::Vector2f position;
+  float rotation = 0.0f; // degrees
+  float size = 0.0f;
+  sf::Color color;
+  RenderShape shape = RenderShape::Circle;
+};
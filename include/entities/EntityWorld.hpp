@@ -0,0 +1,179 @@
+#pragma once
+
+#include "core/StateStream.hpp"
+#include "entities/Components.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Generational handle to a world entity
+ */
+struct Entity {
+  static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+  std::uint32_t index = INVALID_INDEX;
+  std::uint32_t generation = 0;
+
+  bool isValid() const { return index != INVALID_INDEX; }
+  bool operator==(const Entity &o) const {
+    return index == o.index && generation == o.generation;
+  }
+  bool operator!=(const Entity &o) const { return !(*this == o); }
+};
+
+/**
+ * All entities with one exact component set, stored as one contiguous
+ * array per component (structure of arrays). Row i of every column belongs
+ * to entities()[i]; columns for absent components stay empty.
+ */
+class Archetype {
+public:
+  explicit Archetype(ComponentMask mask) : m_mask(mask) {}
+
+  ComponentMask getMask() const { return m_mask; }
+  std::size_t size() const { return m_entities.size(); }
+  const Entity *entities() const { return m_entities.data(); }
+
+  template <typename C> bool has() const {
+    return (m_mask & ComponentBit<C>::value) != 0;
+  }
+
+  // Column pointer, nullptr if the archetype lacks the component
+  template <typename C> C *column() {
+    return has<C>() ? columnVector<C>().data() : nullptr;
+  }
+  template <typename C> const C *column() const {
+    return has<C>() ? const_cast<Archetype *>(this)->columnVector<C>().data()
+                    : nullptr;
+  }
+
+  void reserve(std::size_t count);
+
+  // Append a row with default components, returns its index
+  std::size_t push(Entity entity);
+
+  // Remove a row by moving the last row into it; returns the entity that
+  // moved (invalid if the removed row was the last)
+  Entity swapRemove(std::size_t row);
+
+  void clear();
+
+  // Snapshot rows and columns (restoring keeps the mask, fails on mismatch)
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
+private:
+  template <typename C> std::vector<C> &columnVector();
+
+  ComponentMask m_mask;
+  std::vector<Entity> m_entities;
+  std::vector<Transform> m_transforms;
+  std::vector<Velocity> m_velocities;
+  std::vector<Collider> m_colliders;
+  std::vector<Renderable> m_renderables;
+  std::vector<Lifetime> m_lifetimes;
+};
+
+template <> inline std::vector<Transform> &Archetype::columnVector() {
+  return m_transforms;
+}
+template <> inline std::vector<Velocity> &Archetype::columnVector() {
+  return m_velocities;
+}
+template <> inline std::vector<Collider> &Archetype::columnVector() {
+  return m_colliders;
+}
+template <> inline std::vector<Renderable> &Archetype::columnVector() {
+  return m_renderables;
+}
+template <> inline std::vector<Lifetime> &Archetype::columnVector() {
+  return m_lifetimes;
+}
+
+/**
+ * Archetype-based entity storage
+ * Systems iterate whole columns per archetype with each<...>(), so a pass
+ * over N entities is a linear walk of packed arrays with no virtual calls
+ */
+class EntityWorld {
+public:
+  // Create an entity with default-initialized components
+  Entity create(ComponentMask mask);
+  template <typename... C> Entity create() {
+    return create(componentMask<C...>());
+  }
+
+  // Remove immediately (invalidates column pointers of its archetype)
+  void destroy(Entity entity);
+
+  // Remove later, safe while iterating; applied by flushDestroyed()
+  void destroyDeferred(Entity entity) { m_pendingDestroy.push_back(entity); }
+  void flushDestroyed();
+
+  bool isAlive(Entity entity) const;
+
+  // Component of an entity, nullptr if dead or absent
+  template <typename C> C *get(Entity entity);
+  template <typename C> const C *get(Entity entity) const {
+    return const_cast<EntityWorld *>(this)->get<C>(entity);
+  }
+
+  // Preallocate room for count entities of an archetype
+  void reserve(ComponentMask mask, std::size_t count);
+
+  // Call fn(count, entities, columns...) once per archetype that has all of
+  // the requested components
+  template <typename... C, typename Fn> void each(Fn &&fn) {
+    constexpr ComponentMask required = componentMask<C...>();
+    for (Archetype &archetype : m_archetypes) {
+      if ((archetype.getMask() & required) != required || archetype.size() == 0)
+        continue;
+      fn(archetype.size(), archetype.entities(), archetype.column<C>()...);
+    }
+  }
+  template <typename... C, typename Fn> void each(Fn &&fn) const {
+    constexpr ComponentMask required = componentMask<C...>();
+    for (const Archetype &archetype : m_archetypes) {
+      if ((archetype.getMask() & required) != required || archetype.size() == 0)
+        continue;
+      fn(archetype.size(), archetype.entities(),
+         archetype.template column<C>()...);
+    }
+  }
+
+  std::size_t size() const { return m_liveCount; }
+  std::size_t getArchetypeCount() const { return m_archetypes.size(); }
+
+  // Destroy every entity (archetype storage is kept for reuse)
+  void clear();
+
+  // Snapshot every entity, handle and archetype (call between ticks, with no
+  // deferred destroys pending); restoring reuses archetype storage
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
+private:
+  struct Record {
+    std::uint32_t archetype = 0;
+    std::uint32_t row = 0;
+    std::uint32_t generation = 0;
+    bool alive = false;
+  };
+
+  Archetype &archetypeFor(ComponentMask mask, std::uint32_t &index);
+
+  std::vector<Archetype> m_archetypes;
+  std::vector<Record> m_records; // Indexed by Entity::index
+  std::vector<std::uint32_t> m_freeIndices;
+  std::vector<Entity> m_pendingDestroy;
+  std::size_t m_liveCount = 0;
+};
+
+template <typename C> C *EntityWorld::get(Entity entity) {
+  if (!isAlive(entity))
+    return nullptr;
+  const Record &record = m_records[entity.index];
+  C *column = m_archetypes[record.archetype].column<C>();
+  return column ? column + record.row : nullptr;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+/**
+ * Vehicle handling parameters, loaded at runtime so tuning needs no rebuild
+ * Friction values are per tick at the simulation tick rate
+ */
+struct PhysicsProfile {
+  float maxSpeed = 600.0f;
+  float acceleration = 800.0f;
+  float brakeForce = 600.0f;
+  float reverseFactor = 0.4f;  // Reverse acceleration as a fraction
+  float friction = 0.98f;      // Forward speed kept per tick
+  float driftFriction = 0.92f; // Forward speed kept per tick when drifting
+  float grip = 0.9f;           // Lateral speed kept per tick
+  float driftSlide = 0.85f;    // Lateral speed kept per tick when drifting
+  float turnSpeed = 180.0f;    // Degrees per second
+  float driftTurnMultiplier = 1.5f;
+  float minSpeedToTurn = 50.0f;
+  float driftBuildRate = 2.0f; // Drift amount gained per second
+  float stopSpeed = 5.0f;      // Below this the car stops outright
+};
+
+// Set one parameter by its file key; returns false for unknown keys
+bool setPhysicsValue(PhysicsProfile &profile, const std::string &key,
+                     float value);
+
+// Load "key = value" lines over the given profile (unknown keys are
+// ignored). Returns false if the file cannot be opened.
+bool loadPhysicsProfile(const std::filesystem::path &path,
+                        PhysicsProfile &profile);
+
+/**
+ * Profile converted to a simulation scalar once, not every tick
+ */
+template <typename T> struct PhysicsConstants {
+  T maxSpeed;
+  T acceleration;
+  T brakeForce;
+  T reverseAcceleration;
+  T friction;
+  T driftFriction;
+  T grip;
+  T driftSlide;
+  T turnSpeed;
+  T driftTurnSpeed;
+  T minSpeedToTurn;
+  T minSpeedToDrift;
+  T driftBuildRate;
+  T stopSpeed;
+
+  explicit PhysicsConstants(const PhysicsProfile &p)
+      : maxSpeed(T(p.maxSpeed)), acceleration(T(p.acceleration)),
+        brakeForce(T(p.brakeForce)),
+        reverseAcceleration(T(p.acceleration * p.reverseFactor)),
+        friction(T(p.friction)), driftFriction(T(p.driftFriction)),
+        grip(T(p.grip)), driftSlide(T(p.driftSlide)),
+        turnSpeed(T(p.turnSpeed)),
+        driftTurnSpeed(T(p.turnSpeed * p.driftTurnMultiplier)),
+        minSpeedToTurn(T(p.minSpeedToTurn)),
+        minSpeedToDrift(T(p.minSpeedToTurn * 2.0f)),
+        driftBuildRate(T(p.driftBuildRate)), stopSpeed(T(p.stopSpeed)) {}
+};
@@ -1,63 +1,92 @@
 #pragma once
 
-#include "core/InputManager.hpp"
+#include "core/ControlInput.hpp"
+#include "core/StateStream.hpp"
+#include "entities/PhysicsProfile.hpp"
+#include "math/Vec2.hpp"
 #include <SFML/Graphics.hpp>
 
 
 /**
  * Player vehicle with physics-based movement
  * Features: acceleration, friction, rotation steering, drift
+ * Acts as the controller of the player entity; the simulation copies its
+ * state into the entity's components after each update
+ * Physics state is templated on the scalar type (float or Fixed); handling
+ * comes from a PhysicsProfile that can be swapped at runtime
  */
-class Player {
+template <typename T> class BasicPlayer {
 public:
-  Player();
+  explicit BasicPlayer(const PhysicsProfile &profile = PhysicsProfile());
 
   // Core update
-  void update(float deltaTime, const InputManager &input);
-  void render(sf::RenderWindow &window);
-
-  // Getters
-  sf::Vector2f getPosition() const { return m_position; }
-  sf::Vector2f getVelocity() const { return m_velocity; }
-  float getSpeed() const;
-  float getRotation() const { return m_rotation; }
+  void update(T deltaTime, const ControlInput &input);
+
+  // Replace handling parameters (takes effect on the next update)
+  void setProfile(const PhysicsProfile &profile) {
+    m_physics = PhysicsConstants<T>(profile);
+  }
+
+  // Getters (presentation, always float)
+  sf::Vector2f getPosition() const { return m_position.toSf(); }
+  sf::Vector2f getVelocity() const { return m_velocity.toSf(); }
+  float getSpeed() const { return scalar::toFloat(getSimSpeed()); }
+  float getRotation() const { return scalar::toFloat(m_rotation); }
+  sf::Vector2f getHeading() const { return m_heading.toSf(); }
   bool isDrifting() const { return m_isDrifting; }
-  float getDriftAmount() const { return m_driftAmount; }
+  float getDriftAmount() const { return scalar::toFloat(m_driftAmount); }
+  sf::Color getFillColor() const { return m_fillColor; }
+
+  // Getters (simulation scalar, for deterministic consumers)
+  const Vec2<T> &getSimPosition() const { return m_position; }
+  T getSimRotation() const { return m_rotation; }
+  const Vec2<T> &getSimHeading() const { return m_heading; }
+  T getSimSpeed() const { return m_velocity.length(); }
+  T getSimDriftAmount() const { return m_driftAmount; }
 
   // Position control
-  void setPosition(const sf::Vector2f &pos) { m_position = pos; }
+  void setPosition(const sf::Vector2f &pos) {
+    m_position = Vec2<T>::fromSf(pos);
+  }
   void reset();
 
+  // Gameplay events
+  void applyImpact(T keepFraction); // Lose speed and grip after a hit
+  void applyBoost(T impulse);       // Push along the heading
+
+  // Snapshot motion and drift state (the handling profile is not included)
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
 private:
   // Physics calculations
-  void applyInput(const InputManager &input, float deltaTime);
-  void applyPhysics(float deltaTime);
+  void applyInput(const ControlInput &input, T deltaTime);
+  void applyPhysics(T deltaTime);
+  void updateHeading();
   void updateVisuals();
 
   // Position & movement
-  sf::Vector2f m_position;
-  sf::Vector2f m_velocity;
-  float m_rotation; // degrees
-  float m_angularVelocity;
+  Vec2<T> m_position;
+  Vec2<T> m_velocity;
+  T m_rotation;      // degrees
+  Vec2<T> m_heading; // Unit forward vector, refreshed when rotation changes
+  T m_angularVelocity;
 
   // Drift state
   bool m_isDrifting;
-  float m_driftAmount;    // 0.0 to 1.0, how much we're sliding
-  float m_driftDirection; // -1 left, 1 right, 0 none
+  T m_driftAmount;    // 0.0 to 1.0, how much we're sliding
+  T m_driftDirection; // -1 left, 1 right, 0 none
 
   // Visual representation
-  sf::ConvexShape m_shape;
+  sf::Color m_fillColor;
   sf::Color m_baseColor;
   sf::Color m_glowColor;
 
-  // Physics constants
-  static constexpr float MAX_SPEED = 600.0f;
-  static constexpr float ACCELERATION = 800.0f;
-  static constexpr float BRAKE_FORCE = 600.0f;
-  static constexpr float FRICTION = 0.98f;       // Normal friction
-  static constexpr float DRIFT_FRICTION = 0.92f; // Less grip when drifting
-  static constexpr float TURN_SPEED = 180.0f;    // Degrees per second
-  static constexpr float DRIFT_TURN_MULTIPLIER = 1.5f;
-  static constexpr float DRIFT_SLIDE_FACTOR = 0.85f;
-  static constexpr float MIN_SPEED_TO_TURN = 50.0f;
+  // Handling parameters
+  PhysicsConstants<T> m_physics;
 };
+
+extern template class BasicPlayer<float>;
+extern template class BasicPlayer<Fixed>;
+
+using Player = BasicPlayer<SimScalar>;
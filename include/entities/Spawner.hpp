@@ -0,0 +1,87 @@
+#pragma once
+
+#include "entities/EntityWorld.hpp"
+#include "math/Random.hpp"
+#include <cstdint>
+
+/**
+ * Spawns obstacles and pickups ahead of the player, scaled by difficulty,
+ * and despawns whatever the player has left behind
+ * Every kind has a fixed capacity reserved up front, so the entity count is
+ * bounded and spawning never allocates during play
+ */
+class Spawner {
+public:
+  static constexpr std::size_t MAX_OBSTACLES = 96;
+  static constexpr std::size_t MAX_BOOST_PICKUPS = 8;
+  static constexpr std::size_t MAX_COMBO_PICKUPS = 8;
+  static constexpr std::size_t CAPACITY =
+      MAX_OBSTACLES + MAX_BOOST_PICKUPS + MAX_COMBO_PICKUPS;
+
+  explicit Spawner(std::uint32_t seed = 0);
+
+  // Reserve pool storage in the world (call once before play)
+  void reserve(EntityWorld &world);
+
+  // Spawn and despawn around the player; difficulty is 0.0 to 2.0
+  void update(EntityWorld &world, SimScalar deltaTime, SimScalar difficulty,
+              const Vec2<SimScalar> &playerPosition,
+              const Vec2<SimScalar> &playerHeading);
+
+  // Destroy everything this spawner created
+  void clear(EntityWorld &world);
+
+  std::size_t getObstacleCount() const { return m_obstacleCount; }
+  std::size_t getPickupCount() const {
+    return m_boostCount + m_comboCount;
+  }
+
+  // Snapshot generator, timers and pool counts (entities live in the world)
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
+  // Generator state only, so a restart can keep drawing fresh layouts
+  std::uint64_t getRngState() const { return m_rng.getState(); }
+  void setRngState(std::uint64_t state) { m_rng.setState(state); }
+
+private:
+  void despawnPassed(EntityWorld &world,
+                     const Vec2<SimScalar> &playerPosition);
+  void spawnObstacle(EntityWorld &world, SimScalar difficulty,
+                     const Vec2<SimScalar> &origin,
+                     const Vec2<SimScalar> &heading);
+  void spawnPickup(EntityWorld &world, std::uint32_t layer,
+                   const Vec2<SimScalar> &origin,
+                   const Vec2<SimScalar> &heading);
+
+  // Point ahead of the player, outside the visible area
+  Vec2<SimScalar> spawnPoint(const Vec2<SimScalar> &origin,
+                             const Vec2<SimScalar> &heading);
+
+  Pcg32 m_rng;
+  SimScalar m_boostTimer;
+  SimScalar m_comboTimer;
+
+  std::size_t m_obstacleCount;
+  std::size_t m_boostCount;
+  std::size_t m_comboCount;
+
+  // Density and rates by difficulty (value at 0 plus slope per level)
+  static constexpr float BASE_OBSTACLES = 12.0f;
+  static constexpr float OBSTACLES_PER_DIFFICULTY = 30.0f;
+  static constexpr float BASE_BOOST_INTERVAL = 6.0f; // Seconds
+  static constexpr float BOOST_INTERVAL_PER_DIFFICULTY = -1.5f;
+  static constexpr float BASE_COMBO_INTERVAL = 9.0f;
+  static constexpr float COMBO_INTERVAL_PER_DIFFICULTY = -2.5f;
+  static constexpr float OBSTACLE_SPEED_PER_DIFFICULTY = 60.0f;
+
+  // Bounded work per tick regardless of difficulty
+  static constexpr int MAX_SPAWNS_PER_TICK = 2;
+
+  // Geometry (pixels)
+  static constexpr float SPAWN_DISTANCE_MIN = 800.0f;
+  static constexpr float SPAWN_DISTANCE_MAX = 1000.0f;
+  static constexpr float SPAWN_LATERAL = 700.0f;
+  static constexpr float DESPAWN_RADIUS = 1200.0f;
+  static constexpr float PICKUP_LIFETIME = 15.0f;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "entities/EntityWorld.hpp"
+#include <vector>
+
+/**
+ * World systems: each is one linear pass over the matching archetypes
+ */
+namespace systems {
+
+// Transform += Velocity * dt
+void integrateMotion(EntityWorld &world, SimScalar deltaTime);
+
+// Count down Lifetime and destroy expired entities
+void updateLifetimes(EntityWorld &world, SimScalar deltaTime);
+
+/**
+ * Overlap between a subject and another entity
+ */
+struct Contact {
+  Entity entity;
+  std::uint32_t layer;   // Layer of the other entity
+  sf::Vector2f position; // Position of the other entity
+  sf::Color color;
+};
+
+// Find entities overlapping subject on the layers in its Collider mask.
+// Writes at most maxContacts, returns how many were written.
+std::size_t findContacts(const EntityWorld &world, Entity subject,
+                         Contact *contacts, std::size_t maxContacts);
+
+// Collect every Transform + Renderable into draw instances (reuses capacity)
+void buildRenderList(const EntityWorld &world,
+                     std::vector<RenderInstance> &instances);
+
+} // namespace systems
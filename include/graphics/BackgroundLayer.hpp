@@ -0,0 +1,53 @@
+#pragma once
+
+#include "graphics/TileAtlas.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Neon backdrop behind the world, rasterized once per tile
+ * The decoration (grid lines and glints, derived from each tile's
+ * coordinates) is drawn into a TileAtlas that scrolls with the camera: a
+ * tile is only rasterized when it scrolls into its slot or its area is
+ * invalidated, and each frame composites every visible tile in a single
+ * textured draw.
+ */
+class BackgroundLayer {
+public:
+  static constexpr int TILE_SIZE = 512; // World pixels, drawn 1:1
+
+  BackgroundLayer();
+
+  // Allocate the atlas for a view of this size (false if no render
+  // texture is available; the caller keeps its flat clear)
+  bool init(sf::Vector2f viewSize);
+  bool isAvailable() const { return m_atlas.isAvailable(); }
+
+  // Redraw tiles overlapping a world area (or all) before they are next seen
+  void invalidate();
+  void invalidate(const sf::FloatRect &area);
+
+  // Draw the tiles under view, rasterizing new or invalidated ones first
+  void render(sf::RenderTarget &target, const sf::View &view);
+
+  // Tiles rasterized so far (each is a full tile redraw)
+  std::uint64_t getTilesDrawn() const { return m_tilesDrawn; }
+
+  // Deep purple under the decoration (and the flat fallback)
+  static constexpr sf::Color BACKGROUND_COLOR = sf::Color(15, 5, 25);
+
+private:
+  // Rasterize one tile into its slot of the atlas
+  void drawTile(sf::Vector2i tile);
+
+  TileAtlas m_atlas;
+  std::vector<sf::Vertex> m_tileVertices; // Decoration of one tile
+  std::vector<sf::Vertex> m_quads;        // Visible tiles this frame
+  std::uint64_t m_tilesDrawn;
+
+  static constexpr int MINOR_SPACING = 64;  // Grid lines
+  static constexpr int MAJOR_EVERY = 4;     // Minor lines per major line
+  static constexpr int GLINTS_PER_TILE = 5; // Sparse neon points
+};
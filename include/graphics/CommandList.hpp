@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Pipeline state a batch is drawn with
+ */
+struct DrawState {
+  const sf::Texture *texture = nullptr;
+  sf::BlendMode blendMode = sf::BlendAlpha;
+
+  bool operator==(const DrawState &other) const {
+    return texture == other.texture && blendMode == other.blendMode;
+  }
+  bool operator!=(const DrawState &other) const { return !(*this == other); }
+};
+
+/**
+ * Draw submissions for one view, batched for a RenderBackend
+ * Consecutive submissions with the same texture and blend mode are merged
+ * into one triangle-list batch, so a backend issues one draw per state
+ * change rather than per submission. Draw order is kept: batches are never
+ * reordered, which would change how blended geometry overlaps.
+ * A triangle list submitted on its own is referenced, not copied, and must
+ * stay valid until the list is drawn; strips, fans and merged batches are
+ * copied into the list's own storage, which is reused across frames.
+ * Large lists (particles) are not copied to merge, as one extra draw call
+ * is cheaper.
+ */
+class CommandList {
+public:
+  /**
+   * One draw call's worth of triangles
+   */
+  struct Batch {
+    DrawState state;
+    const sf::Vertex *external; // Caller's vertices, or null when owned
+    std::size_t first;          // Into the list's storage when owned
+    std::size_t count;
+  };
+
+  void submit(const sf::Vertex *vertices, std::size_t count,
+              sf::PrimitiveType type, const DrawState &state = DrawState());
+
+  void clear();
+
+  const std::vector<Batch> &getBatches() const { return m_batches; }
+  const sf::Vertex *vertices(const Batch &batch) const {
+    return batch.external ? batch.external : m_vertices.data() + batch.first;
+  }
+
+  // Submissions since the last clear (batches are the draw calls)
+  std::size_t getSubmissionCount() const { return m_submissions; }
+
+private:
+  // Room for count more owned vertices (growth is expected, not a leak)
+  void reserve(std::size_t count);
+  void addBatch(const Batch &batch);
+  void appendTriangles(const sf::Vertex *vertices, std::size_t count,
+                       sf::PrimitiveType type);
+  static std::size_t triangleVertexCount(std::size_t count,
+                                         sf::PrimitiveType type);
+
+  // Largest caller list copied to merge it with a neighbor
+  static constexpr std::size_t MAX_MERGE_VERTICES = 4096;
+
+  std::vector<sf::Vertex> m_vertices;
+  std::vector<Batch> m_batches;
+  std::size_t m_submissions = 0;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/StateStream.hpp"
+#include "graphics/CommandList.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Drift trail drawn as one continuous ribbon
+ * Keeps a ring of the car's recent rear-axle positions and turns them into
+ * a triangle strip that narrows and fades with age, tinted cyan to magenta
+ * by drift amount. Two vertices per sample replace the dozens of
+ * overlapping particle quads a drift used to leave behind.
+ */
+class DriftRibbon {
+public:
+  static constexpr std::size_t CAPACITY = 64; // Samples, one per tick
+  // Strip vertices one ribbon can produce (two per sample, plus two
+  // degenerate vertices to join each segment of at least two samples)
+  static constexpr std::size_t MAX_VERTICES = CAPACITY * 3;
+
+  DriftRibbon();
+
+  // Age the trail and drop samples older than the lifetime
+  void update(float deltaTime);
+
+  // Extend the trail behind a drifting car (rotation in degrees)
+  void addSample(const sf::Vector2f &carPosition, float rotation,
+                 float driftAmount);
+
+  // End the current segment; the next sample starts a new one
+  void breakTrail() { m_broken = true; }
+
+  void clear();
+
+  // Append the ribbon to a triangle strip of count vertices (sized on first
+  // use, reused afterwards) and return the new count. Segments, and further
+  // ribbons, are joined with degenerate triangles so one draw covers all.
+  std::size_t appendVertices(std::vector<sf::Vertex> &strip,
+                             std::size_t count) const;
+
+  // Submit a strip produced by appendVertices
+  static void render(CommandList &commands,
+                     const std::vector<sf::Vertex> &strip,
+                     std::size_t vertexCount);
+
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
+  std::size_t getSampleCount() const { return m_count; }
+
+private:
+  struct Sample {
+    sf::Vector2f position; // Rear axle
+    float driftAmount;
+    float time;                // Trail clock when taken
+    std::uint8_t segmentStart; // First sample after a break
+  };
+
+  const Sample &sample(std::size_t index) const {
+    return m_samples[(m_head + index) % CAPACITY];
+  }
+
+  std::array<Sample, CAPACITY> m_samples;
+  std::size_t m_head;  // Oldest sample
+  std::size_t m_count;
+  float m_time;
+  bool m_broken;
+
+  static constexpr float LIFETIME = 0.6f;    // Seconds a sample stays
+  static constexpr float REAR_AXLE = 10.0f;  // Behind the car's origin
+  static constexpr float HALF_WIDTH_MIN = 2.5f;
+  static constexpr float HALF_WIDTH_MAX = 8.0f; // At full drift
+  static constexpr float MAX_ALPHA = 200.0f;
+};
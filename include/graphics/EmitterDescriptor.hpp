@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * Optional particle behaviors; each emitter's particles run an update and
+ * vertex kernel compiled for exactly the features it enables
+ */
+namespace ParticleFeature {
+enum : unsigned {
+  Drag = 1u << 0,     // Velocity decays over time
+  Shrink = 1u << 1,   // Size follows a curve over life
+  Fade = 1u << 2,     // Alpha follows remaining life
+  Gradient = 1u << 3, // Color is tinted by a gradient over life
+};
+constexpr unsigned COUNT = 4;
+constexpr unsigned COMBINATIONS = 1u << COUNT;
+} // namespace ParticleFeature
+
+/**
+ * How readily an effect is thinned out when the frame budget is tight
+ */
+enum class EffectPriority : std::uint8_t {
+  Essential, // Gameplay feedback (collisions): never thinned
+  Normal,    // Scaled with the budget
+  Cosmetic,  // Scaled harder, and first to hit the live particle cap
+};
+
+/**
+ * Data-driven description of one particle effect
+ */
+struct EmitterDescriptor {
+  std::string name;
+
+  // Spawning
+  float rateMin = 0.0f; // Particles per second at intensity 0 (continuous)
+  float rateMax = 0.0f; // Particles per second at intensity 1 (continuous)
+  int burstMin = 0;     // Particles per burst
+  int burstMax = 0;
+  float spread = 0.0f; // Cone width in degrees around the emit direction
+  float speedMin = 0.0f;
+  float speedMax = 0.0f;
+  float inheritSpeed = 0.0f; // Fraction of the source speed added on launch
+  float offset = 0.0f;       // Spawn distance along the emit direction
+
+  // Lifetime
+  float lifetimeMin = 0.5f;
+  float lifetimeMax = 0.5f;
+
+  // Color: spawn color is picked between low and high, by intensity and
+  // randomness, then optionally tinted by the gradient over life
+  sf::Color colorLow = sf::Color::White;
+  sf::Color colorHigh = sf::Color::White;
+  float colorIntensity = 0.0f; // 0 = purely random pick, 1 = by intensity
+  std::vector<sf::Color> gradient; // Evenly spaced keys, birth to death
+  bool fade = true;
+
+  // Motion and size
+  float drag = 1.0f; // Fraction of velocity kept per second (1 = no drag)
+  float sizeMin = 4.0f;
+  float sizeMax = 4.0f;
+  float sizeIntensity = 0.0f; // Extra size scale at intensity 1
+  float sizeEnd = 1.0f;       // Size scale at end of life (1 = no shrink)
+
+  EffectPriority priority = EffectPriority::Normal;
+
+  // Feature mask derived from the parameters above
+  unsigned features() const;
+};
+
+// Built-in effects, used when no config file is available
+std::vector<EmitterDescriptor> defaultEmitterDescriptors();
+
+// Load descriptors from an INI-style file ([name] sections, key = value).
+// Returns false if the file cannot be opened.
+bool loadEmitterDescriptors(const std::filesystem::path &path,
+                            std::vector<EmitterDescriptor> &descriptors);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "entities/Components.hpp"
+#include "graphics/CommandList.hpp"
+#include "graphics/VehicleRenderer.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/**
+ * Draws world entities: simple shapes are batched into one triangle list,
+ * vehicles are drawn on top with their outlined shape (all in the same
+ * batch, as none are textured)
+ */
+class EntityRenderer {
+public:
+  void render(CommandList &commands,
+              const std::vector<RenderInstance> &instances);
+
+private:
+  void appendShape(const RenderInstance &instance);
+
+  VehicleRenderer m_vehicle;
+  std::vector<sf::Vertex> m_vertices; // Reused every frame
+
+  static constexpr int CIRCLE_SEGMENTS = 12;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "core/SpscRing.hpp"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class CaptureReadback;
+class CaptureWriter;
+
+/**
+ * Output of a capture
+ */
+enum class CaptureFormat {
+  Y4m,          // YUV4MPEG2 video, 4:2:0 (plays in mpv/VLC, ffmpeg input)
+  Raw,          // Headerless RGBA frames, top row first
+  ImageSequence // One PNG per frame in a directory (may drop at 60 fps)
+};
+
+/**
+ * Capture settings
+ */
+struct CaptureConfig {
+  std::filesystem::path path; // Video file, or directory for images
+  CaptureFormat format = CaptureFormat::Y4m;
+  unsigned int frameRate = 60;
+  std::size_t bufferCount = 8; // Frames queued for the encoder at most
+
+  // Format implied by the path: .y4m, .rgba/.raw, otherwise images
+  static CaptureFormat formatFor(const std::filesystem::path &path);
+};
+
+/**
+ * Gameplay video capture that never stalls the frame
+ * Each captured frame is read back from the render target into a
+ * GPU-side pixel buffer; the copy completes in the background and is
+ * collected a few frames later into one of a fixed pool of frame buffers,
+ * which a writer thread encodes and hands back. Nothing is allocated per
+ * frame, and when the writer falls behind frames are dropped and counted
+ * rather than waited for. Works with a window or an offscreen
+ * sf::RenderTexture (headless), from the thread that draws to it.
+ */
+class FrameCapture {
+public:
+  static constexpr std::size_t MAX_BUFFERS = 16;
+
+  struct Stats {
+    std::uint64_t captured = 0; // Frames read back
+    std::uint64_t written = 0;  // Frames encoded to the output
+    std::uint64_t dropped = 0;  // No free buffer, wrong size or write error
+    double captureMs = 0.0;     // Render thread time spent in capture()
+    double maxCaptureMs = 0.0;
+  };
+
+  FrameCapture();
+  ~FrameCapture();
+
+  FrameCapture(const FrameCapture &) = delete;
+  FrameCapture &operator=(const FrameCapture &) = delete;
+
+  // Open the output and start the writer for frames of the given size
+  bool start(const CaptureConfig &config, sf::Vector2u frameSize);
+
+  // Read back what has been drawn to target this frame (call before
+  // display(); target's size must match the capture)
+  void capture(sf::RenderTarget &target);
+
+  // Collect readbacks still in flight, drain the writer and close the
+  // output (works after the target is gone: SFML contexts share buffers)
+  void stop();
+
+  bool isRunning() const { return m_running.load(std::memory_order_relaxed); }
+  Stats getStats() const; // Thread calling capture()
+  const CaptureConfig &getConfig() const { return m_config; }
+
+private:
+  static constexpr std::uint32_t NO_BUFFER = 0xFFFFFFFFu;
+
+  // A free frame buffer, or NO_BUFFER (the frame is dropped)
+  std::uint32_t acquireBuffer();
+  // Move the oldest finished readback to the writer
+  void collect();
+  void writerLoop();
+  void drainReady();
+
+  CaptureConfig m_config;
+  sf::Vector2u m_size;
+  std::vector<std::vector<std::uint8_t>> m_buffers; // RGBA, bottom row first
+  SpscRing<std::uint32_t, MAX_BUFFERS> m_free;      // Writer -> render
+  SpscRing<std::uint32_t, MAX_BUFFERS> m_ready;     // Render -> writer
+  std::unique_ptr<CaptureReadback> m_readback; // Created on the GL thread
+  std::unique_ptr<CaptureWriter> m_writer;
+  std::thread m_thread;
+  std::atomic<bool> m_running{false};
+
+  // Render thread counters (the writer's are atomic)
+  std::uint64_t m_captured = 0;
+  std::uint64_t m_renderDropped = 0;
+  double m_captureMs = 0.0;
+  double m_maxCaptureMs = 0.0;
+  std::atomic<std::uint64_t> m_written{0};
+  std::atomic<std::uint64_t> m_writeFailed{0};
+
+  static constexpr int WRITER_POLL_MS = 2;
+};
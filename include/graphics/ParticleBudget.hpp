@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Frame-time controller for particle density
+ * Fed the measured cost of each frame, it estimates what one particle costs
+ * and how many particles fit in what is left of the target frame time, then
+ * eases the budget (0..1 emission scale) toward that: quickly down when
+ * frames run long, slowly back up once they recover, so density degrades
+ * smoothly instead of frames dropping.
+ */
+class ParticleBudget {
+public:
+  /**
+   * One frame's measurements (milliseconds)
+   */
+  struct FrameCost {
+    float frameMs = 0.0f;        // Work on the busiest thread, not vsync waits
+    float particleMs = 0.0f;     // Part of frameMs spent on particles
+    std::size_t liveParticles = 0;
+  };
+
+  explicit ParticleBudget(float targetFrameMs);
+
+  // Record a frame and return the new budget
+  float update(const FrameCost &cost);
+
+  float getBudget() const { return m_budget; }
+  float getSmoothedFrameMs() const { return m_frameMs; }
+
+private:
+  float m_targetMs;
+
+  // Running averages of the measurements
+  float m_frameMs;
+  float m_particleMs;
+  float m_msPerParticle;
+
+  float m_budget;
+
+  static constexpr float SMOOTHING = 0.1f;   // Weight of the newest frame
+  static constexpr float HEADROOM = 0.9f;    // Share of the target to fill
+  static constexpr float DECREASE = 0.25f;   // Step toward a lower budget
+  static constexpr float RECOVER = 0.02f;    // Step toward a higher budget
+  static constexpr float MIN_BUDGET = 0.1f;
+  static constexpr std::size_t MIN_SAMPLE_PARTICLES = 50; // For the estimate
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Individual particle with position, velocity, and lifetime
+ * Color and size are the spawn values; fade, gradient and size curve are
+ * applied when vertices are generated
+ */
+struct Particle {
+  sf::Vector2f position;
+  sf::Vector2f velocity;
+  sf::Color color;
+  float lifetime;    // Remaining time
+  float maxLifetime; // Original lifetime for alpha calculation
+  float size;
+};
+
+/**
+ * Quantized particle for very large pools (16 bytes instead of 32)
+ * Positions are fixed point relative to the effect's emitter origin,
+ * velocities half precision, and the spawn color an index into the
+ * effect's palette. Life is the remaining fraction, counted down at a
+ * rate set from the lifetime at spawn.
+ */
+struct CompactParticle {
+  static constexpr float POSITION_SCALE = 16.0f; // Units per pixel
+  static constexpr float SIZE_SCALE = 8.0f;      // Units per pixel
+  static constexpr float DECAY_SCALE = 16.0f;    // Life units per decay unit
+  static constexpr std::uint16_t FULL_LIFE = 0xFFFF;
+
+  std::int16_t x, y;     // From the emitter origin (+-2048 px)
+  std::uint16_t vx, vy;  // Half precision, px/s
+  std::uint16_t life;    // Remaining fraction of FULL_LIFE
+  std::uint16_t decay;   // Life lost per second, in DECAY_SCALE units
+  std::uint8_t palette;  // Spawn color
+  std::uint8_t size;     // Spawn size
+  std::uint16_t padding; // Keeps the size a power of two
+};
+
+// What the pool stores: NEONDRIFT_COMPACT_PARTICLES trades precision for
+// half the memory and bandwidth
+#ifdef NEONDRIFT_COMPACT_PARTICLES
+using StoredParticle = CompactParticle;
+#else
+using StoredParticle = Particle;
+#endif
+
+/**
+ * Fixed-size blocks of particle storage shared by all effects
+ * Chunks are allocated up front or on demand up to a hard limit and are
+ * never freed or moved while the pool is configured, so memory use is
+ * bounded and particle addresses stay stable. Released chunks are recycled
+ * oldest first.
+ */
+class ParticleChunkPool {
+public:
+  static constexpr std::size_t CHUNK_SIZE = 128; // Particles
+
+  ParticleChunkPool() : m_maxChunks(0), m_nextFree(0), m_freeCount(0) {}
+
+  // Drop all chunks and allow up to maxChunks, allocating preallocate of
+  // them now (only while no chunk is in use)
+  void configure(std::size_t maxChunks, std::size_t preallocate);
+
+  // A free chunk, allocating one if under the limit; nullptr when exhausted
+  StoredParticle *acquire();
+  void release(StoredParticle *chunk);
+
+  std::size_t getAllocatedChunks() const { return m_chunks.size(); }
+  std::size_t getMaxChunks() const { return m_maxChunks; }
+
+  // Chunks needed to hold count particles
+  static std::size_t chunksFor(std::size_t count) {
+    return (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  }
+
+private:
+  std::vector<std::unique_ptr<StoredParticle[]>> m_chunks; // Up to the limit
+  std::vector<StoredParticle *> m_free; // Ring of released chunks
+  std::size_t m_maxChunks;
+  std::size_t m_nextFree;
+  std::size_t m_freeCount;
+};
+
+/**
+ * Particles of one effect, oldest first, in chunks borrowed from a pool
+ * Dropping the oldest particles is O(1) and hands emptied chunks back, so
+ * one effect's storage is available to the others once it dies down.
+ */
+class ParticleQueue {
+public:
+  /**
+   * Walks the queue in order (oldest first)
+   */
+  template <typename P> class BasicCursor {
+  public:
+    P &operator*() const { return *m_particle; }
+    void advance() {
+      if (++m_particle == m_chunkEnd && ++m_chunk < m_chunkCount) {
+        m_particle = m_chunks[m_chunk];
+        m_chunkEnd = m_particle + ParticleChunkPool::CHUNK_SIZE;
+      }
+    }
+
+  private:
+    friend class ParticleQueue;
+    BasicCursor(StoredParticle *const *chunks, std::size_t chunkCount,
+                std::size_t head)
+        : m_chunks(chunks), m_chunkCount(chunkCount), m_chunk(0),
+          m_particle(chunkCount ? chunks[0] + head : nullptr),
+          m_chunkEnd(chunkCount ? chunks[0] + ParticleChunkPool::CHUNK_SIZE
+                                : nullptr) {}
+
+    StoredParticle *const *m_chunks;
+    std::size_t m_chunkCount;
+    std::size_t m_chunk;
+    P *m_particle;
+    P *m_chunkEnd;
+  };
+  using Cursor = BasicCursor<StoredParticle>;
+  using ConstCursor = BasicCursor<const StoredParticle>;
+
+  ParticleQueue() : m_head(0), m_size(0) {}
+
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  // Size the chunk list so it never reallocates during play
+  void reserveChunks(std::size_t count) { m_chunks.reserve(count); }
+
+  // Append a particle; false when the pool has no chunk to give
+  bool push(ParticleChunkPool &pool, const StoredParticle &particle);
+
+  // Forget the count oldest particles
+  void dropOldest(ParticleChunkPool &pool, std::size_t count);
+
+  // Keep only the count oldest particles (after compacting in place)
+  void truncate(ParticleChunkPool &pool, std::size_t count);
+
+  void clear(ParticleChunkPool &pool) { truncate(pool, 0); }
+
+  Cursor begin() { return Cursor(m_chunks.data(), m_chunks.size(), m_head); }
+  ConstCursor begin() const {
+    return ConstCursor(m_chunks.data(), m_chunks.size(), m_head);
+  }
+
+private:
+  std::vector<StoredParticle *> m_chunks; // In order, oldest first
+  std::size_t m_head; // Oldest particle's slot in m_chunks[0]
+  std::size_t m_size;
+};
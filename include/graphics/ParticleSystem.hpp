@@ -1,36 +1,88 @@
 #pragma once
 
+#include "core/StateStream.hpp"
+#include "graphics/CommandList.hpp"
+#include "graphics/EmitterDescriptor.hpp"
+#include "graphics/ParticlePool.hpp"
+#include "math/Random.hpp"
 #include <SFML/Graphics.hpp>
 #include <cstdint>
+#include <filesystem>
+#include <string>
 #include <vector>
 
+/**
+ * What spawning does once the live particle cap is reached
+ */
+enum class PoolPolicy : std::uint8_t {
+  Drop,        // Skip the new particle
+  EvictOldest, // Replace the oldest particle of the least important effect
+  Grow,        // Add storage chunks up to a hard limit, then evict
+};
 
 /**
- * Individual particle with position, velocity, and lifetime
+ * Emission parameters supplied by gameplay code
  */
-struct Particle {
+struct EmitParams {
   sf::Vector2f position;
-  sf::Vector2f velocity;
-  sf::Color color;
-  float lifetime;    // Remaining time
-  float maxLifetime; // Original lifetime for alpha calculation
-  float size;
-  bool active;
+  float direction = 0.0f;   // Degrees
+  float intensity = 1.0f;   // 0.0 to 1.0, scales rate, color and size
+  float sourceSpeed = 0.0f; // Speed of the emitting object
 };
 
 /**
  * Particle System for visual effects
- * Uses object pooling for efficiency
+ * Effects are data-driven EmitterDescriptors; each effect owns a particle
+ * group whose update/vertex kernels are specialized for its feature set.
+ * Groups share one chunk pool whose size is fixed by the pool policy, so
+ * memory stays bounded however the effects compete for it.
  */
 class ParticleSystem {
 public:
+  using EmitterId = int;
+  static constexpr EmitterId INVALID_EMITTER = -1;
+
+  /**
+   * Pool counters since the last policy change
+   */
+  struct PoolStats {
+    std::size_t dropped = 0; // Particles not spawned (cap reached)
+    std::size_t evicted = 0; // Live particles replaced by new ones
+    std::size_t peakLive = 0;
+    std::size_t allocatedChunks = 0;
+    std::size_t maxChunks = 0;
+  };
+
   ParticleSystem(std::size_t maxParticles = 2000);
 
+  // Set the pool policy, clearing all particles. Grow starts from
+  // maxParticles and may reach hardLimit (0 for twice maxParticles)
+  void setPoolPolicy(PoolPolicy policy, std::size_t hardLimit = 0);
+  PoolPolicy getPoolPolicy() const { return m_policy; }
+  PoolStats getPoolStats() const;
+
+  // Replace effects with the descriptors in a config file (keeps the current
+  // effects if the file cannot be read)
+  bool loadEmitters(const std::filesystem::path &path);
+  void setEmitters(std::vector<EmitterDescriptor> descriptors);
+
   // Update all particles
   void update(float deltaTime);
 
-  // Render all active particles
-  void render(sf::RenderWindow &window);
+  // Write quads for all active particles into vertices (sized on first use,
+  // reused afterwards), returns the vertex count
+  std::size_t buildVertices(std::vector<sf::Vertex> &vertices) const;
+
+  // Submit vertices produced by buildVertices
+  static void render(CommandList &commands,
+                     const std::vector<sf::Vertex> &vertices,
+                     std::size_t vertexCount);
+
+  // Generic emission by effect
+  EmitterId findEmitter(const std::string &name) const;
+  void emitContinuous(EmitterId id, const EmitParams &params,
+                      float deltaTime);
+  void emitBurst(EmitterId id, const EmitParams &params);
 
   // Spawn particles
   void emitDriftTrail(const sf::Vector2f &position,
@@ -43,15 +95,86 @@ public:
   // Clear all particles
   void clear();
 
+  // Emission scale under load (0..1, from a ParticleBudget), also capping
+  // the share of the pool in use. Applied by effect priority: essential
+  // effects ignore it and keep a reserve of the pool, cosmetic ones are
+  // thinned hardest.
+  void setBudget(float budget);
+  float getBudget() const { return m_budget; }
+
+  // CPU time of the last update plus vertex build (milliseconds)
+  float getCostMs() const { return m_updateMs + m_buildMs; }
+
+  // Seed the spawn randomness (spread, speed, lifetime...)
+  void seed(std::uint64_t seed) { m_rng = Pcg32(seed); }
+
+  // Snapshot live particles and the generator; restoring requires the same
+  // set of effects
+  void saveState(StateWriter &writer) const;
+  bool loadState(StateReader &reader);
+
+  std::size_t getActiveCount() const { return m_liveCount; }
+  std::size_t getActiveCount(EmitterId id) const {
+    return id == INVALID_EMITTER ? 0 : m_groups[id].particles.size();
+  }
+
 private:
-  // Get next available particle from pool
-  Particle *getAvailableParticle();
+  /**
+   * All live particles of one effect, oldest first
+   */
+  struct ParticleGroup {
+    ParticleQueue particles;
+    float spawnAccumulator = 0.0f; // Fractional particles owed
+    unsigned features = 0;
+    std::vector<sf::Color> gradientLut; // Tint by life, birth to death
+    float rateScale = 1.0f;             // Emission scale under the budget
+    std::size_t liveLimit = 0;          // Spawning stops at this many live
+    sf::Vector2f origin;                // Compact storage: positions' base
+    std::vector<sf::Color> palette;     // Compact storage: spawn colors
+  };
+
+  // Spawn count particles for an effect
+  void spawn(EmitterId id, const EmitParams &params, int count);
+
+  // Convert a new particle to the storage format (colorT picks its place
+  // in the effect's color range)
+  StoredParticle pack(ParticleGroup &group, const Particle &particle,
+                      float colorT);
+
+  // Free a slot for an effect under the eviction policies
+  bool evictFor(EmitterId id);
+
+  // Size the chunk pool for the policy and the current set of effects
+  void configurePool();
+
+  // Derive each group's emission scale and live limit from the budget
+  void applyBudget();
+
+  std::vector<EmitterDescriptor> m_descriptors;
+  std::vector<ParticleGroup> m_groups;
+  std::size_t m_maxParticles;
+  std::size_t m_liveCap; // m_maxParticles, or the hard limit when growing
+  std::size_t m_liveCount;
+  float m_lastDeltaTime; // Tick length used by the named emitters
+  Pcg32 m_rng;
+
+  // Storage
+  ParticleChunkPool m_pool;
+  PoolPolicy m_policy;
+  PoolStats m_poolStats;
+
+  // Frame budget
+  float m_budget;
+  float m_updateMs;
+  mutable float m_buildMs;
 
-  std::vector<Particle> m_particles;
-  sf::VertexArray m_vertices;
+  // Built-in effects used by gameplay
+  EmitterId m_driftEmitter;
+  EmitterId m_collisionEmitter;
+  EmitterId m_speedEmitter;
 
-  // Particle appearance
-  static constexpr float BASE_SIZE = 4.0f;
-  static constexpr float DRIFT_PARTICLE_LIFETIME = 0.6f;
-  static constexpr float COLLISION_PARTICLE_LIFETIME = 0.4f;
+  static constexpr std::size_t GRADIENT_LUT_SIZE = 16;
+  static constexpr std::size_t PALETTE_SIZE = 256; // Compact storage
+  static constexpr float ESSENTIAL_RESERVE = 0.2f; // Pool share kept free
+  static constexpr float COSMETIC_SHARE = 0.5f;    // Of the budgeted pool
 };
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "graphics/CommandList.hpp"
+#include <SFML/Graphics.hpp>
+
+/**
+ * Executes command lists against some framebuffer
+ * The game draws through SfmlBackend; CpuRasterizer draws the same lists
+ * into memory where there is no OpenGL context.
+ */
+class RenderBackend {
+public:
+  virtual ~RenderBackend() = default;
+
+  virtual void clear(sf::Color color) = 0;
+
+  // Draw every batch in order, in the coordinates of view
+  virtual void draw(const CommandList &commands, const sf::View &view) = 0;
+};
+
+/**
+ * Draws command lists with SFML, one draw call per batch
+ */
+class SfmlBackend : public RenderBackend {
+public:
+  explicit SfmlBackend(sf::RenderTarget &target) : m_target(target) {}
+
+  void clear(sf::Color color) override { m_target.clear(color); }
+  void draw(const CommandList &commands, const sf::View &view) override;
+
+private:
+  sf::RenderTarget &m_target;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * Frame-time controller for the world layer's render resolution
+ * Fed the interval between presented frames, it steps the scale down when
+ * frames run long and probes back up once they have been on time for a
+ * while. A probe that makes frames late again is undone and the next one
+ * waits twice as long, so a machine at its limit settles instead of
+ * oscillating. Scales move in fixed steps to keep the upscaled image stable.
+ */
+class ResolutionScaler {
+public:
+  static constexpr float MIN_SCALE = 0.5f;
+  static constexpr float STEP = 0.1f;
+
+  explicit ResolutionScaler(float targetFrameMs);
+
+  // Record a frame interval (milliseconds) and return the new scale
+  float update(float frameMs);
+
+  // Forget the running average (after a pause or loading hitch)
+  void reset();
+
+  float getScale() const { return m_scale; }
+  float getSmoothedFrameMs() const { return m_frameMs; }
+
+private:
+  float m_targetMs;
+  float m_frameMs; // Running average of the interval
+  float m_scale;
+
+  int m_cooldown;     // Frames before the scale may change again
+  int m_onTimeFrames; // Consecutive frames within the target
+  int m_probeWait;    // On-time frames needed before stepping up
+  int m_probeFrames;  // Frames left to judge the last step up (0 = none)
+
+  static constexpr float SMOOTHING = 0.1f;   // Weight of the newest frame
+  static constexpr float LATE = 1.05f;       // Of the target, on average
+  static constexpr int COOLDOWN_FRAMES = 30; // After any change
+  static constexpr int PROBE_WAIT = 120;     // Two seconds at 60 Hz
+  static constexpr int MAX_PROBE_WAIT = 1920;
+  static constexpr int PROBE_FRAMES = 60; // To see if a step up holds
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "graphics/TileAtlas.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A car's tires this tick, as far as skid marks care
+ */
+struct SkidSource {
+  sf::Vector2f position; // Car origin
+  float rotation = 0.0f; // Degrees
+  float intensity = 0.0f; // 0 = no marks, 1 = full drift
+};
+
+/**
+ * Persistent tire marks that cost the same to draw however many there are
+ * Each frame the rear wheels' movement since the last frame is stamped
+ * once into a TileAtlas that scrolls with the camera, and every few ticks
+ * one subtractive pass over the whole atlas fades all marks at once. The
+ * marks are then composited with the visible tiles in a single draw, so
+ * drawing a track covered in skids is no dearer than an empty one. Marks
+ * on tiles that scroll out of the atlas are dropped.
+ */
+class SkidMarkLayer {
+public:
+  static constexpr int TILE_SIZE = 512;
+  static constexpr std::size_t MAX_SOURCES = 2; // Cars
+
+  SkidMarkLayer();
+
+  // Allocate the atlas for a view of this size (false without render
+  // textures; the layer then draws nothing)
+  bool init(sf::Vector2f viewSize);
+  bool isAvailable() const { return m_atlas.isAvailable(); }
+
+  // Stamp each car's marks since the last update and fade by the ticks
+  // since then. A step going backwards (rewind) clears the marks.
+  void update(const sf::View &view, const SkidSource *sources,
+              std::size_t count, std::uint64_t step);
+
+  // Composite the marks under the view passed to update
+  void render(sf::RenderTarget &target);
+
+  void clear();
+
+private:
+  /**
+   * Where a car's rear wheels were last stamped
+   */
+  struct Track {
+    sf::Vector2f wheels[2];
+    float intensity = 0.0f;
+    bool active = false;
+  };
+
+  void stampWheels(Track &track, const SkidSource &source);
+  void fade(std::uint8_t amount);
+
+  TileAtlas m_atlas;
+  std::array<Track, MAX_SOURCES> m_tracks;
+  std::vector<sf::Vertex> m_stamps; // Marks stamped this update
+  std::vector<sf::Vertex> m_quads;  // Visible tiles
+  sf::Vector2i m_min;               // Visible tiles at the last update
+  sf::Vector2i m_max;
+  bool m_visible;
+  std::uint64_t m_fadeStep; // Step the marks were last faded to
+  bool m_started;
+
+  static constexpr float REAR_AXLE = 10.0f; // Behind the car's origin
+  static constexpr float HALF_TRACK = 8.0f; // Wheel offset from the axis
+  static constexpr float MARK_WIDTH = 4.0f;
+  static constexpr float MAX_ALPHA = 110.0f;       // At full drift
+  static constexpr float MAX_SEGMENT = 80.0f;      // Longer = teleport
+  static constexpr std::uint64_t FADE_TICKS = 6;   // Between fade passes
+  static constexpr std::uint8_t FADE_AMOUNT = 1;   // Per pass (of 255)
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+// value mod divisor in [0, divisor), also for negative tile coordinates
+inline int positiveModulo(int value, int divisor) {
+  return ((value % divisor) + divisor) % divisor;
+}
+
+/**
+ * World-space tiles cached in the slots of one render texture
+ * Sized to cover a view from any offset, the atlas wraps around as the
+ * camera moves: each world tile maps to a fixed slot by its coordinates
+ * modulo the slot grid, and a slot records which tile it currently holds
+ * so layers only rasterize tiles that are new to their slot. Shared by the
+ * background and decal layers.
+ */
+class TileAtlas {
+public:
+  explicit TileAtlas(int tileSize);
+
+  // Allocate slots for a view of this size (false without render textures)
+  bool init(sf::Vector2f viewSize);
+  bool isAvailable() const { return m_available; }
+
+  // Tiles under view as [min, max] tile coordinates; false when the view
+  // needs more slots than the atlas has
+  bool visibleTiles(const sf::View &view, sf::Vector2i &min,
+                    sf::Vector2i &max) const;
+
+  // Whether tile's slot holds it; claim records that it now does
+  bool holds(sf::Vector2i tile) const;
+  void claim(sf::Vector2i tile);
+
+  // Forget the held tiles (all, or those overlapping a world area)
+  void invalidate();
+  void invalidate(const sf::FloatRect &area);
+
+  // Point the atlas at tile's slot: world coordinates drawn afterwards
+  // land in the slot, clipped to the tile
+  sf::RenderTexture &beginTile(sf::Vector2i tile);
+
+  // Append tile's world square, textured from its slot (two triangles)
+  void appendQuad(std::vector<sf::Vertex> &vertices, sf::Vector2i tile) const;
+
+  sf::FloatRect tileBounds(sf::Vector2i tile) const;
+  sf::Vector2i tileAt(sf::Vector2f position) const;
+  std::size_t getSlotCount() const { return m_slots.size(); }
+  int getTileSize() const { return m_tileSize; }
+
+  sf::RenderTexture &getTarget() { return m_atlas; }
+  const sf::Texture &getTexture() const { return m_atlas.getTexture(); }
+
+private:
+  struct Slot {
+    sf::Vector2i tile; // World tile held
+    bool valid = false;
+  };
+
+  std::size_t slotIndex(sf::Vector2i tile) const;
+  sf::Vector2i slotOrigin(sf::Vector2i tile) const; // Atlas pixels
+
+  sf::RenderTexture m_atlas;
+  bool m_available;
+  int m_tileSize; // World pixels, drawn 1:1
+  int m_columns;  // Slots across and down the atlas
+  int m_rows;
+  std::vector<Slot> m_slots;
+};
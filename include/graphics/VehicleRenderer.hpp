@@ -0,0 +1,28 @@
+#pragma once
+
+#include "entities/Components.hpp"
+#include "graphics/CommandList.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+
+/**
+ * Draws a vehicle entity from its render instance
+ * The arrow-shaped hull and its outline are built once in local space
+ * (as sf::ConvexShape would build them) and only transformed per draw, so
+ * vehicles batch with the other untextured entities.
+ */
+class VehicleRenderer {
+public:
+  VehicleRenderer();
+
+  void render(CommandList &commands, const RenderInstance &instance);
+
+private:
+  static constexpr std::size_t POINTS = 4;
+  static constexpr float OUTLINE_THICKNESS = 2.0f;
+
+  std::array<sf::Vector2f, POINTS> m_points; // Hull, around the origin
+  std::array<sf::Vector2f, POINTS> m_outer;  // Outline's outer edge
+  sf::Vector2f m_center;                     // Fan center
+};
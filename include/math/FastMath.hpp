@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NEONDRIFT_FASTMATH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * Fast trigonometry approximations for gameplay and effects
+ *
+ * Accuracy bounds (float, measured against double-precision std):
+ *   sincos       |x| <= 8192 rad   abs error <= 1.5e-7
+ *   sincosDeg    |x| <= 1e5 deg    abs error <= 2.5e-7
+ *   atan2        all finite y, x   abs error <= 2.5e-6 rad
+ * Results are not IEEE-exact; deterministic simulation uses Fixed instead.
+ * The 4-wide variants share the same polynomials and bounds.
+ */
+namespace fastmath {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float HALF_PI = 1.57079632679490f;
+constexpr float TWO_OVER_PI = 0.636619772367581f;
+constexpr float DEG_TO_RAD = PI / 180.0f;
+constexpr float RAD_TO_DEG = 180.0f / PI;
+
+namespace detail {
+
+// Cody-Waite split of pi/2 for accurate range reduction
+constexpr float PIO2_1 = 1.5703125f;
+constexpr float PIO2_2 = 4.837512969970703125e-4f;
+constexpr float PIO2_3 = 7.54978995489188216e-8f;
+
+// Minimax polynomials on [-pi/4, pi/4]
+inline float sinPoly(float r, float r2) {
+  return r + r * r2 *
+                 (-1.6666654611e-1f +
+                  r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+}
+inline float cosPoly(float r2) {
+  return 1.0f - 0.5f * r2 +
+         r2 * r2 *
+             (4.166664568298827e-2f +
+              r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+}
+
+// atan on [0, 1]
+inline float atanPoly(float a) {
+  float s = a * a;
+  return a * (0.99997726f +
+              s * (-0.33262347f +
+                   s * (0.19354346f +
+                        s * (-0.11643287f +
+                             s * (0.05265332f + s * -0.01172120f)))));
+}
+
+inline float roundNearest(float x) {
+  return static_cast<float>(
+      static_cast<std::int32_t>(x + (x >= 0.0f ? 0.5f : -0.5f)));
+}
+
+} // namespace detail
+
+// Sine and cosine of an angle in radians
+inline void sincos(float x, float &s, float &c) {
+  float q = detail::roundNearest(x * TWO_OVER_PI);
+  float r = ((x - q * detail::PIO2_1) - q * detail::PIO2_2) -
+            q * detail::PIO2_3;
+  float r2 = r * r;
+  float sr = detail::sinPoly(r, r2);
+  float cr = detail::cosPoly(r2);
+
+  // Quadrant fix-up: rotate (sr, cr) by q * 90 degrees (select, no switch,
+  // so the compiler can emit branch-free code)
+  std::int32_t qi = static_cast<std::int32_t>(q);
+  float sv = (qi & 1) ? cr : sr;
+  float cv = (qi & 1) ? sr : cr;
+  s = (qi & 2) ? -sv : sv;
+  c = ((qi + 1) & 2) ? -cv : cv;
+}
+
+// Sine and cosine of an angle in degrees (reduced in degrees first so large
+// angles keep full accuracy)
+inline void sincosDeg(float degrees, float &s, float &c) {
+  float turns = detail::roundNearest(degrees * (1.0f / 360.0f));
+  sincos((degrees - turns * 360.0f) * DEG_TO_RAD, s, c);
+}
+
+// Four-quadrant arctangent in radians
+inline float atan2(float y, float x) {
+  float ax = x < 0.0f ? -x : x;
+  float ay = y < 0.0f ? -y : y;
+  float mx = ax > ay ? ax : ay;
+  float mn = ax > ay ? ay : ax;
+  float a = mx > 0.0f ? mn / mx : 0.0f;
+
+  float r = detail::atanPoly(a);
+  if (ay > ax)
+    r = HALF_PI - r;
+  if (x < 0.0f)
+    r = PI - r;
+  if (y < 0.0f)
+    r = -r;
+  return r;
+}
+
+#ifdef NEONDRIFT_FASTMATH_SSE2
+
+// Four sincos evaluations at once (x, s, c may be unaligned)
+inline void sincos4(const float *x, float *s, float *c) {
+  __m128 vx = _mm_loadu_ps(x);
+
+  // Quadrant index, rounded to nearest
+  __m128i qi = _mm_cvtps_epi32(_mm_mul_ps(vx, _mm_set1_ps(TWO_OVER_PI)));
+  __m128 q = _mm_cvtepi32_ps(qi);
+
+  __m128 r = _mm_sub_ps(vx, _mm_mul_ps(q, _mm_set1_ps(detail::PIO2_1)));
+  r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(detail::PIO2_2)));
+  r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(detail::PIO2_3)));
+  __m128 r2 = _mm_mul_ps(r, r);
+
+  // sin polynomial
+  __m128 sp = _mm_add_ps(_mm_set1_ps(8.3321608736e-3f),
+                         _mm_mul_ps(r2, _mm_set1_ps(-1.9515295891e-4f)));
+  sp = _mm_add_ps(_mm_set1_ps(-1.6666654611e-1f), _mm_mul_ps(r2, sp));
+  __m128 sr = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), sp));
+
+  // cos polynomial
+  __m128 cp = _mm_add_ps(_mm_set1_ps(-1.388731625493765e-3f),
+                         _mm_mul_ps(r2, _mm_set1_ps(2.443315711809948e-5f)));
+  cp = _mm_add_ps(_mm_set1_ps(4.166664568298827e-2f), _mm_mul_ps(r2, cp));
+  __m128 cr = _mm_add_ps(
+      _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)),
+      _mm_mul_ps(_mm_mul_ps(r2, r2), cp));
+
+  // Quadrant fix-up with masks: odd quadrants swap, bit 1 / (q+1) bit 1 negate
+  __m128i one = _mm_set1_epi32(1);
+  __m128i two = _mm_set1_epi32(2);
+  __m128 swap =
+      _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(qi, one), one));
+  __m128 sinVal = _mm_or_ps(_mm_and_ps(swap, cr), _mm_andnot_ps(swap, sr));
+  __m128 cosVal = _mm_or_ps(_mm_and_ps(swap, sr), _mm_andnot_ps(swap, cr));
+
+  __m128 signBit = _mm_set1_ps(-0.0f);
+  __m128 sinNeg =
+      _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(qi, two), two));
+  __m128 cosNeg = _mm_castsi128_ps(
+      _mm_cmpeq_epi32(_mm_and_si128(_mm_add_epi32(qi, one), two), two));
+  sinVal = _mm_xor_ps(sinVal, _mm_and_ps(sinNeg, signBit));
+  cosVal = _mm_xor_ps(cosVal, _mm_and_ps(cosNeg, signBit));
+
+  _mm_storeu_ps(s, sinVal);
+  _mm_storeu_ps(c, cosVal);
+}
+
+// Four atan2 evaluations at once
+inline void atan2_4(const float *y, const float *x, float *out) {
+  __m128 vy = _mm_loadu_ps(y);
+  __m128 vx = _mm_loadu_ps(x);
+  __m128 signBit = _mm_set1_ps(-0.0f);
+  __m128 ax = _mm_andnot_ps(signBit, vx);
+  __m128 ay = _mm_andnot_ps(signBit, vy);
+  __m128 mx = _mm_max_ps(ax, ay);
+  __m128 mn = _mm_min_ps(ax, ay);
+
+  // a = mn / mx, with 0/0 mapped to 0
+  __m128 nonZero = _mm_cmpgt_ps(mx, _mm_setzero_ps());
+  __m128 safeMx = _mm_or_ps(_mm_and_ps(nonZero, mx),
+                            _mm_andnot_ps(nonZero, _mm_set1_ps(1.0f)));
+  __m128 a = _mm_and_ps(nonZero, _mm_div_ps(mn, safeMx));
+  __m128 s = _mm_mul_ps(a, a);
+  __m128 p = _mm_add_ps(_mm_set1_ps(0.05265332f),
+                        _mm_mul_ps(s, _mm_set1_ps(-0.01172120f)));
+  p = _mm_add_ps(_mm_set1_ps(-0.11643287f), _mm_mul_ps(s, p));
+  p = _mm_add_ps(_mm_set1_ps(0.19354346f), _mm_mul_ps(s, p));
+  p = _mm_add_ps(_mm_set1_ps(-0.33262347f), _mm_mul_ps(s, p));
+  p = _mm_add_ps(_mm_set1_ps(0.99997726f), _mm_mul_ps(s, p));
+  __m128 r = _mm_mul_ps(a, p);
+
+  __m128 steep = _mm_cmpgt_ps(ay, ax);
+  r = _mm_or_ps(_mm_and_ps(steep, _mm_sub_ps(_mm_set1_ps(HALF_PI), r)),
+                _mm_andnot_ps(steep, r));
+  __m128 negX = _mm_cmplt_ps(vx, _mm_setzero_ps());
+  r = _mm_or_ps(_mm_and_ps(negX, _mm_sub_ps(_mm_set1_ps(PI), r)),
+                _mm_andnot_ps(negX, r));
+  __m128 negY = _mm_cmplt_ps(vy, _mm_setzero_ps());
+  r = _mm_xor_ps(r, _mm_and_ps(negY, signBit));
+
+  _mm_storeu_ps(out, r);
+}
+
+#else
+
+inline void sincos4(const float *x, float *s, float *c) {
+  for (int i = 0; i < 4; ++i)
+    sincos(x[i], s[i], c[i]);
+}
+
+inline void atan2_4(const float *y, const float *x, float *out) {
+  for (int i = 0; i < 4; ++i)
+    out[i] = atan2(y[i], x[i]);
+}
+
+#endif
+
+// Batched sincos over arbitrary counts (4-wide body, scalar tail)
+inline void sincosBatch(const float *x, float *s, float *c, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    sincos4(x + i, s + i, c + i);
+  for (; i < n; ++i)
+    sincos(x[i], s[i], c[i]);
+}
+
+} // namespace fastmath
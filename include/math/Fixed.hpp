@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Signed Q47.16 fixed-point number
+ * All arithmetic is integer-only, so results are bit-identical on every
+ * compiler, optimization level and CPU. Range covers the playfield and
+ * physics values comfortably (products stay below 2^63).
+ */
+class Fixed {
+public:
+  static constexpr int FRACTION_BITS = 16;
+  static constexpr std::int64_t ONE = std::int64_t(1) << FRACTION_BITS;
+
+  constexpr Fixed() : m_raw(0) {}
+
+  // Conversion from floating-point constants (exact for dyadic values,
+  // round-to-nearest otherwise)
+  constexpr Fixed(float value) // NOLINT: implicit on purpose for constants
+      : m_raw(roundToRaw(static_cast<double>(value))) {}
+  constexpr explicit Fixed(int value) : m_raw(std::int64_t(value) * ONE) {}
+
+  static constexpr Fixed fromRaw(std::int64_t raw) {
+    Fixed f;
+    f.m_raw = raw;
+    return f;
+  }
+  static constexpr Fixed fromRatio(std::int64_t num, std::int64_t den) {
+    return fromRaw(num * ONE / den);
+  }
+
+  constexpr std::int64_t raw() const { return m_raw; }
+  constexpr float toFloat() const {
+    return static_cast<float>(static_cast<double>(m_raw) / ONE);
+  }
+  // Integer part (rounds toward negative infinity)
+  constexpr std::int64_t floor() const { return m_raw >> FRACTION_BITS; }
+
+  // Arithmetic
+  constexpr Fixed operator-() const { return fromRaw(-m_raw); }
+  constexpr Fixed operator+(Fixed o) const { return fromRaw(m_raw + o.m_raw); }
+  constexpr Fixed operator-(Fixed o) const { return fromRaw(m_raw - o.m_raw); }
+  constexpr Fixed operator*(Fixed o) const {
+    return fromRaw((m_raw * o.m_raw) >> FRACTION_BITS);
+  }
+  constexpr Fixed operator/(Fixed o) const {
+    return fromRaw((m_raw * ONE) / o.m_raw);
+  }
+
+  constexpr Fixed &operator+=(Fixed o) {
+    m_raw += o.m_raw;
+    return *this;
+  }
+  constexpr Fixed &operator-=(Fixed o) {
+    m_raw -= o.m_raw;
+    return *this;
+  }
+  constexpr Fixed &operator*=(Fixed o) { return *this = *this * o; }
+  constexpr Fixed &operator/=(Fixed o) { return *this = *this / o; }
+
+  // Comparison
+  constexpr bool operator==(Fixed o) const { return m_raw == o.m_raw; }
+  constexpr bool operator!=(Fixed o) const { return m_raw != o.m_raw; }
+  constexpr bool operator<(Fixed o) const { return m_raw < o.m_raw; }
+  constexpr bool operator>(Fixed o) const { return m_raw > o.m_raw; }
+  constexpr bool operator<=(Fixed o) const { return m_raw <= o.m_raw; }
+  constexpr bool operator>=(Fixed o) const { return m_raw >= o.m_raw; }
+
+private:
+  static constexpr std::int64_t roundToRaw(double value) {
+    double scaled = value * ONE;
+    return static_cast<std::int64_t>(scaled >= 0.0 ? scaled + 0.5
+                                                   : scaled - 0.5);
+  }
+
+  std::int64_t m_raw;
+};
+
+namespace fixed_detail {
+
+// Sine table resolution: 4096 steps per full turn
+constexpr int TRIG_STEPS = 4096;
+
+/**
+ * Sine table in Q16, generated at compile time with integer-only Taylor
+ * series (Q30 intermediates), so the table itself is platform independent
+ */
+constexpr std::array<std::int32_t, TRIG_STEPS + 1> makeSineTable() {
+  constexpr std::int64_t Q30 = std::int64_t(1) << 30;
+  constexpr std::int64_t HALF_PI_Q30 = 1686629713; // pi/2 * 2^30
+  constexpr int QUARTER = TRIG_STEPS / 4;
+
+  std::array<std::int32_t, TRIG_STEPS + 1> table{};
+  for (int i = 0; i <= QUARTER; ++i) {
+    std::int64_t x = HALF_PI_Q30 * i / QUARTER;
+    std::int64_t term = x;
+    std::int64_t sum = x;
+    for (int n = 1; n <= 9; ++n) {
+      term = -(((term * x) >> 30) * x >> 30) / ((2 * n) * (2 * n + 1));
+      sum += term;
+    }
+    if (sum > Q30)
+      sum = Q30;
+    std::int32_t value = static_cast<std::int32_t>((sum + (1 << 13)) >> 14);
+    table[i] = value;                          // 0 .. 90
+    table[2 * QUARTER - i] = value;            // 90 .. 180
+    table[2 * QUARTER + i] = -value;           // 180 .. 270
+    table[TRIG_STEPS - i] = i == 0 ? 0 : -value; // 270 .. 360
+  }
+  return table;
+}
+
+constexpr std::array<std::int32_t, TRIG_STEPS + 1> SINE_TABLE =
+    makeSineTable();
+
+} // namespace fixed_detail
+
+// Table-based sine of an angle in degrees (linear interpolation)
+inline Fixed sinDeg(Fixed degrees) {
+  constexpr std::int64_t FULL_TURN = std::int64_t(360) * Fixed::ONE;
+  std::int64_t phase = degrees.raw() % FULL_TURN;
+  if (phase < 0)
+    phase += FULL_TURN;
+
+  std::int64_t pos = phase * fixed_detail::TRIG_STEPS;
+  std::int64_t index = pos / FULL_TURN;
+  std::int64_t frac = pos % FULL_TURN;
+
+  std::int64_t a = fixed_detail::SINE_TABLE[index];
+  std::int64_t b = fixed_detail::SINE_TABLE[index + 1];
+  return Fixed::fromRaw(a + (b - a) * frac / FULL_TURN);
+}
+
+inline Fixed cosDeg(Fixed degrees) { return sinDeg(degrees + Fixed(90)); }
+
+// Integer square root (bit-by-bit, exact floor)
+inline Fixed sqrt(Fixed value) {
+  if (value.raw() <= 0)
+    return Fixed();
+
+  std::uint64_t n = static_cast<std::uint64_t>(value.raw())
+                    << Fixed::FRACTION_BITS;
+  std::uint64_t result = 0;
+  std::uint64_t bit = std::uint64_t(1) << 62;
+  while (bit > n)
+    bit >>= 2;
+  while (bit != 0) {
+    if (n >= result + bit) {
+      n -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return Fixed::fromRaw(static_cast<std::int64_t>(result));
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#define NEONDRIFT_HALF_F16C 1
+#include <immintrin.h>
+#endif
+
+/**
+ * IEEE 754 half precision (binary16) conversions for compact storage
+ * Rounds to nearest, relative precision 2^-11. Values beyond the half range
+ * saturate to the largest finite half. The portable path flushes subnormal
+ * halves to zero; with F16C they are kept (a difference below 6e-5).
+ */
+namespace half {
+
+inline std::uint16_t fromFloat(float value) {
+#ifdef NEONDRIFT_HALF_F16C
+  constexpr float HALF_MAX = 65504.0f;
+  value = value > HALF_MAX ? HALF_MAX : value < -HALF_MAX ? -HALF_MAX : value;
+  return static_cast<std::uint16_t>(
+      _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+  std::int32_t exponent =
+      static_cast<std::int32_t>((bits >> 23) & 0xFFu) - 112;
+  std::uint32_t mantissa = bits & 0x7FFFFFu;
+
+  if (exponent <= 0)
+    return sign; // Zero, or too small for a normal half
+  if (exponent >= 31)
+    return sign | 0x7BFFu; // Too large (or not finite)
+
+  // Round to nearest; a carry into the exponent is still a valid half
+  std::uint32_t result = (static_cast<std::uint32_t>(exponent) << 10) |
+                         (mantissa >> 13);
+  result += (mantissa >> 12) & 1u;
+  if (result >= 0x7C00u)
+    result = 0x7BFFu;
+  return static_cast<std::uint16_t>(sign | result);
+#endif
+}
+
+inline float toFloat(std::uint16_t value) {
+#ifdef NEONDRIFT_HALF_F16C
+  return _cvtsh_ss(value);
+#else
+  std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+  std::uint32_t exponent = (value >> 10) & 0x1Fu;
+  std::uint32_t mantissa = value & 0x3FFu;
+  std::uint32_t bits =
+      exponent == 0 ? sign : sign | ((exponent + 112) << 23) | (mantissa << 13);
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+#endif
+}
+
+} // namespace half
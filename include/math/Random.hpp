@@ -0,0 +1,56 @@
+#pragma once
+
+#include "math/Scalar.hpp"
+#include <cstdint>
+
+/**
+ * PCG32 random generator with 8 bytes of state
+ * Replaces std::mt19937 (2.5 KB) wherever generator state is part of a
+ * simulation snapshot; the raw state is trivially copyable
+ */
+class Pcg32 {
+public:
+  using result_type = std::uint32_t;
+
+  explicit Pcg32(std::uint64_t seed = 0) : m_state(0) {
+    (*this)();
+    m_state += seed;
+    (*this)();
+  }
+
+  result_type operator()() {
+    std::uint64_t old = m_state;
+    m_state = old * MULTIPLIER + INCREMENT;
+    auto xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+    auto rotation = static_cast<std::uint32_t>(old >> 59u);
+    return (xorshifted >> rotation) | (xorshifted << ((32u - rotation) & 31u));
+  }
+
+  // Uniform in [0, 1) from the top 24 bits (exact in a float)
+  float nextFloat() {
+    return static_cast<float>((*this)() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+  std::uint64_t getState() const { return m_state; }
+  void setState(std::uint64_t state) { m_state = state; }
+
+private:
+  std::uint64_t m_state;
+
+  static constexpr std::uint64_t MULTIPLIER = 6364136223846793005ull;
+  static constexpr std::uint64_t INCREMENT = 1442695040888963407ull;
+};
+
+namespace scalar {
+
+// Uniform in [low, high), identical in float and fixed-point builds: 24
+// random bits as an exact ratio, so both builds draw the same sequence
+template <typename T> T uniform(Pcg32 &rng, T low, T high) {
+  T t = fromRatio<T>(rng() >> 8, 1 << 24);
+  return low + (high - low) * t;
+}
+
+} // namespace scalar
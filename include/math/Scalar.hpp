@@ -0,0 +1,70 @@
+#pragma once
+
+#include "math/FastMath.hpp"
+#include "math/Fixed.hpp"
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Scalar abstraction shared by the simulation templates
+ * float is the fast default; Fixed gives bit-exact results everywhere
+ */
+namespace scalar {
+
+constexpr float DEG_TO_RAD = 3.14159265f / 180.0f;
+
+// Conversions
+template <typename T> constexpr T fromFloat(float value) { return T(value); }
+template <typename T> constexpr T fromRatio(std::int64_t num, std::int64_t den);
+template <> constexpr float fromRatio<float>(std::int64_t num,
+                                             std::int64_t den) {
+  return static_cast<float>(num) / static_cast<float>(den);
+}
+template <> constexpr Fixed fromRatio<Fixed>(std::int64_t num,
+                                             std::int64_t den) {
+  return Fixed::fromRatio(num, den);
+}
+
+template <typename T> constexpr T fromInt(std::int64_t value) {
+  return fromRatio<T>(value, 1);
+}
+
+constexpr float toFloat(float value) { return value; }
+constexpr float toFloat(Fixed value) { return value.toFloat(); }
+
+// Integer part (floor)
+inline std::int64_t floor(float value) {
+  return static_cast<std::int64_t>(std::floor(value));
+}
+constexpr std::int64_t floor(Fixed value) { return value.floor(); }
+
+// Math
+inline float sqrt(float value) { return std::sqrt(value); }
+inline Fixed sqrt(Fixed value) { return ::sqrt(value); }
+
+inline float sinDeg(float degrees) { return std::sin(degrees * DEG_TO_RAD); }
+inline float cosDeg(float degrees) { return std::cos(degrees * DEG_TO_RAD); }
+inline Fixed sinDeg(Fixed degrees) { return ::sinDeg(degrees); }
+inline Fixed cosDeg(Fixed degrees) { return ::cosDeg(degrees); }
+
+// Sine and cosine together (fast polynomial for float, table for Fixed)
+inline void sinCosDeg(float degrees, float &s, float &c) {
+  fastmath::sincosDeg(degrees, s, c);
+}
+inline void sinCosDeg(Fixed degrees, Fixed &s, Fixed &c) {
+  s = ::sinDeg(degrees);
+  c = ::cosDeg(degrees);
+}
+
+template <typename T> constexpr T min(T a, T b) { return b < a ? b : a; }
+template <typename T> constexpr T max(T a, T b) { return a < b ? b : a; }
+template <typename T> constexpr T abs(T a) { return a < T(0.0f) ? -a : a; }
+
+} // namespace scalar
+
+// Scalar type used by the gameplay simulation
+#ifdef NEONDRIFT_DETERMINISTIC
+using SimScalar = Fixed;
+#else
+using SimScalar = float;
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "math/Scalar.hpp"
+#include <SFML/System/Vector2.hpp>
+
+/**
+ * Minimal 2D vector over a simulation scalar
+ */
+template <typename T> struct Vec2 {
+  T x;
+  T y;
+
+  constexpr Vec2() : x(), y() {}
+  constexpr Vec2(T x_, T y_) : x(x_), y(y_) {}
+
+  constexpr Vec2 operator+(const Vec2 &o) const { return {x + o.x, y + o.y}; }
+  constexpr Vec2 operator-(const Vec2 &o) const { return {x - o.x, y - o.y}; }
+  constexpr Vec2 operator*(T s) const { return {x * s, y * s}; }
+
+  Vec2 &operator+=(const Vec2 &o) {
+    x += o.x;
+    y += o.y;
+    return *this;
+  }
+  Vec2 &operator-=(const Vec2 &o) {
+    x -= o.x;
+    y -= o.y;
+    return *this;
+  }
+
+  constexpr T dot(const Vec2 &o) const { return x * o.x + y * o.y; }
+  T length() const { return scalar::sqrt(dot(*this)); }
+
+  sf::Vector2f toSf() const {
+    return sf::Vector2f(scalar::toFloat(x), scalar::toFloat(y));
+  }
+  static Vec2 fromSf(const sf::Vector2f &v) { return {T(v.x), T(v.y)}; }
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "core/ControlInput.hpp"
+#include "core/Simulation.hpp"
+#include "net/UdpLink.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Rollback netcode for a two-player versus match
+ * Each tick runs immediately with a prediction of the remote car's controls
+ * (its last confirmed input). When the real input arrives and differs, the
+ * simulation is restored to the snapshot taken before that tick and every
+ * tick since is simulated again. Local input is delayed by a couple of ticks
+ * to make mispredictions rarer. Both peers must run the same build with the
+ * same seed; finalized ticks are checksummed to detect desyncs.
+ */
+class RollbackSession {
+public:
+  static constexpr std::uint32_t INPUT_DELAY = 2;     // Ticks
+  static constexpr std::uint32_t MAX_PREDICTION = 12; // Ticks ahead of peer
+  static constexpr std::uint32_t HISTORY = 64;        // Ticks kept (pow2)
+  static constexpr std::uint32_t PEER_TIMEOUT = 300;  // Stalled frames
+
+  struct Stats {
+    std::uint64_t rollbacks = 0;
+    std::uint64_t resimulatedTicks = 0;
+    std::uint32_t maxRollback = 0; // Deepest rollback (ticks)
+    std::uint64_t stalls = 0;      // Frames spent waiting for the peer
+    std::uint64_t checksums = 0;   // Finalized ticks compared with the peer
+    std::uint64_t desyncs = 0;     // ... that did not match
+  };
+
+  RollbackSession(Simulation &simulation, UdpLink &link);
+
+  // One frame: exchange input, roll back if a prediction was wrong and run
+  // the next tick with `local` (applied INPUT_DELAY ticks later). Returns
+  // false if too far ahead of the peer to predict; call again next frame.
+  bool advance(const ControlInput &local);
+
+  // Ticks simulated so far
+  std::uint32_t getTick() const { return m_tick; }
+
+  // No packet for PEER_TIMEOUT frames in a row while stalled
+  bool isPeerLost() const { return m_stalledFrames >= PEER_TIMEOUT; }
+
+  const Stats &getStats() const { return m_stats; }
+
+private:
+  /**
+   * Everything remembered about one tick (slot = tick % HISTORY)
+   */
+  struct TickRecord {
+    ControlInput local;
+    ControlInput remote;  // Confirmed, or the prediction that was used
+    std::uint32_t checksum = 0;      // After the tick
+    std::vector<std::uint8_t> state; // Before the tick
+  };
+
+  TickRecord &record(std::uint32_t tick) { return m_history[tick % HISTORY]; }
+
+  ControlInput remoteInput(std::uint32_t tick) const;
+  void receivePackets();
+  void readPacket(const std::vector<std::uint8_t> &packet);
+  void sendPacket();
+  void rollback();
+  void simulate(std::uint32_t tick, bool resimulated);
+  void compareChecksum();
+
+  Simulation &m_simulation;
+  UdpLink &m_link;
+  std::array<TickRecord, HISTORY> m_history;
+
+  std::uint32_t m_tick;           // Next tick to simulate
+  std::uint32_t m_localInputs;    // Local inputs queued (ticks 0..n-1)
+  std::uint32_t m_remoteInputs;   // Remote inputs confirmed (ticks 0..n-1)
+  std::uint32_t m_peerAck;        // Local inputs the peer has confirmed
+  std::uint32_t m_rollbackTick;   // Earliest mispredicted tick (or m_tick)
+  ControlInput m_lastRemote;      // Latest confirmed remote input
+
+  // Peer's newest finalized checksum, compared once ours is final too
+  bool m_peerChecksumPending;
+  std::uint32_t m_peerChecksumTick;
+  std::uint32_t m_peerChecksum;
+
+  std::uint32_t m_stalledFrames;
+  std::vector<std::uint8_t> m_packet; // Reused send/receive buffer
+  Stats m_stats;
+};
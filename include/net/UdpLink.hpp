@@ -0,0 +1,72 @@
+#pragma once
+
+#include "math/Random.hpp"
+#include <SFML/Network.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Simulated network conditions applied to outgoing packets
+ */
+struct LinkConditions {
+  float latencyMs = 0.0f;   // One-way delay added before sending
+  float jitterMs = 0.0f;    // Up to this much extra delay, uniformly random
+  float lossPercent = 0.0f; // Share of packets dropped (0..100)
+};
+
+/**
+ * Non-blocking UDP connection to a single peer
+ * Outgoing packets can be delayed and dropped to test play over a bad link
+ * on localhost; delayed packets go out from poll(), which the owner calls
+ * every frame. Packets from any other address are ignored.
+ */
+class UdpLink {
+public:
+  static constexpr std::size_t MAX_PACKET = 512; // Bytes
+
+  struct Stats {
+    std::uint64_t sent = 0;     // Handed to the socket
+    std::uint64_t dropped = 0;  // Lost to simulated packet loss
+    std::uint64_t received = 0; // From the peer
+  };
+
+  UdpLink();
+
+  // Bind the local port and remember the peer; false if the port is taken
+  bool open(unsigned short localPort, const sf::IpAddress &peer,
+            unsigned short peerPort);
+
+  void setConditions(const LinkConditions &conditions, std::uint64_t seed);
+
+  // Queue a packet (sent immediately on a perfect link)
+  void send(const std::uint8_t *data, std::size_t size);
+
+  // Send delayed packets that are due
+  void poll();
+
+  // Next packet from the peer, if any (replaces the vector's contents)
+  bool receive(std::vector<std::uint8_t> &packet);
+
+  const Stats &getStats() const { return m_stats; }
+
+private:
+  struct Delayed {
+    std::int64_t dueNs;
+    std::size_t size;
+    std::array<std::uint8_t, MAX_PACKET> data;
+  };
+
+  void transmit(const std::uint8_t *data, std::size_t size);
+
+  sf::UdpSocket m_socket;
+  sf::IpAddress m_peer;
+  unsigned short m_peerPort;
+
+  LinkConditions m_conditions;
+  Pcg32 m_rng;
+  std::vector<Delayed> m_delayed; // Ordered by queue time, not due time
+  std::array<std::uint8_t, MAX_PACKET> m_receiveBuffer;
+
+  Stats m_stats;
+};
@@ -1,35 +1,50 @@
 #pragma once
 
+#include "core/FrameArena.hpp"
 #include "core/GameState.hpp"
 #include "core/ScoreManager.hpp"
 #include <SFML/Graphics.hpp>
-#include <string>
 
 
 /**
  * Manages all UI elements: HUD, menus, and overlays
+ * Texts and shapes are built once and only restyled per frame; numbers are
+ * formatted into the frame arena, so drawing the UI does not allocate once
+ * the text buffers have grown to their longest strings.
  */
 class UIManager {
 public:
-  UIManager();
+  explicit UIManager(FrameArena &arena);
 
   // Initialize with window size
   bool init(unsigned int windowWidth, unsigned int windowHeight);
 
-  // Update animations
-  void update(float deltaTime);
+  // Animation phase, advanced by the simulation and set before rendering
+  static float advancePulse(float pulse, float deltaTime);
+  void setPulse(float pulse) { m_menuPulse = pulse; }
 
   // Render based on game state
-  void renderHUD(sf::RenderWindow &window, const ScoreManager &score,
+  void renderHUD(sf::RenderTarget &target, const ScoreManager &score,
                  float playerSpeed);
+  void renderRivalScore(sf::RenderTarget &target, std::uint64_t score);
   void renderMenu(sf::RenderWindow &window);
   void renderPauseOverlay(sf::RenderWindow &window);
   void renderGameOver(sf::RenderWindow &window, const ScoreManager &score);
 
 private:
-  void drawComboMeter(sf::RenderWindow &window, const ScoreManager &score);
-  void drawSpeedometer(sf::RenderWindow &window, float speed);
-  std::string formatScore(std::uint64_t score);
+  void drawComboMeter(sf::RenderTarget &target, const ScoreManager &score);
+  void drawSpeedometer(sf::RenderTarget &target, float speed);
+  // Replace a text's string without allocating (once its buffer has grown)
+  void setText(sf::Text &text, const char *ascii);
+  void centerText(sf::Text &text, float y);
+
+  static constexpr float COMBO_BAR_WIDTH = 200.0f;
+  static constexpr float COMBO_BAR_HEIGHT = 8.0f;
+  static constexpr sf::Vector2f COMBO_BAR_POSITION{20.0f, 100.0f};
+
+  // Per-frame scratch (owned by the game)
+  FrameArena &m_arena;
+  sf::String m_scratch; // Reused to build text strings
 
   // Font
   sf::Font m_font;
@@ -46,4 +61,23 @@ private:
   sf::Color m_neonCyan;
   sf::Color m_neonMagenta;
   sf::Color m_neonWhite;
+
+  // HUD
+  sf::Text m_scoreText;
+  sf::Text m_comboText;
+  sf::Text m_speedText;
+  sf::Text m_rivalText;
+  sf::RectangleShape m_comboBar;
+  sf::RectangleShape m_comboFill;
+
+  // Screens
+  sf::RectangleShape m_overlay;
+  sf::Text m_titleText;
+  sf::Text m_startText;
+  sf::Text m_controlsText;
+  sf::Text m_pausedText;
+  sf::Text m_resumeText;
+  sf::Text m_gameOverText;
+  sf::Text m_finalScoreText;
+  sf::Text m_restartText;
 };
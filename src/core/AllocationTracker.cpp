@@ -0,0 +1,153 @@
+#include "core/AllocationTracker.hpp"
+#include <cassert>
+#include <cstdio>
+
+namespace {
+
+// Plain thread-locals: no constructors, so operator new may touch them at
+// any point in a thread's life
+thread_local AllocationTracker::Counts t_counts;
+thread_local AllocTag t_tag = AllocTag::Other;
+
+} // namespace
+
+#ifdef NEONDRIFT_TRACK_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void count() { ++t_counts[static_cast<std::size_t>(t_tag)]; }
+
+void *allocate(std::size_t size) {
+  count();
+  void *memory = std::malloc(size ? size : 1);
+  if (!memory)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void *allocateAligned(std::size_t size, std::align_val_t alignment) {
+  count();
+  std::size_t align = static_cast<std::size_t>(alignment);
+  std::size_t bytes = size ? size : 1;
+#ifdef _MSC_VER
+  void *memory = _aligned_malloc(bytes, align);
+#else
+  // aligned_alloc wants a multiple of the alignment
+  void *memory = std::aligned_alloc(align, (bytes + align - 1) / align * align);
+#endif
+  if (!memory)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void freeAligned(void *memory) {
+#ifdef _MSC_VER
+  _aligned_free(memory);
+#else
+  std::free(memory);
+#endif
+}
+
+} // namespace
+
+// Replacing these covers the array and nothrow forms too, which call them
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete[](void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+void operator delete(void *memory, std::align_val_t) noexcept {
+  freeAligned(memory);
+}
+void operator delete[](void *memory, std::align_val_t) noexcept {
+  freeAligned(memory);
+}
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept {
+  freeAligned(memory);
+}
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept {
+  freeAligned(memory);
+}
+
+#endif
+
+AllocationTracker::Counts AllocationTracker::take() {
+  Counts counts = t_counts;
+  t_counts = Counts();
+  return counts;
+}
+
+AllocTag AllocationTracker::exchangeTag(AllocTag tag) {
+  AllocTag previous = t_tag;
+  t_tag = tag;
+  return previous;
+}
+
+const char *AllocationTracker::tagName(AllocTag tag) {
+  switch (tag) {
+  case AllocTag::Other:
+    return "other";
+  case AllocTag::Simulation:
+    return "simulation";
+  case AllocTag::Particles:
+    return "particles";
+  case AllocTag::Entities:
+    return "entities";
+  case AllocTag::Ui:
+    return "ui";
+  case AllocTag::Render:
+    return "render";
+  case AllocTag::Growth:
+    return "growth";
+  case AllocTag::Count:
+    break;
+  }
+  return "?";
+}
+
+void FrameAllocationCheck::endFrame(bool steady) {
+  if (!AllocationTracker::ENABLED)
+    return;
+
+  AllocationTracker::Counts counts = AllocationTracker::take();
+  if (!steady) {
+    m_steadyFrames = 0;
+    return;
+  }
+  if (m_steadyFrames < WARMUP_FRAMES) {
+    ++m_steadyFrames;
+    return;
+  }
+
+  std::uint32_t unexpected = 0;
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    if (static_cast<AllocTag>(i) != AllocTag::Growth)
+      unexpected += counts[i];
+  }
+  if (unexpected == 0)
+    return;
+
+  std::fprintf(stderr, "%s: %u heap allocations in a steady-state frame:",
+               m_loopName, unexpected);
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    if (counts[i] > 0)
+      std::fprintf(stderr, " %s %u",
+                   AllocationTracker::tagName(static_cast<AllocTag>(i)),
+                   counts[i]);
+  }
+  std::fprintf(stderr, "\n");
+  assert(unexpected == 0 && "steady-state frames must not allocate");
+}
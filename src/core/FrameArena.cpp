@@ -0,0 +1,45 @@
+#include "core/FrameArena.hpp"
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+FrameArena::FrameArena(std::size_t capacity)
+    : m_buffer(std::make_unique<unsigned char[]>(capacity)),
+      m_capacity(capacity), m_used(0), m_peak(0), m_failed(0) {}
+
+void *FrameArena::allocate(std::size_t bytes, std::size_t alignment) {
+  std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+  std::uintptr_t aligned =
+      (base + m_used + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+  std::size_t offset = static_cast<std::size_t>(aligned - base);
+  if (offset > m_capacity || bytes > m_capacity - offset) {
+    ++m_failed;
+    return nullptr;
+  }
+  m_used = offset + bytes;
+  return m_buffer.get() + offset;
+}
+
+const char *FrameArena::format(const char *pattern, ...) {
+  // Format straight into the free space, then keep only what was written
+  char *out = reinterpret_cast<char *>(m_buffer.get() + m_used);
+  std::size_t available = m_capacity - m_used;
+
+  va_list args;
+  va_start(args, pattern);
+  int length = std::vsnprintf(out, available, pattern, args);
+  va_end(args);
+
+  if (length < 0 || static_cast<std::size_t>(length) >= available) {
+    ++m_failed;
+    return "";
+  }
+  m_used += static_cast<std::size_t>(length) + 1;
+  return out;
+}
+
+void FrameArena::reset() {
+  if (m_used > m_peak)
+    m_peak = m_used;
+  m_used = 0;
+}
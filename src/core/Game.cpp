@@ -1,204 +1,499 @@
 #include "core/Game.hpp"
-#include <algorithm>
-#include <cmath>
-#include <random>
+#include <chrono>
+#include <cstdio>
 
-static std::random_device s_rd;
-static std::mt19937 s_rng(s_rd());
-static std::uniform_real_distribution<float> s_randFloat(-1.0f, 1.0f);
-
-Game::Game()
-    : m_window(sf::VideoMode({WINDOW_WIDTH, WINDOW_HEIGHT}), "Neon Drift",
+Game::Game(const GameOptions &options)
+    : m_options(options),
+      m_window(sf::VideoMode({WINDOW_WIDTH, WINDOW_HEIGHT}), "Neon Drift",
                sf::Style::Close | sf::Style::Titlebar),
-      m_currentState(GameState::Menu), m_pendingState(GameState::Menu),
-      m_stateChangeRequested(false), m_screenShake(0.0f, 0.0f),
-      m_shakeIntensity(0.0f), m_wasDrifting(false), m_accumulator(0.0f) {
-  m_window.setFramerateLimit(60);
+      m_windowFocused(true), m_frameCount(0),
+      m_particleBudget(1000.0f / FRAME_RATE), m_simRunning(false),
+      m_quitRequested(false), m_inputSequence(0),
+      m_session(m_simulation, m_link), m_renderWorkMs(0.0f),
+      m_particleDrawMs(0.0f), m_particleDrawTime(0.0f),
+      m_uiManager(m_frameArena), m_worldLayerAvailable(false),
+      m_resolution(1000.0f / FRAME_RATE), m_lastPresentNs(0),
+      m_frozenWorldAvailable(false), m_frozenWorldValid(false),
+      m_frozenStep(0), m_frozenState(GameState::Menu), m_idlePulse(0.0f) {
+  LogConfig log;
+  log.path = m_options.logPath;
+  log.level = m_options.logLevel;
+  Log::start(log);
+
+  m_window.setFramerateLimit(FRAME_RATE);
   m_uiManager.init(WINDOW_WIDTH, WINDOW_HEIGHT);
+  m_simulation.loadEffects("assets/effects/emitters.ini");
+  m_simulation.setParticlePool(m_options.particlePool);
+  m_simulation.startTelemetry();
+  m_simulation.enableRewind(REWIND_SECONDS);
+  if (!m_simulation.loadPhysics(m_options.physicsPath))
+    std::fprintf(stderr, "Using default handling: cannot read %s\n",
+                 m_options.physicsPath.string().c_str());
+  if (!m_options.recordPath.empty())
+    m_simulation.startRecording();
+  if (m_options.versus && !startVersus())
+    m_options.versus = false;
+  if (!m_options.capturePath.empty())
+    startCapture();
+
+  // Without render textures the background stays flat, there are no skid
+  // marks and the frozen world is simply redrawn each frame
+  m_background.init(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+  m_skidMarks.init(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+  m_frozenWorldAvailable = m_frozenWorld.resize({WINDOW_WIDTH, WINDOW_HEIGHT});
+
+  // The world layer is allocated once at full size; lower scales render
+  // into a corner of it, and filtering smooths the upscale
+  if (m_options.dynamicResolution) {
+    m_worldLayerAvailable = m_worldLayer.resize({WINDOW_WIDTH, WINDOW_HEIGHT});
+    m_worldLayer.setSmooth(true);
+  }
+}
+
+Game::~Game() {
+  stopSimulation();
+  Log::stop();
+}
+
+bool Game::startVersus() {
+  std::optional<sf::IpAddress> peer =
+      sf::IpAddress::resolve(m_options.peerHost);
+  if (!peer) {
+    std::fprintf(stderr, "Cannot resolve versus peer %s\n",
+                 m_options.peerHost.c_str());
+    return false;
+  }
+  if (!m_link.open(m_options.localPort, *peer, m_options.peerPort)) {
+    std::fprintf(stderr, "Cannot bind UDP port %u\n", m_options.localPort);
+    return false;
+  }
+
+  m_link.setConditions(m_options.network, m_options.versusSeed);
+  m_simulation.enableVersus(m_options.versusSlot, m_options.versusSeed);
+  return true;
+}
+
+void Game::startCapture() {
+  CaptureConfig config;
+  config.path = m_options.capturePath;
+  config.format = CaptureConfig::formatFor(config.path);
+  config.frameRate = FRAME_RATE;
+  if (!m_capture.start(config, {WINDOW_WIDTH, WINDOW_HEIGHT}))
+    std::fprintf(stderr, "Cannot write capture %s\n",
+                 m_options.capturePath.string().c_str());
+}
+
+void Game::printCaptureStats() const {
+  FrameCapture::Stats stats = m_capture.getStats();
+  double averageMs =
+      stats.captured > 0 ? stats.captureMs / stats.captured : 0.0;
+  std::printf("Capture: %llu frames written, %llu dropped; %.3f ms per "
+              "frame on the render thread (max %.3f)\n",
+              static_cast<unsigned long long>(stats.written),
+              static_cast<unsigned long long>(stats.dropped), averageMs,
+              stats.maxCaptureMs);
+}
+
+void Game::printVersusStats() const {
+  const RollbackSession::Stats &stats = m_session.getStats();
+  const UdpLink::Stats &link = m_link.getStats();
+  std::printf("Versus: %u ticks, %llu rollbacks (%llu ticks resimulated, "
+              "deepest %u), %llu stalled frames\n",
+              m_session.getTick(),
+              static_cast<unsigned long long>(stats.rollbacks),
+              static_cast<unsigned long long>(stats.resimulatedTicks),
+              stats.maxRollback, static_cast<unsigned long long>(stats.stalls));
+  std::printf("Checksums: %llu compared, %llu desyncs; packets: %llu sent, "
+              "%llu lost, %llu received\n",
+              static_cast<unsigned long long>(stats.checksums),
+              static_cast<unsigned long long>(stats.desyncs),
+              static_cast<unsigned long long>(link.sent),
+              static_cast<unsigned long long>(link.dropped),
+              static_cast<unsigned long long>(link.received));
 }
 
 void Game::run() {
+  m_simRunning = true;
+  m_simThread = std::thread(&Game::simulationLoop, this);
+
+  FrameAllocationCheck allocations("Render loop");
   while (m_window.isOpen()) {
-    // Calculate delta time
-    float deltaTime = m_clock.restart().asSeconds();
+    // Idle only once the simulation has applied every event we sent,
+    // otherwise a pending state change could be slept through
+    const FrameSnapshot &shown = m_snapshots.readBuffer();
+    sf::Time idleWait = sf::Time::Zero;
+    if (shown.idle && shown.inputSequence == m_inputSequence) {
+      bool animated = shown.state != GameState::Paused;
+      idleWait = sf::milliseconds(animated ? ANIMATED_IDLE_WAIT_MS
+                                           : STATIC_IDLE_WAIT_MS);
+    }
+
+    // Process window events (forwarded to the simulation thread)
+    processEvents(idleWait);
+
+    if (m_quitRequested) {
+      m_window.close();
+      break;
+    }
 
-    // Cap delta time to prevent spiral of death
-    deltaTime = std::min(deltaTime, 0.25f);
+    // Render the newest finished tick (or the previous one again); window
+    // event handling above is SFML's and not counted
+    allocations.beginFrame();
+    std::int64_t workStart = LatencyTracker::now();
+    m_snapshots.acquire();
+    const FrameSnapshot &snapshot = m_snapshots.readBuffer();
+    m_particleDrawTime = 0.0f;
+    render(snapshot);
+    if (snapshot.state == GameState::Playing)
+      m_capture.capture(m_window);
+    m_renderWorkMs.store((LatencyTracker::now() - workStart) * 1.0e-6f,
+                         std::memory_order_relaxed);
+    m_particleDrawMs.store(m_particleDrawTime, std::memory_order_relaxed);
+    m_window.display();
+
+    std::uint64_t frame = m_frameCount.load(std::memory_order_relaxed) + 1;
+    m_frameCount.store(frame, std::memory_order_relaxed);
+    std::int64_t presentNs = LatencyTracker::now();
+    m_latency.onDisplayed(snapshot.step, frame, presentNs);
+    updateResolution(snapshot.state, presentNs);
+    allocations.endFrame(snapshot.state == GameState::Playing);
+  }
 
-    // Process window events
-    processEvents();
+  stopSimulation();
 
-    // Handle any pending state changes
-    handleStateTransition();
+  if (m_capture.isRunning()) {
+    m_capture.stop();
+    printCaptureStats();
+  }
 
-    // Fixed timestep physics update
-    m_accumulator += deltaTime;
-    while (m_accumulator >= FIXED_TIMESTEP) {
-      update(FIXED_TIMESTEP);
-      m_accumulator -= FIXED_TIMESTEP;
-    }
+  if (!m_options.recordPath.empty() &&
+      !m_simulation.getRecording().save(m_options.recordPath))
+    std::fprintf(stderr, "Cannot write input recording %s\n",
+                 m_options.recordPath.string().c_str());
 
-    // Render
-    render();
+  if (m_options.reportLatency)
+    m_latency.print(stdout, 1000.0f / FRAME_RATE);
+
+  if (m_options.versus)
+    printVersusStats();
+}
+
+void Game::stopSimulation() {
+  {
+    std::lock_guard<std::mutex> lock(m_inputMutex);
+    m_simRunning = false;
   }
+  m_inputReady.notify_one();
+
+  if (m_simThread.joinable())
+    m_simThread.join();
 }
 
-void Game::processEvents() {
-  while (const auto event = m_window.pollEvent()) {
+void Game::processEvents(sf::Time idleWait) {
+  bool sentInput = false;
+
+  // When idle, sleep in waitEvent instead of spinning the loop
+  std::optional<sf::Event> event = idleWait != sf::Time::Zero
+                                       ? m_window.waitEvent(idleWait)
+                                       : m_window.pollEvent();
+  for (; event; event = m_window.pollEvent()) {
     if (event->is<sf::Event::Closed>()) {
       m_window.close();
       return;
     }
 
-    // Key pressed
-    if (const auto *keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-      m_inputManager.keyPressed(keyPressed->code);
-
-      // Escape key handling based on state
-      if (keyPressed->code == sf::Keyboard::Key::Escape) {
-        switch (m_currentState) {
-        case GameState::Menu:
-          m_window.close();
-          break;
-        case GameState::Playing:
-          m_pendingState = GameState::Paused;
-          m_stateChangeRequested = true;
-          break;
-        case GameState::Paused:
-          m_pendingState = GameState::Playing;
-          m_stateChangeRequested = true;
-          break;
-        case GameState::GameOver:
-          m_pendingState = GameState::Menu;
-          m_stateChangeRequested = true;
-          break;
-        }
-      }
+    if (event->is<sf::Event::FocusLost>())
+      m_windowFocused = false;
+    if (event->is<sf::Event::FocusGained>())
+      m_windowFocused = true;
 
-      // Enter to start game from menu
-      if (keyPressed->code == sf::Keyboard::Key::Enter) {
-        if (m_currentState == GameState::Menu) {
-          m_pendingState = GameState::Playing;
-          m_stateChangeRequested = true;
-        }
-        if (m_currentState == GameState::GameOver) {
-          m_player.reset();
-          m_scoreManager.reset();
-          m_particles.clear();
-          m_pendingState = GameState::Playing;
-          m_stateChangeRequested = true;
-        }
+    // Key events are applied by the simulation at its next tick; if the queue
+    // is full the simulation is stalled and dropping input is harmless
+    std::int64_t timestampNs = LatencyTracker::now();
+    std::uint64_t frame = m_frameCount.load(std::memory_order_relaxed);
+    if (const auto *keyPressed = event->getIf<sf::Event::KeyPressed>()) {
+      if (m_inputQueue.tryPush({timestampNs, frame, keyPressed->code, true})) {
+        ++m_inputSequence;
+        sentInput = true;
       }
     }
-
-    // Key released
     if (const auto *keyReleased = event->getIf<sf::Event::KeyReleased>()) {
-      m_inputManager.keyReleased(keyReleased->code);
+      if (m_inputQueue.tryPush(
+              {timestampNs, frame, keyReleased->code, false})) {
+        ++m_inputSequence;
+        sentInput = true;
+      }
     }
   }
-}
-
-void Game::handleStateTransition() {
-  if (m_stateChangeRequested) {
-    m_currentState = m_pendingState;
-    m_stateChangeRequested = false;
 
-    // Clear input on state change to prevent stuck keys
-    m_inputManager.clear();
+  // Wake the simulation if it is idling (taking the lock orders the push
+  // before its predicate check, so the wakeup cannot be lost)
+  if (sentInput) {
+    { std::lock_guard<std::mutex> lock(m_inputMutex); }
+    m_inputReady.notify_one();
   }
 }
 
-void Game::update(float deltaTime) {
-  // Update screen shake
-  if (m_shakeIntensity > 0.0f) {
-    m_shakeIntensity *= 0.9f; // Decay
-    m_screenShake.x = s_randFloat(s_rng) * m_shakeIntensity;
-    m_screenShake.y = s_randFloat(s_rng) * m_shakeIntensity;
-    if (m_shakeIntensity < 0.5f)
-      m_shakeIntensity = 0.0f;
-  }
+void Game::simulationLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto tickLength =
+      std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(
+          Simulation::FIXED_TIMESTEP));
+  const auto maxLag = std::chrono::milliseconds(250);
+
+  std::uint64_t inputSequence = 0;
+  auto nextTick = Clock::now();
+  FrameAllocationCheck allocations("Simulation loop");
+  while (m_simRunning) {
+    // The tick about to run is the one that consumes pending input
+    std::uint64_t tick = m_simulation.getStepCount() + 1;
+    std::int64_t tickNs = LatencyTracker::now();
+
+    // With late sampling the control keys are read from the keyboard below,
+    // so their window events are only counted, not applied
+    bool sampling = m_options.lateInputSampling && m_windowFocused &&
+                    m_simulation.getState() == GameState::Playing;
+
+    // Apply input received since the last tick
+    InputEvent input;
+    while (m_inputQueue.tryPop(input)) {
+      ++inputSequence;
+      if (sampling && InputManager::isControlKey(input.key))
+        continue;
+      m_simulation.handleKey(input.key, input.pressed);
+      m_latency.onConsumed(input.timestampNs, input.frame, tick, tickNs);
+    }
 
-  // Always update particles (even when paused for visual effect)
-  m_particles.update(deltaTime);
+    if (sampling)
+      sampleControls(tick, tickNs);
+
+    // Versus ticks may wait for the peer, or replay a few ticks first
+    AllocationScope scope(AllocTag::Simulation);
+    if (m_options.versus) {
+      m_session.advance(m_simulation.pollLocalControls());
+      if (m_session.isPeerLost()) {
+        ND_LOG(Error, "net", "Versus peer stopped responding");
+        m_quitRequested = true;
+        break;
+      }
+    } else {
+      m_simulation.step();
+    }
 
-  switch (m_currentState) {
-  case GameState::Menu:
-    m_uiManager.update(deltaTime);
-    break;
+    // Publish the finished tick for the render thread
+    FrameSnapshot &snapshot = m_snapshots.writeBuffer();
+    m_simulation.writeSnapshot(snapshot);
+    snapshot.inputSequence = inputSequence;
+    m_snapshots.publish();
 
-  case GameState::Playing:
-    m_player.update(deltaTime, m_inputManager);
-    m_uiManager.update(deltaTime);
+    if (m_options.adaptiveParticles &&
+        m_simulation.getState() == GameState::Playing)
+      updateParticleBudget((LatencyTracker::now() - tickNs) * 1.0e-6f);
+    allocations.endFrame(m_simulation.getState() == GameState::Playing);
 
-    // Update scoring
-    m_scoreManager.update(deltaTime, m_player.getSpeed(), m_player.isDrifting(),
-                          m_player.getDriftAmount());
+    if (m_simulation.isQuitRequested()) {
+      m_quitRequested = true;
+      break;
+    }
 
-    // Detect drift end for bonus
-    if (m_wasDrifting && !m_player.isDrifting()) {
-      m_scoreManager.onDriftEnd(m_player.getDriftAmount() * 2.0f,
-                                m_player.getSpeed());
+    // Nothing changes until the next key: sleep instead of ticking
+    if (m_simulation.isIdle()) {
+      std::unique_lock<std::mutex> lock(m_inputMutex);
+      m_inputReady.wait(lock, [this] {
+        return m_inputQueue.size() > 0 || !m_simRunning;
+      });
+      nextTick = Clock::now();
+      continue;
     }
-    m_wasDrifting = m_player.isDrifting();
 
-    // Emit drift particles when drifting
-    if (m_player.isDrifting() && m_player.getSpeed() > 100.0f) {
-      m_particles.emitDriftTrail(m_player.getPosition(), m_player.getVelocity(),
-                                 m_player.getDriftAmount(), 0.0f);
+    // Fixed tick schedule; if we fall too far behind (debugger, suspend),
+    // restart the schedule instead of spiralling through catch-up ticks
+    nextTick += tickLength;
+    auto now = Clock::now();
+    if (now - nextTick > maxLag) {
+      nextTick = now;
     }
+    std::this_thread::sleep_until(nextTick);
+  }
+}
 
-    // Emit speed lines at high speed
-    m_particles.emitSpeedLines(m_player.getPosition(), m_player.getSpeed(),
-                               m_player.getRotation());
-    break;
+void Game::updateParticleBudget(float simWorkMs) {
+  // The threads overlap, so the slower one sets the frame rate; count the
+  // particle work done on that thread
+  ParticleBudget::FrameCost cost;
+  float renderWorkMs = m_renderWorkMs.load(std::memory_order_relaxed);
+  if (renderWorkMs > simWorkMs) {
+    cost.frameMs = renderWorkMs;
+    cost.particleMs = m_particleDrawMs.load(std::memory_order_relaxed);
+  } else {
+    cost.frameMs = simWorkMs;
+    cost.particleMs = m_simulation.getParticleCostMs();
+  }
+  cost.liveParticles = m_simulation.getParticleCount();
+  m_simulation.setParticleBudget(m_particleBudget.update(cost));
+}
 
-  case GameState::Paused:
-    // Paused - no game updates
-    break;
+void Game::updateResolution(GameState state, std::int64_t presentNs) {
+  // Only consecutive Playing frames measure pacing; menus and pauses idle
+  if (!m_worldLayerAvailable || state != GameState::Playing) {
+    if (m_lastPresentNs != 0)
+      m_resolution.reset();
+    m_lastPresentNs = 0;
+    return;
+  }
+  if (m_lastPresentNs != 0)
+    m_resolution.update((presentNs - m_lastPresentNs) * 1.0e-6f);
+  m_lastPresentNs = presentNs;
+}
 
-  case GameState::GameOver:
-    // Game over screen logic
-    break;
+void Game::sampleControls(std::uint64_t tick, std::int64_t tickNs) {
+  // Read held state as late as possible; a transition seen here is measured
+  // from this poll, since its window event has not been delivered yet
+  std::uint64_t frame = m_frameCount.load(std::memory_order_relaxed);
+  for (sf::Keyboard::Key key : InputManager::CONTROL_KEYS) {
+    bool held = sf::Keyboard::isKeyPressed(key);
+    if (held == m_simulation.getInput().isKeyHeld(key))
+      continue;
+    m_simulation.handleKey(key, held);
+    m_latency.onConsumed(tickNs, frame, tick, tickNs);
   }
 }
 
-void Game::render() {
-  // Clear with deep purple/black neon background
-  m_window.clear(sf::Color(15, 5, 25));
+void Game::render(const FrameSnapshot &snapshot) {
+  AllocationScope scope(AllocTag::Render);
+
+  // Menus animate on the render thread while the simulation sleeps
+  float idleDelta = m_idleClock.restart().asSeconds();
+  if (snapshot.state == GameState::Playing) {
+    m_idlePulse = snapshot.uiPulse;
+    m_frozenWorldValid = false;
+  } else {
+    m_idlePulse = UIManager::advancePulse(m_idlePulse, idleDelta);
+  }
 
-  // Create view with screen shake offset
-  sf::View view = m_window.getDefaultView();
-  view.move(m_screenShake);
-  m_window.setView(view);
+  // Clear with deep purple/black neon background
+  m_window.clear(BackgroundLayer::BACKGROUND_COLOR);
+  m_window.setView(m_window.getDefaultView());
 
-  switch (m_currentState) {
-  case GameState::Menu:
+  switch (snapshot.state) {
+  case GameState::Menu: {
+    AllocationScope uiScope(AllocTag::Ui);
+    m_uiManager.setPulse(m_idlePulse);
     m_uiManager.renderMenu(m_window);
     break;
+  }
 
   case GameState::Playing:
-    m_particles.render(m_window);
-    m_player.render(m_window);
-    m_uiManager.renderHUD(m_window, m_scoreManager, m_player.getSpeed());
+    m_uiManager.setPulse(snapshot.uiPulse);
+    if (m_resolution.getScale() < 1.0f)
+      renderScaledWorld(snapshot);
+    else
+      renderWorld(m_window, snapshot, true);
     break;
 
   case GameState::Paused:
-    // Render game world (frozen) + pause overlay
-    m_particles.render(m_window);
-    m_player.render(m_window);
-    m_uiManager.renderHUD(m_window, m_scoreManager, m_player.getSpeed());
-    m_uiManager.renderPauseOverlay(m_window);
+    // Frozen game world + pause overlay
+    renderFrozenWorld(snapshot, true);
+    {
+      AllocationScope uiScope(AllocTag::Ui);
+      m_uiManager.renderPauseOverlay(m_window);
+    }
     break;
 
-  case GameState::GameOver:
-    m_particles.render(m_window);
-    m_player.render(m_window);
-    m_uiManager.renderGameOver(m_window, m_scoreManager);
+  case GameState::GameOver: {
+    renderFrozenWorld(snapshot, false);
+    AllocationScope uiScope(AllocTag::Ui);
+    m_uiManager.setPulse(m_idlePulse);
+    m_uiManager.renderGameOver(m_window, snapshot.score);
     break;
   }
+  }
 
-  // Reset view
-  m_window.setView(m_window.getDefaultView());
+  // Temporaries live until the frame is drawn
+  m_frameArena.reset();
+}
+
+void Game::renderWorld(sf::RenderTarget &target, const FrameSnapshot &snapshot,
+                       bool withHud, float scale) {
+  // World view follows the camera, offset by screen shake
+  sf::View view = target.getDefaultView();
+  view.setCenter(snapshot.cameraCenter + snapshot.screenShake);
+  view.setViewport(sf::FloatRect({0.0f, 0.0f}, {scale, scale}));
+  target.setView(view);
+  m_background.render(target, view);
+  m_skidMarks.update(view, snapshot.skids, snapshot.skidCount, snapshot.step);
+  m_skidMarks.render(target);
+
+  SfmlBackend backend(target);
+  std::int64_t particleStart = LatencyTracker::now();
+  {
+    AllocationScope scope(AllocTag::Particles);
+    m_commands.clear();
+    DriftRibbon::render(m_commands, snapshot.trailVertices,
+                        snapshot.trailVertexCount);
+    ParticleSystem::render(m_commands, snapshot.particleVertices,
+                           snapshot.particleVertexCount);
+    backend.draw(m_commands, view);
+  }
+  m_particleDrawTime += (LatencyTracker::now() - particleStart) * 1.0e-6f;
+  {
+    AllocationScope scope(AllocTag::Entities);
+    m_commands.clear();
+    m_entities.render(m_commands, snapshot.entities);
+    backend.draw(m_commands, view);
+  }
+
+  target.setView(target.getDefaultView());
+  if (withHud)
+    renderHud(target, snapshot);
+}
+
+void Game::renderHud(sf::RenderTarget &target, const FrameSnapshot &snapshot) {
+  // HUD in screen space
+  AllocationScope scope(AllocTag::Ui);
+  target.setView(target.getDefaultView());
+  m_uiManager.renderHUD(target, snapshot.score, snapshot.playerSpeed);
+  if (snapshot.versus)
+    m_uiManager.renderRivalScore(target, snapshot.opponentScore);
+}
+
+void Game::renderScaledWorld(const FrameSnapshot &snapshot) {
+  float scale = m_resolution.getScale();
+  m_worldLayer.clear(BackgroundLayer::BACKGROUND_COLOR);
+  renderWorld(m_worldLayer, snapshot, false, scale);
+  m_worldLayer.display();
+
+  // Stretch the rendered corner over the window (same rounding as the
+  // viewport), then draw the HUD at native resolution
+  sf::Vector2i size(static_cast<int>(WINDOW_WIDTH * scale + 0.5f),
+                    static_cast<int>(WINDOW_HEIGHT * scale + 0.5f));
+  sf::Sprite world(m_worldLayer.getTexture(), sf::IntRect({0, 0}, size));
+  world.setScale({static_cast<float>(WINDOW_WIDTH) / size.x,
+                  static_cast<float>(WINDOW_HEIGHT) / size.y});
+  m_window.draw(world);
+  renderHud(m_window, snapshot);
+}
+
+void Game::renderFrozenWorld(const FrameSnapshot &snapshot, bool withHud) {
+  if (!m_frozenWorldAvailable) {
+    m_uiManager.setPulse(snapshot.uiPulse);
+    renderWorld(m_window, snapshot, withHud);
+    return;
+  }
+
+  // Redraw the cache only when the frozen step or screen changes
+  if (!m_frozenWorldValid || m_frozenStep != snapshot.step ||
+      m_frozenState != snapshot.state) {
+    m_frozenWorld.clear(BackgroundLayer::BACKGROUND_COLOR);
+    m_uiManager.setPulse(snapshot.uiPulse);
+    renderWorld(m_frozenWorld, snapshot, withHud);
+    m_frozenWorld.display();
+
+    m_frozenWorldValid = true;
+    m_frozenStep = snapshot.step;
+    m_frozenState = snapshot.state;
+  }
 
-  m_window.display();
+  // Composite the cached frame 1:1 in window space
+  m_window.draw(sf::Sprite(m_frozenWorld.getTexture()));
 }
@@ -0,0 +1,14 @@
+#include "core/IniReader.hpp"
+
+namespace ini {
+
+std::string trim(const std::string &text) {
+  const char *whitespace = " \t\r\n";
+  std::size_t begin = text.find_first_not_of(whitespace);
+  if (begin == std::string::npos)
+    return "";
+  std::size_t end = text.find_last_not_of(whitespace);
+  return text.substr(begin, end - begin + 1);
+}
+
+} // namespace ini
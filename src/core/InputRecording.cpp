@@ -0,0 +1,78 @@
+#include "core/InputRecording.hpp"
+#include <fstream>
+#include <utility>
+
+namespace {
+
+// File header, followed by `runCount` runs
+struct RecordingHeader {
+  std::uint32_t magic;     // 'NDI1'
+  std::uint32_t tickRate;  // Ticks per second the controls were sampled at
+  std::uint32_t tickCount; // Ticks after expanding all runs
+  std::uint32_t runCount;
+};
+
+// Controls held for (length + 1) ticks
+struct RecordingRun {
+  std::uint8_t bits;
+  std::uint8_t reserved;
+  std::uint16_t length;
+};
+
+constexpr std::uint32_t RECORDING_MAGIC = 0x3149444E; // "NDI1" little-endian
+constexpr std::size_t MAX_RUN = 65536;
+
+} // namespace
+
+bool InputRecording::save(const std::filesystem::path &path) const {
+  std::vector<RecordingRun> runs;
+  std::size_t i = 0;
+  while (i < ticks.size()) {
+    std::size_t run = 1;
+    while (i + run < ticks.size() && ticks[i + run] == ticks[i] &&
+           run < MAX_RUN)
+      ++run;
+    runs.push_back({ticks[i].bits, 0, static_cast<std::uint16_t>(run - 1)});
+    i += run;
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file)
+    return false;
+
+  RecordingHeader header{RECORDING_MAGIC, tickRate,
+                         static_cast<std::uint32_t>(ticks.size()),
+                         static_cast<std::uint32_t>(runs.size())};
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(runs.data()),
+             static_cast<std::streamsize>(runs.size() * sizeof(RecordingRun)));
+  return static_cast<bool>(file);
+}
+
+bool InputRecording::load(const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  RecordingHeader header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      header.magic != RECORDING_MAGIC || header.runCount > header.tickCount)
+    return false;
+
+  std::vector<RecordingRun> runs(header.runCount);
+  if (!file.read(reinterpret_cast<char *>(runs.data()),
+                 static_cast<std::streamsize>(runs.size() *
+                                              sizeof(RecordingRun))))
+    return false;
+
+  std::vector<ControlInput> expanded;
+  expanded.reserve(header.tickCount);
+  for (const RecordingRun &run : runs) {
+    ControlInput controls;
+    controls.bits = run.bits;
+    expanded.insert(expanded.end(), std::size_t(run.length) + 1, controls);
+  }
+  if (expanded.size() != header.tickCount)
+    return false; // Truncated or corrupt
+
+  tickRate = header.tickRate;
+  ticks = std::move(expanded);
+  return true;
+}
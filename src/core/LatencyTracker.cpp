@@ -0,0 +1,102 @@
+#include "core/LatencyTracker.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+float toMs(std::int64_t ns) {
+  return static_cast<float>(std::max<std::int64_t>(ns, 0)) * 1e-6f;
+}
+
+LatencyPercentiles percentiles(std::vector<float> &values) {
+  LatencyPercentiles result;
+  if (values.empty())
+    return result;
+
+  result.p50 = percentile(values, 0.50f);
+  result.p90 = percentile(values, 0.90f);
+  result.p99 = percentile(values, 0.99f);
+  result.max = *std::max_element(values.begin(), values.end());
+  return result;
+}
+
+} // namespace
+
+void LatencyTracker::onDisplayed(std::uint64_t step, std::uint64_t frame,
+                                 std::int64_t displayNs) {
+  // Collect newly consumed inputs (oldest are dropped if the display stalls)
+  ConsumedInput input;
+  while (m_consumed.tryPop(input)) {
+    if (m_waitingCount == m_waiting.size()) {
+      std::copy(m_waiting.begin() + 1, m_waiting.end(), m_waiting.begin());
+      --m_waitingCount;
+    }
+    m_waiting[m_waitingCount++] = input;
+  }
+
+  // Complete every input whose tick is part of this frame
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < m_waitingCount; ++i) {
+    const ConsumedInput &pending = m_waiting[i];
+    if (pending.tick > step) {
+      m_waiting[kept++] = pending;
+      continue;
+    }
+
+    Sample &sample = m_samples[m_sampleCount % HISTORY];
+    sample.toTickMs = toMs(pending.tickNs - pending.inputNs);
+    sample.toDisplayMs = toMs(displayNs - pending.inputNs);
+    sample.frames = static_cast<std::uint32_t>(
+        frame > pending.inputFrame ? frame - pending.inputFrame : 0);
+    ++m_sampleCount;
+  }
+  m_waitingCount = kept;
+}
+
+LatencyReport LatencyTracker::report(float framePeriodMs) const {
+  LatencyReport result;
+  result.samples = std::min(m_sampleCount, HISTORY);
+  result.dropped = m_dropped.load(std::memory_order_relaxed);
+  if (result.samples == 0)
+    return result;
+
+  std::vector<float> toTick;
+  std::vector<float> toDisplay;
+  toTick.reserve(result.samples);
+  toDisplay.reserve(result.samples);
+
+  std::size_t withinFrame = 0;
+  for (std::size_t i = 0; i < result.samples; ++i) {
+    const Sample &sample = m_samples[i];
+    toTick.push_back(sample.toTickMs);
+    toDisplay.push_back(sample.toDisplayMs);
+    if (sample.toDisplayMs <= framePeriodMs)
+      ++withinFrame;
+    result.maxFrames = std::max(result.maxFrames, sample.frames);
+  }
+
+  result.inputToTick = percentiles(toTick);
+  result.inputToDisplay = percentiles(toDisplay);
+  result.withinOneFrame =
+      static_cast<float>(withinFrame) / static_cast<float>(result.samples);
+  return result;
+}
+
+void LatencyTracker::print(std::FILE *out, float framePeriodMs) const {
+  LatencyReport r = report(framePeriodMs);
+  std::fprintf(out, "Input latency (%zu samples, %zu dropped)\n", r.samples,
+               r.dropped);
+  if (r.samples == 0)
+    return;
+
+  auto row = [out](const char *label, const LatencyPercentiles &p) {
+    std::fprintf(out,
+                 "  %-17s p50 %6.2f ms  p90 %6.2f ms  p99 %6.2f ms  "
+                 "max %6.2f ms\n",
+                 label, p.p50, p.p90, p.p99, p.max);
+  };
+  row("input -> tick", r.inputToTick);
+  row("input -> display", r.inputToDisplay);
+  std::fprintf(out, "  within one frame (%.1f ms): %.1f%%, worst %u frames\n",
+               framePeriodMs, r.withinOneFrame * 100.0f, r.maxFrames);
+}
@@ -0,0 +1,260 @@
+#include "core/Log.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/SpscRing.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t RING_CAPACITY = 1024; // Per thread
+constexpr std::size_t BATCH_SIZE = 256;
+
+/**
+ * One thread's queue of records
+ * Shared with the registry so records queued just before the thread exits
+ * are still written; the writer forgets the buffer once it is released and
+ * empty.
+ */
+struct LogBuffer {
+  SpscRing<LogRecord, RING_CAPACITY> ring;
+  std::uint32_t thread = 0; // Registration order, shown in each line
+  std::atomic<bool> released{false};
+};
+
+/**
+ * Ties a buffer to its thread, releasing it when the thread exits
+ */
+struct ThreadBuffer {
+  std::shared_ptr<LogBuffer> buffer;
+  ~ThreadBuffer() {
+    if (buffer)
+      buffer->released.store(true, std::memory_order_release);
+  }
+};
+
+// Registration and the writer's pass over the buffers are the only
+// places that lock; pushing never does
+std::mutex s_registryMutex;
+std::vector<std::shared_ptr<LogBuffer>> s_buffers;
+std::uint32_t s_nextThread = 0;
+
+LogConfig s_config;
+std::thread s_writer;
+std::int64_t s_startNs = 0;
+std::atomic<std::uint64_t> s_dropped{0};
+
+thread_local ThreadBuffer t_buffer;
+
+LogBuffer &threadBuffer() {
+  if (!t_buffer.buffer) {
+    // Once per thread, whenever it first logs
+    AllocationScope scope(AllocTag::Growth);
+    auto buffer = std::make_shared<LogBuffer>();
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    buffer->thread = s_nextThread++;
+    s_buffers.push_back(buffer);
+    t_buffer.buffer = std::move(buffer);
+  }
+  return *t_buffer.buffer;
+}
+
+void appendArg(std::string &line, const LogRecord &record, std::size_t i) {
+  char text[32];
+  const auto &arg = record.args[i];
+  switch (record.types[i]) {
+  case LogRecord::ArgType::Int:
+    std::snprintf(text, sizeof(text), "%" PRId64, arg.i);
+    break;
+  case LogRecord::ArgType::Unsigned:
+    std::snprintf(text, sizeof(text), "%" PRIu64, arg.u);
+    break;
+  case LogRecord::ArgType::Float:
+    std::snprintf(text, sizeof(text), "%g", arg.f);
+    break;
+  case LogRecord::ArgType::Bool:
+    std::snprintf(text, sizeof(text), "%s", arg.u ? "true" : "false");
+    break;
+  case LogRecord::ArgType::Text:
+    line += arg.text ? arg.text : "(null)";
+    return;
+  }
+  line += text;
+}
+
+// "  12.345 WARN  [1] net: Checksum mismatch at tick 812"
+void formatRecord(std::string &line, const LogRecord &record,
+                  std::uint32_t thread) {
+  char prefix[64];
+  std::snprintf(prefix, sizeof(prefix), "%9.3f %-5s [%u] ",
+                (record.timestampNs - s_startNs) / 1e9,
+                Log::levelName(record.level), thread);
+  line.assign(prefix);
+  line += record.category;
+  line += ": ";
+
+  // Each "{}" takes the next argument; extra markers are kept as they are
+  std::size_t next = 0;
+  for (const char *c = record.format; *c; ++c) {
+    if (c[0] == '{' && c[1] == '}' && next < record.argCount) {
+      appendArg(line, record, next++);
+      ++c;
+    } else {
+      line += *c;
+    }
+  }
+  if (record.suppressed > 0)
+    line += " (+" + std::to_string(record.suppressed) + " suppressed)";
+  line += '\n';
+}
+
+} // namespace
+
+std::atomic<bool> Log::s_running{false};
+std::atomic<LogLevel> Log::s_level{LogLevel::Info};
+std::atomic<std::uint64_t> Log::s_written{0};
+
+bool Log::start(const LogConfig &config) {
+  if (s_running.load())
+    return true;
+
+  s_config = config;
+  s_startNs = now();
+  setLevel(config.level);
+  s_running.store(true);
+  s_writer = std::thread(&Log::writerLoop);
+  return true;
+}
+
+void Log::stop() {
+  if (!s_running.exchange(false))
+    return;
+  if (s_writer.joinable()) {
+    s_writer.join();
+  }
+}
+
+const char *Log::levelName(LogLevel level) {
+  switch (level) {
+  case LogLevel::Trace:
+    return "TRACE";
+  case LogLevel::Debug:
+    return "DEBUG";
+  case LogLevel::Info:
+    return "INFO";
+  case LogLevel::Warn:
+    return "WARN";
+  case LogLevel::Error:
+    return "ERROR";
+  default:
+    return "OFF";
+  }
+}
+
+bool Log::parseLevel(const char *name, LogLevel &level) {
+  static const char *const NAMES[] = {"trace", "debug", "info",
+                                      "warn",  "error", "off"};
+  for (std::size_t i = 0; i < std::size(NAMES); ++i) {
+    if (std::strcmp(name, NAMES[i]) == 0) {
+      level = static_cast<LogLevel>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::uint64_t Log::getDroppedCount() {
+  return s_dropped.load(std::memory_order_relaxed);
+}
+
+void Log::push(const LogRecord &record) {
+  if (!threadBuffer().ring.tryPush(record))
+    s_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Log::writerLoop() {
+  std::FILE *out = stderr;
+  if (!s_config.path.empty()) {
+    out = std::fopen(s_config.path.string().c_str(), "w");
+    if (!out) {
+      std::fprintf(stderr, "Cannot write log %s, using stderr\n",
+                   s_config.path.string().c_str());
+      out = stderr;
+    }
+  }
+
+  struct Pending {
+    LogRecord record;
+    std::uint32_t thread;
+  };
+  std::vector<std::shared_ptr<LogBuffer>> buffers;
+  std::vector<LogRecord> batch(BATCH_SIZE);
+  std::vector<Pending> pending;
+  std::string line;
+  std::uint64_t reportedDrops = 0;
+
+  auto drain = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(s_registryMutex);
+      buffers = s_buffers;
+    }
+
+    // Merge the threads' records in time order
+    pending.clear();
+    for (const std::shared_ptr<LogBuffer> &buffer : buffers) {
+      std::size_t count;
+      while ((count = buffer->ring.popBatch(batch.data(), batch.size())) > 0) {
+        for (std::size_t i = 0; i < count; ++i)
+          pending.push_back({batch[i], buffer->thread});
+      }
+    }
+    std::stable_sort(pending.begin(), pending.end(),
+                     [](const Pending &a, const Pending &b) {
+                       return a.record.timestampNs < b.record.timestampNs;
+                     });
+
+    for (const Pending &entry : pending) {
+      formatRecord(line, entry.record, entry.thread);
+      std::fwrite(line.data(), 1, line.size(), out);
+    }
+    s_written.fetch_add(pending.size(), std::memory_order_relaxed);
+
+    std::uint64_t dropped = s_dropped.load(std::memory_order_relaxed);
+    if (dropped > reportedDrops) {
+      std::fprintf(out, "%9.3f WARN  log: %" PRIu64 " messages dropped\n",
+                   (now() - s_startNs) / 1e9, dropped - reportedDrops);
+      reportedDrops = dropped;
+    }
+    if (!pending.empty())
+      std::fflush(out);
+
+    // Forget the buffers of threads that have exited, once drained
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    s_buffers.erase(
+        std::remove_if(s_buffers.begin(), s_buffers.end(),
+                       [](const std::shared_ptr<LogBuffer> &buffer) {
+                         return buffer->released.load(
+                                    std::memory_order_acquire) &&
+                                buffer->ring.size() == 0;
+                       }),
+        s_buffers.end());
+  };
+
+  // Poll on an interval instead of signalling, so the logging threads
+  // never pay for a wakeup
+  while (s_running.load(std::memory_order_relaxed)) {
+    drain();
+    std::this_thread::sleep_for(s_config.flushInterval);
+  }
+  drain();
+
+  if (out != stderr)
+    std::fclose(out);
+}
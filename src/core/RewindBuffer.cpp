@@ -0,0 +1,173 @@
+#include "core/RewindBuffer.hpp"
+#include "core/AllocationTracker.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/**
+ * Encode state XOR base over 8-byte words, collapsing unchanged words
+ * Token byte layout:
+ *   1xxxxxxx  run of (x + 1) unchanged words
+ *   0xxxxxxx  (x + 1) literal XORed words follow
+ * Bytes past the end of either buffer count as zero; a keyframe is
+ * encoded against an empty base
+ */
+void encodeDelta(const std::vector<std::uint8_t> &state,
+                 const std::vector<std::uint8_t> &base,
+                 std::vector<std::uint8_t> &out) {
+  constexpr std::size_t WORD = sizeof(std::uint64_t);
+  const std::size_t words = (state.size() + WORD - 1) / WORD;
+
+  auto wordAt = [](const std::vector<std::uint8_t> &bytes, std::size_t index) {
+    std::uint64_t value = 0;
+    std::size_t offset = index * WORD;
+    if (offset + WORD <= bytes.size())
+      std::memcpy(&value, bytes.data() + offset, WORD);
+    else if (offset < bytes.size())
+      std::memcpy(&value, bytes.data() + offset, bytes.size() - offset);
+    return value;
+  };
+
+  out.clear();
+  std::size_t i = 0;
+  while (i < words) {
+    std::uint64_t delta = wordAt(state, i) ^ wordAt(base, i);
+    std::size_t run = 1;
+    if (delta == 0) {
+      while (i + run < words && run < 128 &&
+             wordAt(state, i + run) == wordAt(base, i + run))
+        ++run;
+      out.push_back(static_cast<std::uint8_t>(0x80 | (run - 1)));
+    } else {
+      while (i + run < words && run < 128 &&
+             wordAt(state, i + run) != wordAt(base, i + run))
+        ++run;
+      out.push_back(static_cast<std::uint8_t>(run - 1));
+      std::size_t offset = out.size();
+      out.resize(offset + run * WORD);
+      for (std::size_t w = 0; w < run; ++w) {
+        std::uint64_t value = wordAt(state, i + w) ^ wordAt(base, i + w);
+        std::memcpy(out.data() + offset + w * WORD, &value, WORD);
+      }
+    }
+    i += run;
+  }
+}
+
+// Apply an encoded delta in place; state is resized to rawSize
+bool decodeDelta(const std::vector<std::uint8_t> &encoded,
+                 std::uint32_t rawSize, std::vector<std::uint8_t> &state) {
+  constexpr std::size_t WORD = sizeof(std::uint64_t);
+  const std::size_t words = (rawSize + WORD - 1) / WORD;
+  state.resize(words * WORD, 0); // Padded while decoding
+
+  std::size_t word = 0;
+  std::size_t i = 0;
+  while (i < encoded.size()) {
+    std::uint8_t token = encoded[i++];
+    std::size_t run = (token & 0x7F) + 1u;
+    if (word + run > words)
+      return false;
+    if ((token & 0x80) == 0) {
+      if (i + run * WORD > encoded.size())
+        return false;
+      for (std::size_t w = 0; w < run; ++w) {
+        std::uint64_t value, delta;
+        std::memcpy(&value, state.data() + (word + w) * WORD, WORD);
+        std::memcpy(&delta, encoded.data() + i + w * WORD, WORD);
+        value ^= delta;
+        std::memcpy(state.data() + (word + w) * WORD, &value, WORD);
+      }
+      i += run * WORD;
+    }
+    word += run;
+  }
+  state.resize(rawSize);
+  return word == words;
+}
+
+} // namespace
+
+RewindBuffer::RewindBuffer(std::size_t capacity)
+    : m_newest(0), m_count(0), m_sinceKeyframe(0) {
+  setCapacity(capacity);
+}
+
+void RewindBuffer::setCapacity(std::size_t capacity) {
+  m_slots.assign(capacity, Slot());
+  clear();
+}
+
+void RewindBuffer::clear() {
+  m_newest = 0;
+  m_count = 0;
+  m_sinceKeyframe = 0;
+  m_previous.clear();
+}
+
+std::size_t RewindBuffer::slotIndex(std::size_t back) const {
+  return (m_newest + m_slots.size() - back) % m_slots.size();
+}
+
+void RewindBuffer::push(const std::vector<std::uint8_t> &state) {
+  if (m_slots.empty())
+    return;
+
+  // Each slot keeps its buffer, growing it only for a larger capture
+  AllocationScope scope(AllocTag::Growth);
+  std::size_t index = m_count == 0 ? 0 : (m_newest + 1) % m_slots.size();
+  Slot &slot = m_slots[index];
+  slot.keyframe = m_count == 0 || m_sinceKeyframe + 1 >= KEYFRAME_INTERVAL;
+  slot.rawSize = static_cast<std::uint32_t>(state.size());
+
+  static const std::vector<std::uint8_t> EMPTY;
+  encodeDelta(state, slot.keyframe ? EMPTY : m_previous, slot.encoded);
+  m_sinceKeyframe = slot.keyframe ? 0 : m_sinceKeyframe + 1;
+
+  m_newest = index;
+  m_count = std::min(m_count + 1, m_slots.size());
+  m_previous.assign(state.begin(), state.end());
+}
+
+std::size_t RewindBuffer::size() const {
+  // Captures older than the oldest keyframe still held cannot be rebuilt
+  for (std::size_t back = m_count; back-- > 0;) {
+    if (m_slots[slotIndex(back)].keyframe)
+      return back + 1;
+  }
+  return 0;
+}
+
+bool RewindBuffer::rewind(std::size_t back, std::vector<std::uint8_t> &state) {
+  if (back >= size())
+    return false;
+
+  // Walk back to the keyframe, then replay deltas forward
+  std::size_t keyframe = back;
+  while (!m_slots[slotIndex(keyframe)].keyframe)
+    ++keyframe;
+
+  state.clear();
+  for (std::size_t b = keyframe + 1; b-- > back;) {
+    const Slot &slot = m_slots[slotIndex(b)];
+    if (!decodeDelta(slot.encoded, slot.rawSize, state)) {
+      clear();
+      return false;
+    }
+  }
+
+  // Continue the history from the restored capture
+  m_newest = slotIndex(back);
+  m_count -= back;
+  m_sinceKeyframe = keyframe - back;
+  m_previous.assign(state.begin(), state.end());
+  return true;
+}
+
+std::size_t RewindBuffer::getStoredBytes() const {
+  std::size_t bytes = 0;
+  for (std::size_t back = 0; back < m_count; ++back)
+    bytes += m_slots[slotIndex(back)].encoded.size();
+  return bytes;
+}
@@ -1,86 +1,139 @@
 #include "core/ScoreManager.hpp"
-#include <algorithm>
-#include <cmath>
+#include "core/Log.hpp"
 
-ScoreManager::ScoreManager()
-    : m_score(0), m_comboMultiplier(1.0f), m_comboTimer(0.0f),
-      m_driftMeter(0.0f), m_difficulty(0.0f), m_gameTime(0.0f) {}
+template <typename T>
+BasicScoreManager<T>::BasicScoreManager()
+    : m_score(0), m_pendingPoints(T(0.0f)), m_comboMultiplier(T(1.0f)),
+      m_comboTimer(T(0.0f)), m_driftMeter(T(0.0f)), m_difficulty(T(0.0f)),
+      m_gameTime(T(0.0f)) {}
 
-void ScoreManager::reset() {
+template <typename T> void BasicScoreManager<T>::reset() {
   m_score = 0;
-  m_comboMultiplier = 1.0f;
-  m_comboTimer = 0.0f;
-  m_driftMeter = 0.0f;
-  m_difficulty = 0.0f;
-  m_gameTime = 0.0f;
+  m_pendingPoints = T(0.0f);
+  m_comboMultiplier = T(1.0f);
+  m_comboTimer = T(0.0f);
+  m_driftMeter = T(0.0f);
+  m_difficulty = T(0.0f);
+  m_gameTime = T(0.0f);
 }
 
-void ScoreManager::update(float deltaTime, float playerSpeed, bool isDrifting,
-                          float driftAmount) {
+template <typename T>
+void BasicScoreManager<T>::saveState(StateWriter &writer) const {
+  writer.write(m_score);
+  writer.write(m_pendingPoints);
+  writer.write(m_comboMultiplier);
+  writer.write(m_comboTimer);
+  writer.write(m_driftMeter);
+  writer.write(m_difficulty);
+  writer.write(m_gameTime);
+}
+
+template <typename T>
+bool BasicScoreManager<T>::loadState(StateReader &reader) {
+  reader.read(m_score);
+  reader.read(m_pendingPoints);
+  reader.read(m_comboMultiplier);
+  reader.read(m_comboTimer);
+  reader.read(m_driftMeter);
+  reader.read(m_difficulty);
+  reader.read(m_gameTime);
+  return reader.ok();
+}
+
+template <typename T>
+void BasicScoreManager<T>::update(T deltaTime, T playerSpeed, bool isDrifting,
+                                  T driftAmount) {
   // Update game time and difficulty
   m_gameTime += deltaTime;
   updateDifficulty(deltaTime);
 
   // Update combo timer
-  if (m_comboTimer > 0.0f) {
+  if (m_comboTimer > T(0.0f)) {
     m_comboTimer -= deltaTime;
-    if (m_comboTimer <= 0.0f) {
+    if (m_comboTimer <= T(0.0f)) {
       // Combo expired
-      m_comboMultiplier = 1.0f;
-      m_comboTimer = 0.0f;
+      ND_LOG_EVERY(0.5, Debug, "score", "Combo x{} expired",
+                   getComboMultiplier());
+      m_comboMultiplier = T(1.0f);
+      m_comboTimer = T(0.0f);
     }
   }
 
   // Build drift meter while drifting
-  if (isDrifting && playerSpeed > 100.0f) {
-    m_driftMeter = std::min(1.0f, m_driftMeter + deltaTime * 0.5f);
+  if (isDrifting && playerSpeed > T(100.0f)) {
+    m_driftMeter = scalar::min(T(1.0f), m_driftMeter + deltaTime * T(0.5f));
 
     // Award continuous drift points
-    float speedBonus = playerSpeed / SPEED_BONUS_DIVISOR;
-    float points = BASE_DRIFT_SCORE * driftAmount * speedBonus *
-                   m_comboMultiplier * deltaTime;
-    addScore(static_cast<std::uint64_t>(points));
+    T speedBonus = playerSpeed / T(SPEED_BONUS_DIVISOR);
+    T points = T(BASE_DRIFT_SCORE) * driftAmount * speedBonus *
+               m_comboMultiplier * deltaTime;
+    addScore(points);
 
     // Keep combo alive while drifting
-    m_comboTimer = MAX_COMBO_TIME;
+    m_comboTimer = T(MAX_COMBO_TIME);
   } else {
     // Decay drift meter when not drifting
-    m_driftMeter = std::max(0.0f, m_driftMeter - deltaTime * 0.3f);
+    m_driftMeter = scalar::max(T(0.0f), m_driftMeter - deltaTime * T(0.3f));
   }
+
+  ND_LOG_EVERY(1.0, Trace, "score", "Score {}, combo x{}, drift meter {}",
+               m_score, getComboMultiplier(), getDriftMeter());
 }
 
-void ScoreManager::onDriftEnd(float driftDuration, float averageSpeed) {
-  if (driftDuration < 0.5f)
+template <typename T>
+void BasicScoreManager<T>::onDriftEnd(T driftDuration, T averageSpeed) {
+  if (driftDuration < T(0.5f))
     return; // Minimum drift time for bonus
 
   // Calculate drift bonus
-  float durationBonus = std::min(5.0f, driftDuration); // Cap at 5 seconds
-  float speedBonus = averageSpeed / SPEED_BONUS_DIVISOR;
-  float baseBonus = 100.0f * durationBonus * speedBonus;
+  T durationBonus = scalar::min(T(5.0f), driftDuration); // Cap at 5 seconds
+  T speedBonus = averageSpeed / T(SPEED_BONUS_DIVISOR);
+  T baseBonus = T(100.0f) * durationBonus * speedBonus;
 
   // Apply combo multiplier
-  std::uint64_t bonusPoints =
-      static_cast<std::uint64_t>(baseBonus * m_comboMultiplier);
-  addScore(bonusPoints);
+  addScore(baseBonus * m_comboMultiplier);
+  ND_LOG_EVERY(0.5, Debug, "score", "Drift bonus {} ({} s at x{})",
+               scalar::toFloat(baseBonus * m_comboMultiplier),
+               scalar::toFloat(driftDuration), getComboMultiplier());
 
   // Increase combo multiplier
-  m_comboMultiplier = std::min(8.0f, m_comboMultiplier + 0.5f);
-  m_comboTimer = MAX_COMBO_TIME;
+  m_comboMultiplier = scalar::min(T(8.0f), m_comboMultiplier + T(0.5f));
+  m_comboTimer = T(MAX_COMBO_TIME);
 }
 
-void ScoreManager::onCollision() {
+template <typename T> void BasicScoreManager<T>::onCollision() {
+  ND_LOG_EVERY(0.5, Debug, "score", "Combo x{} lost to a collision",
+               getComboMultiplier());
   // Reset combo on collision
-  m_comboMultiplier = 1.0f;
-  m_comboTimer = 0.0f;
-  m_driftMeter = 0.0f;
+  m_comboMultiplier = T(1.0f);
+  m_comboTimer = T(0.0f);
+  m_driftMeter = T(0.0f);
 }
 
-void ScoreManager::addScore(std::uint64_t points) { m_score += points; }
+template <typename T> void BasicScoreManager<T>::onComboPickup() {
+  // Same step as a drift bonus, without the points
+  m_comboMultiplier = scalar::min(T(8.0f), m_comboMultiplier + T(0.5f));
+  m_comboTimer = T(MAX_COMBO_TIME);
+}
 
-void ScoreManager::updateDifficulty(float deltaTime) {
+template <typename T> void BasicScoreManager<T>::addScore(T points) {
+  // Carry the fractional remainder so small per-tick awards still count
+  m_pendingPoints += points;
+  std::int64_t whole = scalar::floor(m_pendingPoints);
+  if (whole > 0) {
+    m_score += static_cast<std::uint64_t>(whole);
+    m_pendingPoints -= scalar::fromInt<T>(whole);
+  }
+}
+
+template <typename T>
+void BasicScoreManager<T>::updateDifficulty(T deltaTime) {
   // Slowly increase difficulty over time
-  if (m_difficulty < MAX_DIFFICULTY) {
-    m_difficulty += DIFFICULTY_INCREASE_RATE * deltaTime;
-    m_difficulty = std::min(MAX_DIFFICULTY, m_difficulty);
+  if (m_difficulty < T(MAX_DIFFICULTY)) {
+    m_difficulty += T(DIFFICULTY_INCREASE_RATE) * deltaTime;
+    m_difficulty = scalar::min(T(MAX_DIFFICULTY), m_difficulty);
   }
 }
+
+template class BasicScoreManager<float>;
+template class BasicScoreManager<Fixed>;
@@ -0,0 +1,683 @@
+#include "core/Simulation.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/LatencyTracker.hpp"
+#include "entities/Systems.hpp"
+#include "ui/UIManager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <system_error>
+
+// Seeds for unseeded simulations (per thread, they may run in parallel)
+static thread_local std::random_device s_rd;
+
+namespace {
+
+constexpr std::uint32_t STATE_MAGIC = 0x3153444E; // "NDS1" little-endian
+constexpr std::uint32_t STATE_VERSION = 1;
+
+constexpr std::uint32_t FNV_OFFSET = 2166136261u;
+constexpr std::uint32_t FNV_PRIME = 16777619u;
+
+// FNV-1a over a value's bytes (values are trivially copyable, unpadded)
+template <typename T> void hashValue(std::uint32_t &hash, const T &value) {
+  const auto *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+}
+
+} // namespace
+
+Simulation::Simulation() : Simulation(s_rd()) {}
+
+Simulation::Simulation(std::uint32_t seed)
+    : m_currentState(GameState::Menu), m_pendingState(GameState::Menu),
+      m_stateChangeRequested(false), m_quitRequested(false), m_stepCount(0),
+      m_recordingEnabled(false), m_botEnabled(false), m_spawner(seed),
+      m_versus(false), m_localSlot(0), m_screenShake(0.0f, 0.0f),
+      m_shakeIntensity(0.0f), m_shakeRng(std::uint64_t(seed) + 1),
+      m_uiPulse(0.0f), m_wasDrifting(false), m_tick(0), m_driftStartTick(0),
+      m_driftSpeedSum(0.0f), m_lastComboMultiplier(1.0f), m_speedHistogram{},
+      m_histogramTicks(0), m_profiling(false), m_rewindRequested(false) {
+  m_spawner.reserve(m_world);
+  m_particles.seed(std::uint64_t(seed) + 2);
+
+  // The player is an entity like any other; Player drives its components
+  m_playerEntity = createCar();
+  syncPlayerEntity();
+
+  saveState(m_initialState);
+}
+
+Entity Simulation::createCar() {
+  Entity car = m_world.create<Transform, Collider, Renderable>();
+  Collider *collider = m_world.get<Collider>(car);
+  collider->radius = SimScalar(18.0f);
+  collider->layer = CollisionLayer::Player;
+  collider->mask = CollisionLayer::Obstacle | CollisionLayer::PICKUPS;
+  Renderable *renderable = m_world.get<Renderable>(car);
+  renderable->shape = RenderShape::Vehicle;
+  renderable->size = 30.0f;
+  return car;
+}
+
+void Simulation::enableVersus(int localSlot, std::uint32_t seed) {
+  m_versus = true;
+  m_localSlot = localSlot == 0 ? 0 : 1;
+
+  // Shared randomness: both peers spawn the same layout
+  m_spawner = Spawner(seed);
+  m_shakeRng = Pcg32(std::uint64_t(seed) + 1);
+  m_particles.seed(std::uint64_t(seed) + 2);
+
+  m_opponent.entity = createCar();
+  m_player.setPosition({GRID_X[m_localSlot], GRID_Y});
+  m_opponent.player.setPosition({GRID_X[1 - m_localSlot], GRID_Y});
+  syncPlayerEntity();
+  syncOpponentEntity();
+
+  // No menu, pause or rewind: the match runs until someone quits
+  m_rewind.setCapacity(0);
+  m_currentState = GameState::Playing;
+  m_stateChangeRequested = false;
+  saveState(m_initialState);
+}
+
+void Simulation::loadEffects(const std::filesystem::path &path) {
+  m_particles.loadEmitters(path);
+
+  // Effects define the particle groups a state holds
+  saveState(m_initialState);
+  m_rewind.clear();
+}
+
+void Simulation::startTelemetry() { m_telemetry.start(); }
+
+bool Simulation::loadPhysics(const std::filesystem::path &path) {
+  m_physicsPath = path;
+  std::error_code ec;
+  m_physicsWriteTime = std::filesystem::last_write_time(path, ec);
+
+  PhysicsProfile profile;
+  if (!loadPhysicsProfile(path, profile))
+    return false;
+  m_player.setProfile(profile);
+  m_opponent.player.setProfile(profile);
+  return true;
+}
+
+void Simulation::pollPhysicsProfile() {
+  if (m_physicsPath.empty() || m_stepCount % PHYSICS_POLL_INTERVAL != 0)
+    return;
+
+  std::error_code ec;
+  auto writeTime = std::filesystem::last_write_time(m_physicsPath, ec);
+  if (ec || writeTime == m_physicsWriteTime)
+    return;
+
+  // A half-written file parses as a partial profile over the defaults; the
+  // editor's final write triggers another reload
+  m_physicsWriteTime = writeTime;
+  PhysicsProfile profile;
+  if (loadPhysicsProfile(m_physicsPath, profile)) {
+    m_player.setProfile(profile);
+    m_opponent.player.setProfile(profile);
+  }
+}
+
+void Simulation::enableBot(std::uint32_t seed) {
+  m_bot = BotDriver(seed);
+  m_botEnabled = true;
+}
+
+void Simulation::enableRewind(float seconds) {
+  m_rewind.setCapacity(static_cast<std::size_t>(seconds * TICK_RATE));
+}
+
+void Simulation::saveState(std::vector<std::uint8_t> &state) const {
+  // Reused buffers only allocate when a capture outgrows them
+  AllocationScope scope(AllocTag::Growth);
+  state.clear();
+  StateWriter writer(state);
+  writer.write(STATE_MAGIC);
+  writer.write(STATE_VERSION);
+  writer.write(static_cast<std::uint32_t>(sizeof(SimScalar)));
+
+  writer.write(m_currentState);
+  writer.write(m_pendingState);
+  writer.write(m_stateChangeRequested);
+  m_inputManager.saveState(writer);
+  m_bot.saveState(writer);
+
+  m_player.saveState(writer);
+  writer.write(m_playerEntity);
+  m_world.saveState(writer);
+  m_spawner.saveState(writer);
+  writer.write(m_cameraCenter);
+
+  writer.write(m_versus);
+  writer.write(m_localSlot);
+  m_opponent.player.saveState(writer);
+  writer.write(m_opponent.entity);
+  m_opponent.score.saveState(writer);
+  writer.write(m_opponent.wasDrifting);
+  m_opponent.trail.saveState(writer);
+
+  m_particles.saveState(writer);
+  m_trail.saveState(writer);
+  writer.write(m_screenShake);
+  writer.write(m_shakeIntensity);
+  writer.write(m_shakeRng);
+
+  m_scoreManager.saveState(writer);
+  writer.write(m_uiPulse);
+  writer.write(m_wasDrifting);
+
+  writer.write(m_tick);
+  writer.write(m_driftStartTick);
+  writer.write(m_driftSpeedSum);
+  writer.write(m_lastComboMultiplier);
+  writer.write(m_speedHistogram);
+  writer.write(m_histogramTicks);
+}
+
+bool Simulation::readState(StateReader &reader) {
+  reader.expect(STATE_MAGIC);
+  reader.expect(STATE_VERSION);
+  reader.expect(static_cast<std::uint32_t>(sizeof(SimScalar)));
+
+  reader.read(m_currentState);
+  reader.read(m_pendingState);
+  reader.read(m_stateChangeRequested);
+  m_inputManager.loadState(reader);
+  m_bot.loadState(reader);
+
+  m_player.loadState(reader);
+  reader.read(m_playerEntity);
+  m_world.loadState(reader);
+  m_spawner.loadState(reader);
+  reader.read(m_cameraCenter);
+
+  reader.expect(m_versus);
+  reader.expect(m_localSlot);
+  m_opponent.player.loadState(reader);
+  reader.read(m_opponent.entity);
+  m_opponent.score.loadState(reader);
+  reader.read(m_opponent.wasDrifting);
+  m_opponent.trail.loadState(reader);
+
+  m_particles.loadState(reader);
+  m_trail.loadState(reader);
+  reader.read(m_screenShake);
+  reader.read(m_shakeIntensity);
+  reader.read(m_shakeRng);
+
+  m_scoreManager.loadState(reader);
+  reader.read(m_uiPulse);
+  reader.read(m_wasDrifting);
+
+  reader.read(m_tick);
+  reader.read(m_driftStartTick);
+  reader.read(m_driftSpeedSum);
+  reader.read(m_lastComboMultiplier);
+  reader.read(m_speedHistogram);
+  reader.read(m_histogramTicks);
+  return reader.ok() && reader.atEnd();
+}
+
+bool Simulation::loadState(const std::vector<std::uint8_t> &state,
+                           bool keepHeldKeys) {
+  saveState(m_stateBackup);
+  InputManager held = m_inputManager;
+  StateReader reader(state.data(), state.size());
+  if (!readState(reader)) {
+    StateReader undo(m_stateBackup.data(), m_stateBackup.size());
+    readState(undo);
+    return false;
+  }
+
+  if (keepHeldKeys)
+    m_inputManager = held;
+  return true;
+}
+
+bool Simulation::rewind(std::size_t ticks) {
+  std::size_t available = m_rewind.size();
+  if (available < 2 || ticks == 0)
+    return false;
+
+  std::size_t back = std::min(ticks, available - 1);
+  if (!m_rewind.rewind(back, m_stateScratch))
+    return false;
+
+  // Keys held now stay held; only the world goes back
+  if (!loadState(m_stateScratch, true))
+    return false;
+
+  // The recording follows the timeline that is kept
+  if (m_recordingEnabled) {
+    std::size_t recorded = m_recording.ticks.size();
+    m_recording.ticks.resize(recorded - std::min(back, recorded));
+  }
+  return true;
+}
+
+void Simulation::restart() {
+  // Back to the initial state, but keep drawing fresh obstacle layouts
+  std::uint64_t spawnRng = m_spawner.getRngState();
+  loadState(m_initialState);
+  m_spawner.setRngState(spawnRng);
+  m_rewind.clear();
+}
+
+void Simulation::startRecording() {
+  m_recordingEnabled = true;
+  m_recording.tickRate = TICK_RATE;
+  m_recording.ticks.clear();
+  m_recording.ticks.reserve(RECORDING_RESERVE_TICKS);
+}
+
+void Simulation::handleKey(sf::Keyboard::Key key, bool pressed) {
+  // Key released
+  if (!pressed) {
+    m_inputManager.keyReleased(key);
+    return;
+  }
+
+  // Key pressed
+  m_inputManager.keyPressed(key);
+
+  // A versus match has no menu or pause to go back to, and no rewind
+  if (m_versus) {
+    if (key == sf::Keyboard::Key::Escape)
+      m_quitRequested = true;
+    return;
+  }
+
+  // Escape key handling based on state
+  if (key == sf::Keyboard::Key::Escape) {
+    switch (m_currentState) {
+    case GameState::Menu:
+      m_quitRequested = true;
+      break;
+    case GameState::Playing:
+      m_pendingState = GameState::Paused;
+      m_stateChangeRequested = true;
+      break;
+    case GameState::Paused:
+      m_pendingState = GameState::Playing;
+      m_stateChangeRequested = true;
+      break;
+    case GameState::GameOver:
+      m_pendingState = GameState::Menu;
+      m_stateChangeRequested = true;
+      break;
+    }
+  }
+
+  // Enter to start game from menu
+  if (key == sf::Keyboard::Key::Enter) {
+    if (m_currentState == GameState::Menu) {
+      m_pendingState = GameState::Playing;
+      m_stateChangeRequested = true;
+    }
+    if (m_currentState == GameState::GameOver) {
+      restart();
+      m_pendingState = GameState::Playing;
+      m_stateChangeRequested = true;
+    }
+  }
+
+  // Backspace rewinds play (applied at the next step)
+  if (key == sf::Keyboard::Key::Backspace &&
+      m_currentState == GameState::Playing)
+    m_rewindRequested = true;
+}
+
+void Simulation::step() {
+  // Handle any pending state changes
+  handleStateTransition();
+  pollPhysicsProfile();
+
+  if (m_rewindRequested) {
+    m_rewindRequested = false;
+    rewind(REWIND_TICKS);
+  }
+
+  update(FIXED_TIMESTEP, pollLocalControls(), ControlInput(), false);
+  ++m_stepCount;
+
+  // Capture the finished tick for rewinding
+  if (m_currentState == GameState::Playing && m_rewind.getCapacity() > 0) {
+    saveState(m_stateScratch);
+    m_rewind.push(m_stateScratch);
+  }
+}
+
+void Simulation::step(const ControlInput &controls) {
+  handleStateTransition();
+  update(FIXED_TIMESTEP, controls, ControlInput(), false);
+  ++m_stepCount;
+}
+
+ControlInput Simulation::pollLocalControls() {
+  if (m_botEnabled && m_currentState == GameState::Playing)
+    return m_bot.decide(m_player, m_world);
+  return m_inputManager.getControls();
+}
+
+void Simulation::stepVersus(const ControlInput &local,
+                            const ControlInput &opponent, bool resimulated) {
+  handleStateTransition();
+  update(FIXED_TIMESTEP, local, opponent, resimulated);
+  if (!resimulated)
+    ++m_stepCount;
+}
+
+void Simulation::handleStateTransition() {
+  if (m_stateChangeRequested) {
+    m_currentState = m_pendingState;
+    m_stateChangeRequested = false;
+
+    // Clear input on state change to prevent stuck keys
+    m_inputManager.clear();
+  }
+}
+
+void Simulation::update(float deltaTime, const ControlInput &local,
+                        const ControlInput &opponent, bool resimulated) {
+  // Simulation step in the simulation scalar (exact 1/60 for fixed-point)
+  constexpr SimScalar simDelta = scalar::fromRatio<SimScalar>(1, TICK_RATE);
+  std::int64_t phaseStart = m_profiling ? LatencyTracker::now() : 0;
+
+  switch (m_currentState) {
+  case GameState::Menu:
+    // Menu animation is driven by the renderer while the simulation idles
+    break;
+
+  case GameState::Playing:
+    // Update screen shake
+    if (m_shakeIntensity > 0.0f) {
+      m_shakeIntensity *= 0.9f; // Decay
+      float shakeX = m_shakeRng.nextFloat() * 2.0f - 1.0f;
+      float shakeY = m_shakeRng.nextFloat() * 2.0f - 1.0f;
+      m_screenShake.x = shakeX * m_shakeIntensity;
+      m_screenShake.y = shakeY * m_shakeIntensity;
+      if (m_shakeIntensity < 0.5f)
+        m_shakeIntensity = 0.0f;
+    }
+
+    {
+      AllocationScope scope(AllocTag::Particles);
+      m_particles.update(deltaTime);
+    }
+    endPhase(TickPhase::Particles, phaseStart);
+
+    if (m_recordingEnabled && !resimulated)
+      m_recording.ticks.push_back(local);
+    m_player.update(simDelta, local);
+    syncPlayerEntity();
+    endPhase(TickPhase::Player, phaseStart);
+
+    if (m_versus) {
+      updateOpponent(simDelta, opponent);
+    } else {
+      // World entities
+      AllocationScope scope(AllocTag::Entities);
+      m_spawner.update(m_world, simDelta, m_scoreManager.getSimDifficulty(),
+                       m_player.getSimPosition(), m_player.getSimHeading());
+      systems::integrateMotion(m_world, simDelta);
+      systems::updateLifetimes(m_world, simDelta);
+      resolveContacts(m_player, m_playerEntity, m_scoreManager, true);
+    }
+    endPhase(TickPhase::Entities, phaseStart);
+    m_uiPulse = UIManager::advancePulse(m_uiPulse, deltaTime);
+
+    // Update scoring (telemetry wants the drift state before this tick)
+    {
+      bool wasDrifting = m_wasDrifting;
+      scoreCar(m_player, m_scoreManager, m_wasDrifting, simDelta);
+      if (!resimulated)
+        recordTelemetry(wasDrifting);
+    }
+    endPhase(TickPhase::Scoring, phaseStart);
+
+    // Extend the drift ribbon while drifting, emit speed lines at high speed
+    {
+      AllocationScope scope(AllocTag::Particles);
+      updateTrail(m_player, m_trail, deltaTime);
+      m_particles.emitSpeedLines(m_player.getPosition(), m_player.getSpeed(),
+                                 m_player.getRotation());
+    }
+    endPhase(TickPhase::Effects, phaseStart);
+    break;
+
+  case GameState::Paused:
+    // Paused - world is frozen, no game updates
+    break;
+
+  case GameState::GameOver:
+    // Game over screen logic
+    break;
+  }
+}
+
+void Simulation::endPhase(TickPhase phase, std::int64_t &start) {
+  if (!m_profiling)
+    return;
+  std::int64_t end = LatencyTracker::now();
+  m_profile[phase] = static_cast<float>(end - start) * 1.0e-6f;
+  start = end;
+}
+
+void Simulation::updateOpponent(SimScalar deltaTime,
+                                const ControlInput &controls) {
+  Opponent &rival = m_opponent;
+  rival.player.update(deltaTime, controls);
+  syncOpponentEntity();
+
+  // Everything shared is processed in slot order, so both peers agree
+  // however their cars are assigned
+  bool localFirst = m_localSlot == 0;
+  Player &first = localFirst ? m_player : rival.player;
+  Player &second = localFirst ? rival.player : m_player;
+
+  // Spawn around both cars; the harder of the two difficulties wins
+  SimScalar difficulty = std::max(m_scoreManager.getSimDifficulty(),
+                                  rival.score.getSimDifficulty());
+  Vec2<SimScalar> center =
+      (first.getSimPosition() + second.getSimPosition()) * SimScalar(0.5f);
+  m_spawner.update(m_world, deltaTime, difficulty, center,
+                   first.getSimHeading());
+  systems::integrateMotion(m_world, deltaTime);
+  systems::updateLifetimes(m_world, deltaTime);
+
+  // Whoever touches a pickup first (by slot) takes it
+  if (localFirst) {
+    resolveContacts(m_player, m_playerEntity, m_scoreManager, true);
+    resolveContacts(rival.player, rival.entity, rival.score, false);
+  } else {
+    resolveContacts(rival.player, rival.entity, rival.score, false);
+    resolveContacts(m_player, m_playerEntity, m_scoreManager, true);
+  }
+
+  scoreCar(rival.player, rival.score, rival.wasDrifting, deltaTime);
+  updateTrail(rival.player, rival.trail, scalar::toFloat(deltaTime));
+}
+
+void Simulation::scoreCar(const Player &player, ScoreManager &score,
+                          bool &wasDrifting, SimScalar deltaTime) {
+  score.update(deltaTime, player.getSimSpeed(), player.isDrifting(),
+               player.getSimDriftAmount());
+
+  // Detect drift end for bonus
+  if (wasDrifting && !player.isDrifting()) {
+    score.onDriftEnd(player.getSimDriftAmount() * SimScalar(2.0f),
+                     player.getSimSpeed());
+  }
+  wasDrifting = player.isDrifting();
+}
+
+void Simulation::updateTrail(const Player &player, DriftRibbon &trail,
+                             float deltaTime) {
+  trail.update(deltaTime);
+  if (player.isDrifting() && player.getSpeed() > TRAIL_MIN_SPEED)
+    trail.addSample(player.getPosition(), player.getRotation(),
+                    player.getDriftAmount());
+  else
+    trail.breakTrail();
+}
+
+SkidSource Simulation::skidSource(const Player &player) {
+  SkidSource source;
+  source.position = player.getPosition();
+  source.rotation = player.getRotation();
+  if (player.isDrifting() && player.getSpeed() > TRAIL_MIN_SPEED)
+    source.intensity = player.getDriftAmount();
+  return source;
+}
+
+void Simulation::syncPlayerEntity() {
+  Transform *transform = m_world.get<Transform>(m_playerEntity);
+  transform->position = m_player.getSimPosition();
+  transform->rotation = m_player.getSimRotation();
+  m_world.get<Renderable>(m_playerEntity)->color = m_player.getFillColor();
+
+  // Camera follows the player
+  m_cameraCenter = m_player.getPosition();
+}
+
+void Simulation::syncOpponentEntity() {
+  Transform *transform = m_world.get<Transform>(m_opponent.entity);
+  transform->position = m_opponent.player.getSimPosition();
+  transform->rotation = m_opponent.player.getSimRotation();
+  m_world.get<Renderable>(m_opponent.entity)->color = OPPONENT_COLOR;
+}
+
+void Simulation::resolveContacts(Player &player, Entity entity,
+                                 ScoreManager &score, bool local) {
+  systems::Contact contacts[MAX_CONTACTS];
+  std::size_t count =
+      systems::findContacts(m_world, entity, contacts, MAX_CONTACTS);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const systems::Contact &contact = contacts[i];
+    if (contact.layer & CollisionLayer::Obstacle) {
+      player.applyImpact(SimScalar(IMPACT_SPEED_KEPT));
+      score.onCollision();
+      m_particles.emitCollisionBurst(contact.position, contact.color);
+      if (local)
+        m_shakeIntensity = IMPACT_SHAKE;
+    } else if (contact.layer & CollisionLayer::BoostPickup) {
+      player.applyBoost(SimScalar(BOOST_IMPULSE));
+    } else if (contact.layer & CollisionLayer::ComboPickup) {
+      score.onComboPickup();
+    }
+
+    // Everything a car touches is consumed
+    m_world.destroyDeferred(contact.entity);
+  }
+  m_world.flushDestroyed();
+
+  if (count == 0)
+    return;
+  if (local)
+    syncPlayerEntity();
+  else
+    syncOpponentEntity();
+}
+
+std::uint32_t Simulation::getVersusChecksum() const {
+  std::uint32_t hash = FNV_OFFSET;
+
+  // Cars and scores in slot order
+  const Player *cars[2] = {&m_player, &m_opponent.player};
+  const ScoreManager *scores[2] = {&m_scoreManager, &m_opponent.score};
+  if (m_localSlot == 1) {
+    std::swap(cars[0], cars[1]);
+    std::swap(scores[0], scores[1]);
+  }
+  for (int slot = 0; slot < 2; ++slot) {
+    hashValue(hash, cars[slot]->getSimPosition());
+    hashValue(hash, cars[slot]->getSimRotation());
+    hashValue(hash, cars[slot]->getSimSpeed());
+    hashValue(hash, scores[slot]->getScore());
+  }
+
+  // Spawned obstacles and pickups (their archetypes hold no cars, so the
+  // iteration order is the same on both peers)
+  hashValue(hash, m_spawner.getRngState());
+  m_world.each<Transform, Collider>([&hash](std::size_t count, const Entity *,
+                                            const Transform *transforms,
+                                            const Collider *colliders) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (colliders[i].layer & CollisionLayer::Player)
+        continue;
+      hashValue(hash, transforms[i].position);
+    }
+  });
+  return hash;
+}
+
+void Simulation::writeSnapshot(FrameSnapshot &snapshot) const {
+  snapshot.state = m_currentState;
+  snapshot.step = m_stepCount;
+  snapshot.cameraCenter = m_cameraCenter;
+  snapshot.screenShake = m_screenShake;
+  // Spawner pools and the cars bound the count, so this never reallocates
+  snapshot.entities.reserve(Spawner::CAPACITY + MAX_CARS);
+  systems::buildRenderList(m_world, snapshot.entities);
+  snapshot.playerSpeed = m_player.getSpeed();
+  snapshot.score = m_scoreManager;
+  snapshot.uiPulse = m_uiPulse;
+  snapshot.idle = isIdle();
+  snapshot.versus = m_versus;
+  snapshot.opponentScore = m_opponent.score.getScore();
+  snapshot.particleVertexCount =
+      m_particles.buildVertices(snapshot.particleVertices);
+  std::size_t trailCount = m_trail.appendVertices(snapshot.trailVertices, 0);
+  snapshot.trailVertexCount =
+      m_opponent.trail.appendVertices(snapshot.trailVertices, trailCount);
+  snapshot.skids[0] = skidSource(m_player);
+  snapshot.skids[1] = skidSource(m_opponent.player);
+  snapshot.skidCount = m_versus ? 2 : 1;
+}
+
+void Simulation::recordTelemetry(bool wasDrifting) {
+  ++m_tick;
+  float speed = m_player.getSpeed();
+
+  // Drift start/end with duration and average speed
+  if (m_player.isDrifting()) {
+    if (!wasDrifting) {
+      m_driftStartTick = m_tick;
+      m_driftSpeedSum = 0.0f;
+      m_telemetry.driftStart(m_tick, speed);
+    }
+    m_driftSpeedSum += speed;
+  } else if (wasDrifting) {
+    std::uint32_t driftTicks = std::max(1u, m_tick - m_driftStartTick);
+    m_telemetry.driftEnd(m_tick, driftTicks * FIXED_TIMESTEP,
+                         m_driftSpeedSum / driftTicks,
+                         m_scoreManager.getDriftMeter());
+  }
+
+  // Combo multiplier changes
+  float combo = m_scoreManager.getComboMultiplier();
+  if (combo != m_lastComboMultiplier) {
+    m_telemetry.comboChanged(m_tick, combo, m_lastComboMultiplier);
+    m_lastComboMultiplier = combo;
+  }
+
+  // Speed histogram and difficulty, reported once per interval
+  ++m_speedHistogram[Telemetry::speedBucket(speed)];
+  if (++m_histogramTicks >= HISTOGRAM_INTERVAL) {
+    m_telemetry.speedHistogram(m_tick, m_speedHistogram);
+    m_telemetry.difficulty(m_tick, m_scoreManager.getDifficulty());
+    std::fill(std::begin(m_speedHistogram), std::end(m_speedHistogram), 0);
+    m_histogramTicks = 0;
+  }
+}
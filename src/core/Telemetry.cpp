@@ -0,0 +1,167 @@
+#include "core/Telemetry.hpp"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+// Block header written before each compressed batch
+struct BlockHeader {
+  std::uint32_t magic;           // 'NDT1'
+  std::uint32_t recordCount;     // Records in this block
+  std::uint32_t rawBytes;        // Size after decompression
+  std::uint32_t compressedBytes; // Size of the payload that follows
+};
+
+constexpr std::uint32_t BLOCK_MAGIC = 0x3154444E; // "NDT1" little-endian
+constexpr std::size_t BATCH_SIZE = 1024;
+
+/**
+ * Compress a batch of records
+ * Each record is XORed with the previous one (consecutive records share most
+ * bytes), then runs of zero bytes are collapsed. Token byte layout:
+ *   1xxxxxxx  run of (x + 1) zero bytes
+ *   0xxxxxxx  (x + 1) literal bytes follow
+ */
+void compressBatch(const TelemetryRecord *records, std::size_t count,
+                   std::vector<std::uint8_t> &delta,
+                   std::vector<std::uint8_t> &out) {
+  const std::size_t recordSize = sizeof(TelemetryRecord);
+  delta.resize(count * recordSize);
+  std::memcpy(delta.data(), records, delta.size());
+  for (std::size_t i = delta.size(); i-- > recordSize;) {
+    delta[i] ^= delta[i - recordSize];
+  }
+
+  out.clear();
+  std::size_t i = 0;
+  while (i < delta.size()) {
+    if (delta[i] == 0) {
+      std::size_t run = 1;
+      while (i + run < delta.size() && delta[i + run] == 0 && run < 128)
+        ++run;
+      out.push_back(static_cast<std::uint8_t>(0x80 | (run - 1)));
+      i += run;
+    } else {
+      std::size_t run = 1;
+      while (i + run < delta.size() && delta[i + run] != 0 && run < 128)
+        ++run;
+      out.push_back(static_cast<std::uint8_t>(run - 1));
+      out.insert(out.end(), delta.begin() + i, delta.begin() + i + run);
+      i += run;
+    }
+  }
+}
+
+/**
+ * Appends blocks to size-capped files, deleting the oldest past the limit
+ */
+class RotatingFile {
+public:
+  explicit RotatingFile(const TelemetryConfig &config)
+      : m_config(config), m_sequence(0), m_bytesWritten(0) {
+    m_sessionId = std::chrono::duration_cast<std::chrono::seconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count();
+    std::error_code ec;
+    std::filesystem::create_directories(m_config.directory, ec);
+  }
+
+  void write(const BlockHeader &header, const std::vector<std::uint8_t> &data) {
+    if (!m_file.is_open() || m_bytesWritten >= m_config.maxFileBytes) {
+      rotate();
+    }
+    if (!m_file)
+      return; // Unwritable directory - telemetry is best effort
+
+    m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    m_file.write(reinterpret_cast<const char *>(data.data()),
+                 static_cast<std::streamsize>(data.size()));
+    m_file.flush();
+    m_bytesWritten += sizeof(header) + data.size();
+  }
+
+private:
+  std::filesystem::path pathFor(std::size_t sequence) const {
+    return m_config.directory / ("telemetry-" + std::to_string(m_sessionId) +
+                                 "-" + std::to_string(sequence) + ".ndt");
+  }
+
+  void rotate() {
+    m_file.close();
+    m_file.clear();
+
+    if (m_sequence >= m_config.maxFiles) {
+      std::error_code ec;
+      std::filesystem::remove(pathFor(m_sequence - m_config.maxFiles), ec);
+    }
+
+    m_file.open(pathFor(m_sequence++), std::ios::binary | std::ios::trunc);
+    m_bytesWritten = 0;
+  }
+
+  TelemetryConfig m_config;
+  long long m_sessionId;
+  std::size_t m_sequence;
+  std::size_t m_bytesWritten;
+  std::ofstream m_file;
+};
+
+} // namespace
+
+Telemetry::~Telemetry() { stop(); }
+
+bool Telemetry::start(const TelemetryConfig &config) {
+  if (m_running.load())
+    return true;
+
+  m_config = config;
+  m_running.store(true);
+  m_writer = std::thread(&Telemetry::writerLoop, this);
+
+  push(makeRecord(0, TelemetryEvent::SessionStart));
+  return true;
+}
+
+void Telemetry::stop() {
+  if (!m_running.exchange(false))
+    return;
+  if (m_writer.joinable()) {
+    m_writer.join();
+  }
+}
+
+void Telemetry::writerLoop() {
+  RotatingFile file(m_config);
+  std::vector<TelemetryRecord> batch(BATCH_SIZE);
+  std::vector<std::uint8_t> delta;
+  std::vector<std::uint8_t> compressed;
+
+  auto drain = [&]() {
+    std::size_t count;
+    while ((count = m_ring.popBatch(batch.data(), batch.size())) > 0) {
+      compressBatch(batch.data(), count, delta, compressed);
+
+      BlockHeader header;
+      header.magic = BLOCK_MAGIC;
+      header.recordCount = static_cast<std::uint32_t>(count);
+      header.rawBytes =
+          static_cast<std::uint32_t>(count * sizeof(TelemetryRecord));
+      header.compressedBytes = static_cast<std::uint32_t>(compressed.size());
+      file.write(header, compressed);
+
+      m_written.fetch_add(count, std::memory_order_relaxed);
+    }
+  };
+
+  // Poll on an interval instead of signalling, so the producer never pays
+  // for a wakeup
+  while (m_running.load(std::memory_order_relaxed)) {
+    drain();
+    std::this_thread::sleep_for(m_config.flushInterval);
+  }
+  drain();
+}
@@ -0,0 +1,150 @@
+#include "entities/BotDriver.hpp"
+
+BotDriver::BotDriver(std::uint32_t seed)
+    : m_rng(seed), m_hasWaypoint(false), m_drifting(false) {}
+
+void BotDriver::saveState(StateWriter &writer) const {
+  writer.write(m_rng);
+  writer.write(m_waypoint);
+  writer.write(m_hasWaypoint);
+  writer.write(m_drifting);
+}
+
+bool BotDriver::loadState(StateReader &reader) {
+  reader.read(m_rng);
+  reader.read(m_waypoint);
+  reader.read(m_hasWaypoint);
+  reader.read(m_drifting);
+  return reader.ok();
+}
+
+void BotDriver::nextWaypoint(const Player &player) {
+  const Vec2<SimScalar> &heading = player.getSimHeading();
+  Vec2<SimScalar> right(-heading.y, heading.x);
+  SimScalar ahead = scalar::uniform(m_rng, SimScalar(WAYPOINT_AHEAD_MIN),
+                                    SimScalar(WAYPOINT_AHEAD_MAX));
+  SimScalar lateral = scalar::uniform(m_rng, SimScalar(-WAYPOINT_LATERAL),
+                                      SimScalar(WAYPOINT_LATERAL));
+  m_waypoint = player.getSimPosition() + heading * ahead + right * lateral;
+  m_hasWaypoint = true;
+}
+
+bool BotDriver::findThreat(const Player &player, const EntityWorld &world,
+                           SimScalar &lateral) const {
+  const Vec2<SimScalar> &position = player.getSimPosition();
+  const Vec2<SimScalar> &heading = player.getSimHeading();
+  Vec2<SimScalar> right(-heading.y, heading.x);
+
+  bool found = false;
+  SimScalar nearest = SimScalar(LOOKAHEAD);
+  world.each<Transform, Collider>([&](std::size_t count, const Entity *,
+                                      const Transform *transforms,
+                                      const Collider *colliders) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if ((colliders[i].layer & CollisionLayer::Obstacle) == 0)
+        continue;
+
+      Vec2<SimScalar> offset = transforms[i].position - position;
+      SimScalar forward = offset.dot(heading);
+      if (forward <= SimScalar(0.0f) || forward >= nearest)
+        continue;
+
+      SimScalar side = offset.dot(right);
+      SimScalar reach = colliders[i].radius + SimScalar(CLEARANCE);
+      if (scalar::abs(side) >= reach)
+        continue;
+
+      nearest = forward;
+      lateral = side;
+      found = true;
+    }
+  });
+  return found;
+}
+
+bool BotDriver::findPickup(const Player &player, const EntityWorld &world,
+                           Vec2<SimScalar> &target) const {
+  const Vec2<SimScalar> &position = player.getSimPosition();
+  const Vec2<SimScalar> &heading = player.getSimHeading();
+
+  bool found = false;
+  SimScalar nearest = SimScalar(PICKUP_REACH) * SimScalar(PICKUP_REACH);
+  world.each<Transform, Collider>([&](std::size_t count, const Entity *,
+                                      const Transform *transforms,
+                                      const Collider *colliders) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if ((colliders[i].layer & CollisionLayer::PICKUPS) == 0)
+        continue;
+
+      Vec2<SimScalar> offset = transforms[i].position - position;
+      SimScalar distanceSq = offset.dot(offset);
+      if (offset.dot(heading) <= SimScalar(0.0f) || distanceSq >= nearest)
+        continue;
+
+      nearest = distanceSq;
+      target = transforms[i].position;
+      found = true;
+    }
+  });
+  return found;
+}
+
+ControlInput BotDriver::decide(const Player &player, const EntityWorld &world) {
+  const Vec2<SimScalar> &position = player.getSimPosition();
+  const Vec2<SimScalar> &heading = player.getSimHeading();
+  Vec2<SimScalar> right(-heading.y, heading.x);
+  SimScalar speed = player.getSimSpeed();
+
+  // Advance the racing line once the current point is reached or behind
+  if (m_hasWaypoint) {
+    Vec2<SimScalar> offset = m_waypoint - position;
+    SimScalar reached = SimScalar(WAYPOINT_REACHED);
+    if (offset.dot(offset) < reached * reached ||
+        offset.dot(heading) < SimScalar(0.0f))
+      m_hasWaypoint = false;
+  }
+  if (!m_hasWaypoint)
+    nextWaypoint(player);
+
+  Vec2<SimScalar> target = m_waypoint;
+  findPickup(player, world, target);
+
+  // Angle to the target as forward and lateral components (positive lateral
+  // is clockwise, the direction TurnRight rotates)
+  Vec2<SimScalar> toTarget = target - position;
+  SimScalar forward = toTarget.dot(heading);
+  SimScalar lateral = toTarget.dot(right);
+  SimScalar absLateral = scalar::abs(lateral);
+
+  bool behind = forward <= SimScalar(0.0f);
+
+  // Sharp corner at speed: drift into it and hold until it opens up
+  SimScalar driftAngle = SimScalar(m_drifting ? DRIFT_EXIT_ANGLE : DRIFT_ANGLE);
+  m_drifting = (behind || absLateral > forward * driftAngle) &&
+               speed > SimScalar(DRIFT_MIN_SPEED);
+
+  ControlInput controls;
+  controls.bits |= ControlInput::Accelerate;
+  if (m_drifting)
+    controls.bits |= ControlInput::Drift;
+
+  SimScalar threatSide;
+  if (findThreat(player, world, threatSide)) {
+    // Swerve to whichever side the obstacle is not on
+    controls.bits |= threatSide > SimScalar(0.0f) ? ControlInput::TurnLeft
+                                                 : ControlInput::TurnRight;
+    return controls;
+  }
+
+  if (behind || absLateral > forward * SimScalar(STEER_DEADZONE)) {
+    controls.bits |= lateral > SimScalar(0.0f) ? ControlInput::TurnRight
+                                               : ControlInput::TurnLeft;
+
+    // Target behind: brake so the turn tightens
+    if (behind && speed > SimScalar(BRAKE_SPEED)) {
+      controls.bits &= ~ControlInput::Accelerate;
+      controls.bits |= ControlInput::Brake;
+    }
+  }
+  return controls;
+}
@@ -0,0 +1,208 @@
+#include "entities/EntityWorld.hpp"
+
+void Archetype::reserve(std::size_t count) {
+  m_entities.reserve(count);
+  if (has<Transform>())
+    m_transforms.reserve(count);
+  if (has<Velocity>())
+    m_velocities.reserve(count);
+  if (has<Collider>())
+    m_colliders.reserve(count);
+  if (has<Renderable>())
+    m_renderables.reserve(count);
+  if (has<Lifetime>())
+    m_lifetimes.reserve(count);
+}
+
+std::size_t Archetype::push(Entity entity) {
+  m_entities.push_back(entity);
+  if (has<Transform>())
+    m_transforms.emplace_back();
+  if (has<Velocity>())
+    m_velocities.emplace_back();
+  if (has<Collider>())
+    m_colliders.emplace_back();
+  if (has<Renderable>())
+    m_renderables.emplace_back();
+  if (has<Lifetime>())
+    m_lifetimes.emplace_back();
+  return m_entities.size() - 1;
+}
+
+namespace {
+
+template <typename T>
+void swapRemoveRow(std::vector<T> &column, std::size_t row) {
+  if (column.empty())
+    return;
+  column[row] = column.back();
+  column.pop_back();
+}
+
+} // namespace
+
+Entity Archetype::swapRemove(std::size_t row) {
+  std::size_t last = m_entities.size() - 1;
+  Entity moved = row != last ? m_entities[last] : Entity();
+
+  swapRemoveRow(m_entities, row);
+  swapRemoveRow(m_transforms, row);
+  swapRemoveRow(m_velocities, row);
+  swapRemoveRow(m_colliders, row);
+  swapRemoveRow(m_renderables, row);
+  swapRemoveRow(m_lifetimes, row);
+  return moved;
+}
+
+void Archetype::clear() {
+  m_entities.clear();
+  m_transforms.clear();
+  m_velocities.clear();
+  m_colliders.clear();
+  m_renderables.clear();
+  m_lifetimes.clear();
+}
+
+void Archetype::saveState(StateWriter &writer) const {
+  writer.write(m_mask);
+  writer.writeVector(m_entities);
+  writer.writeVector(m_transforms);
+  writer.writeVector(m_velocities);
+  writer.writeVector(m_colliders);
+  writer.writeVector(m_renderables);
+  writer.writeVector(m_lifetimes);
+}
+
+bool Archetype::loadState(StateReader &reader) {
+  reader.expect(m_mask);
+  reader.readVector(m_entities);
+  reader.readVector(m_transforms);
+  reader.readVector(m_velocities);
+  reader.readVector(m_colliders);
+  reader.readVector(m_renderables);
+  reader.readVector(m_lifetimes);
+  return reader.ok();
+}
+
+Archetype &EntityWorld::archetypeFor(ComponentMask mask, std::uint32_t &index) {
+  // Few archetypes exist, a linear scan beats a map here
+  for (std::size_t i = 0; i < m_archetypes.size(); ++i) {
+    if (m_archetypes[i].getMask() == mask) {
+      index = static_cast<std::uint32_t>(i);
+      return m_archetypes[i];
+    }
+  }
+  index = static_cast<std::uint32_t>(m_archetypes.size());
+  m_archetypes.emplace_back(mask);
+  return m_archetypes.back();
+}
+
+Entity EntityWorld::create(ComponentMask mask) {
+  Entity entity;
+  if (!m_freeIndices.empty()) {
+    entity.index = m_freeIndices.back();
+    m_freeIndices.pop_back();
+  } else {
+    entity.index = static_cast<std::uint32_t>(m_records.size());
+    m_records.emplace_back();
+  }
+
+  Record &record = m_records[entity.index];
+  entity.generation = record.generation;
+
+  Archetype &archetype = archetypeFor(mask, record.archetype);
+  record.row = static_cast<std::uint32_t>(archetype.push(entity));
+  record.alive = true;
+  ++m_liveCount;
+  return entity;
+}
+
+void EntityWorld::destroy(Entity entity) {
+  if (!isAlive(entity))
+    return;
+
+  Record &record = m_records[entity.index];
+  Entity moved = m_archetypes[record.archetype].swapRemove(record.row);
+  if (moved.isValid())
+    m_records[moved.index].row = record.row;
+
+  record.alive = false;
+  ++record.generation; // Stale handles stop resolving
+  m_freeIndices.push_back(entity.index);
+  --m_liveCount;
+}
+
+void EntityWorld::flushDestroyed() {
+  for (Entity entity : m_pendingDestroy)
+    destroy(entity); // Duplicates are ignored (already dead)
+  m_pendingDestroy.clear();
+}
+
+bool EntityWorld::isAlive(Entity entity) const {
+  if (entity.index >= m_records.size())
+    return false;
+  const Record &record = m_records[entity.index];
+  return record.alive && record.generation == entity.generation;
+}
+
+void EntityWorld::reserve(ComponentMask mask, std::size_t count) {
+  std::uint32_t index = 0;
+  archetypeFor(mask, index).reserve(count);
+  m_records.reserve(m_records.size() + count);
+  m_freeIndices.reserve(m_records.capacity());
+  m_pendingDestroy.reserve(m_records.capacity());
+}
+
+void EntityWorld::clear() {
+  for (std::size_t i = 0; i < m_records.size(); ++i) {
+    Record &record = m_records[i];
+    if (record.alive) {
+      record.alive = false;
+      ++record.generation;
+      m_freeIndices.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  for (Archetype &archetype : m_archetypes)
+    archetype.clear();
+  m_pendingDestroy.clear();
+  m_liveCount = 0;
+}
+
+void EntityWorld::saveState(StateWriter &writer) const {
+  writer.write(static_cast<std::uint32_t>(m_archetypes.size()));
+  for (const Archetype &archetype : m_archetypes)
+    archetype.saveState(writer);
+  writer.writeVector(m_records);
+  writer.writeVector(m_freeIndices);
+  writer.write(static_cast<std::uint64_t>(m_liveCount));
+}
+
+bool EntityWorld::loadState(StateReader &reader) {
+  std::uint32_t archetypeCount = 0;
+  if (!reader.read(archetypeCount))
+    return false;
+
+  // Archetypes are only ever appended, so a saved world's archetypes are a
+  // prefix of (or extend) this one's
+  for (std::uint32_t i = 0; i < archetypeCount; ++i) {
+    if (i == m_archetypes.size()) {
+      ComponentMask mask = 0;
+      StateReader peek = reader;
+      if (!peek.read(mask))
+        return false;
+      m_archetypes.emplace_back(mask);
+    }
+    if (!m_archetypes[i].loadState(reader))
+      return false;
+  }
+  for (std::size_t i = archetypeCount; i < m_archetypes.size(); ++i)
+    m_archetypes[i].clear();
+
+  std::uint64_t liveCount = 0;
+  reader.readVector(m_records);
+  reader.readVector(m_freeIndices);
+  reader.read(liveCount);
+  m_liveCount = static_cast<std::size_t>(liveCount);
+  m_pendingDestroy.clear();
+  return reader.ok();
+}
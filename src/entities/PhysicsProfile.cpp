@@ -0,0 +1,53 @@
+#include "entities/PhysicsProfile.hpp"
+#include "core/IniReader.hpp"
+#include <sstream>
+
+namespace {
+
+struct ProfileKey {
+  const char *name;
+  float PhysicsProfile::*field;
+};
+
+const ProfileKey PROFILE_KEYS[] = {
+    {"max_speed", &PhysicsProfile::maxSpeed},
+    {"acceleration", &PhysicsProfile::acceleration},
+    {"brake_force", &PhysicsProfile::brakeForce},
+    {"reverse_factor", &PhysicsProfile::reverseFactor},
+    {"friction", &PhysicsProfile::friction},
+    {"drift_friction", &PhysicsProfile::driftFriction},
+    {"grip", &PhysicsProfile::grip},
+    {"drift_slide", &PhysicsProfile::driftSlide},
+    {"turn_speed", &PhysicsProfile::turnSpeed},
+    {"drift_turn_multiplier", &PhysicsProfile::driftTurnMultiplier},
+    {"min_speed_to_turn", &PhysicsProfile::minSpeedToTurn},
+    {"drift_build_rate", &PhysicsProfile::driftBuildRate},
+    {"stop_speed", &PhysicsProfile::stopSpeed},
+};
+
+} // namespace
+
+bool setPhysicsValue(PhysicsProfile &profile, const std::string &key,
+                     float value) {
+  for (const ProfileKey &entry : PROFILE_KEYS) {
+    if (key == entry.name) {
+      profile.*entry.field = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool loadPhysicsProfile(const std::filesystem::path &path,
+                        PhysicsProfile &profile) {
+  // Sections are only for readability here
+  return ini::read(
+      path, [](const std::string &) {},
+      [&](const std::string &, const std::string &key,
+          const std::string &value) {
+        std::istringstream ss(value);
+        float parsed;
+        if (ss >> parsed)
+          setPhysicsValue(profile, key, parsed);
+      });
+}
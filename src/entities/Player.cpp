@@ -1,144 +1,182 @@
 #include "entities/Player.hpp"
-#include <cmath>
+#include "core/Log.hpp"
 #include <cstdint>
 
-// Helper to convert degrees to radians
-constexpr float DEG_TO_RAD = 3.14159265f / 180.0f;
-
-Player::Player()
-    : m_position(640.0f, 400.0f) // Center of screen
+template <typename T>
+BasicPlayer<T>::BasicPlayer(const PhysicsProfile &profile)
+    : m_position(T(640.0f), T(400.0f)) // Center of screen
       ,
-      m_velocity(0.0f, 0.0f), m_rotation(-90.0f) // Facing up
+      m_velocity(T(0.0f), T(0.0f)), m_rotation(T(-90.0f)) // Facing up
       ,
-      m_angularVelocity(0.0f), m_isDrifting(false), m_driftAmount(0.0f),
-      m_driftDirection(0.0f), m_baseColor(0, 255, 255) // Cyan
+      m_angularVelocity(T(0.0f)), m_isDrifting(false), m_driftAmount(T(0.0f)),
+      m_driftDirection(T(0.0f)), m_fillColor(0, 255, 255),
+      m_baseColor(0, 255, 255) // Cyan
       ,
       m_glowColor(255, 0, 255) // Magenta
-{
-  // Create arrow/car shaped polygon
-  m_shape.setPointCount(5);
-  m_shape.setPoint(0, sf::Vector2f(30.0f, 0.0f));    // Front tip
-  m_shape.setPoint(1, sf::Vector2f(-15.0f, -18.0f)); // Back left outer
-  m_shape.setPoint(2, sf::Vector2f(-8.0f, 0.0f));    // Back center indent
-  m_shape.setPoint(3, sf::Vector2f(-15.0f, 18.0f));  // Back right outer
-  m_shape.setPoint(4, sf::Vector2f(30.0f, 0.0f));    // Close to front
-
-  m_shape.setFillColor(m_baseColor);
-  m_shape.setOutlineColor(sf::Color::White);
-  m_shape.setOutlineThickness(2.0f);
-  m_shape.setOrigin(sf::Vector2f(0.0f, 0.0f));
+      ,
+      m_physics(profile) {
+  updateHeading();
+}
+
+template <typename T> void BasicPlayer<T>::reset() {
+  m_position = Vec2<T>(T(640.0f), T(400.0f));
+  m_velocity = Vec2<T>(T(0.0f), T(0.0f));
+  m_rotation = T(-90.0f);
+  m_angularVelocity = T(0.0f);
+  m_isDrifting = false;
+  m_driftAmount = T(0.0f);
+  m_driftDirection = T(0.0f);
+  updateHeading();
 }
 
-void Player::reset() {
-  m_position = sf::Vector2f(640.0f, 400.0f);
-  m_velocity = sf::Vector2f(0.0f, 0.0f);
-  m_rotation = -90.0f;
-  m_angularVelocity = 0.0f;
+template <typename T> void BasicPlayer<T>::applyImpact(T keepFraction) {
+  ND_LOG_EVERY(0.5, Debug, "player", "Impact at {} px/s, keeping {}",
+               getSpeed(), scalar::toFloat(keepFraction));
+  m_velocity = m_velocity * keepFraction;
   m_isDrifting = false;
-  m_driftAmount = 0.0f;
-  m_driftDirection = 0.0f;
+  m_driftAmount = T(0.0f);
+}
+
+template <typename T> void BasicPlayer<T>::applyBoost(T impulse) {
+  // Speed is clamped to the max speed again by the next physics step
+  m_velocity += m_heading * impulse;
+}
+
+template <typename T>
+void BasicPlayer<T>::saveState(StateWriter &writer) const {
+  writer.write(m_position);
+  writer.write(m_velocity);
+  writer.write(m_rotation);
+  writer.write(m_heading);
+  writer.write(m_angularVelocity);
+  writer.write(m_isDrifting);
+  writer.write(m_driftAmount);
+  writer.write(m_driftDirection);
+  writer.write(m_fillColor);
+}
+
+template <typename T> bool BasicPlayer<T>::loadState(StateReader &reader) {
+  reader.read(m_position);
+  reader.read(m_velocity);
+  reader.read(m_rotation);
+  reader.read(m_heading);
+  reader.read(m_angularVelocity);
+  reader.read(m_isDrifting);
+  reader.read(m_driftAmount);
+  reader.read(m_driftDirection);
+  reader.read(m_fillColor);
+  return reader.ok();
 }
 
-float Player::getSpeed() const {
-  return std::sqrt(m_velocity.x * m_velocity.x + m_velocity.y * m_velocity.y);
+template <typename T> void BasicPlayer<T>::updateHeading() {
+  scalar::sinCosDeg(m_rotation, m_heading.y, m_heading.x);
 }
 
-void Player::update(float deltaTime, const InputManager &input) {
+template <typename T>
+void BasicPlayer<T>::update(T deltaTime, const ControlInput &input) {
   applyInput(input, deltaTime);
   applyPhysics(deltaTime);
   updateVisuals();
 }
 
-void Player::applyInput(const InputManager &input, float deltaTime) {
-  float speed = getSpeed();
+template <typename T>
+void BasicPlayer<T>::applyInput(const ControlInput &input, T deltaTime) {
+  T speed = getSimSpeed();
 
-  // Get forward direction from rotation
-  float radians = m_rotation * DEG_TO_RAD;
-  sf::Vector2f forward(std::cos(radians), std::sin(radians));
+  const Vec2<T> &forward = m_heading;
 
   // Acceleration
   if (input.isAccelerating()) {
-    m_velocity += forward * ACCELERATION * deltaTime;
+    m_velocity += forward * (m_physics.acceleration * deltaTime);
   }
 
   // Braking
   if (input.isBraking()) {
     // If moving forward, slow down
     // If stopped, reverse slowly
-    float forwardDot = m_velocity.x * forward.x + m_velocity.y * forward.y;
+    T forwardDot = m_velocity.dot(forward);
 
-    if (forwardDot > 10.0f) {
-      m_velocity -= forward * BRAKE_FORCE * deltaTime;
+    if (forwardDot > T(10.0f)) {
+      m_velocity -= forward * (m_physics.brakeForce * deltaTime);
     } else {
       // Reverse (slower)
-      m_velocity -= forward * (ACCELERATION * 0.4f) * deltaTime;
+      m_velocity -= forward * (m_physics.reverseAcceleration * deltaTime);
     }
   }
 
   // Steering (only when moving)
-  if (speed > MIN_SPEED_TO_TURN) {
-    float turnMultiplier = m_isDrifting ? DRIFT_TURN_MULTIPLIER : 1.0f;
+  if (speed > m_physics.minSpeedToTurn) {
+    T turnRate =
+        m_isDrifting ? m_physics.driftTurnSpeed : m_physics.turnSpeed;
 
     if (input.isTurningLeft()) {
-      m_rotation -= TURN_SPEED * turnMultiplier * deltaTime;
+      m_rotation -= turnRate * deltaTime;
     }
     if (input.isTurningRight()) {
-      m_rotation += TURN_SPEED * turnMultiplier * deltaTime;
+      m_rotation += turnRate * deltaTime;
     }
 
     // Track drift direction
     if (input.isTurningLeft())
-      m_driftDirection = -1.0f;
+      m_driftDirection = T(-1.0f);
     else if (input.isTurningRight())
-      m_driftDirection = 1.0f;
-  }
+      m_driftDirection = T(1.0f);
 
-  // Keep rotation in bounds
-  while (m_rotation > 360.0f)
-    m_rotation -= 360.0f;
-  while (m_rotation < 0.0f)
-    m_rotation += 360.0f;
+    if (input.isTurningLeft() != input.isTurningRight()) {
+      // Keep rotation in bounds (less than one turn per tick)
+      if (m_rotation >= T(360.0f))
+        m_rotation -= T(360.0f);
+      else if (m_rotation < T(0.0f))
+        m_rotation += T(360.0f);
+
+      updateHeading();
+    }
+  }
 
   // Drift activation
-  bool wantsToDrift = input.isDrifting() && speed > MIN_SPEED_TO_TURN * 2;
+  bool wantsToDrift = input.isDrifting() && speed > m_physics.minSpeedToDrift;
 
   if (wantsToDrift && !m_isDrifting) {
     // Start drifting
+    ND_LOG_EVERY(0.5, Debug, "player", "Drift started at {} px/s",
+                 scalar::toFloat(speed));
     m_isDrifting = true;
-    m_driftAmount = 0.0f;
+    m_driftAmount = T(0.0f);
   } else if (!wantsToDrift && m_isDrifting) {
     // End drift
     m_isDrifting = false;
-    m_driftAmount = 0.0f;
+    m_driftAmount = T(0.0f);
   }
 
   // Build up drift amount while drifting
   if (m_isDrifting) {
-    m_driftAmount = std::min(1.0f, m_driftAmount + deltaTime * 2.0f);
+    m_driftAmount = scalar::min(
+        T(1.0f), m_driftAmount + deltaTime * m_physics.driftBuildRate);
+    ND_LOG_EVERY(1.0, Trace, "player", "Drifting at {} px/s, amount {}",
+                 scalar::toFloat(speed), getDriftAmount());
   }
 }
 
-void Player::applyPhysics(float deltaTime) {
+template <typename T> void BasicPlayer<T>::applyPhysics(T deltaTime) {
   // Speed limit
-  float speed = getSpeed();
-  if (speed > MAX_SPEED) {
-    float scale = MAX_SPEED / speed;
+  T speed = getSimSpeed();
+  if (speed > m_physics.maxSpeed) {
+    T scale = m_physics.maxSpeed / speed;
     m_velocity.x *= scale;
     m_velocity.y *= scale;
   }
 
   // Get forward and right directions
-  float radians = m_rotation * DEG_TO_RAD;
-  sf::Vector2f forward(std::cos(radians), std::sin(radians));
-  sf::Vector2f right(-std::sin(radians), std::cos(radians));
+  const Vec2<T> &forward = m_heading;
+  Vec2<T> right(-m_heading.y, m_heading.x);
 
   // Decompose velocity into forward and lateral components
-  float forwardSpeed = m_velocity.x * forward.x + m_velocity.y * forward.y;
-  float lateralSpeed = m_velocity.x * right.x + m_velocity.y * right.y;
+  T forwardSpeed = m_velocity.dot(forward);
+  T lateralSpeed = m_velocity.dot(right);
 
   // Apply different friction based on drift state
-  float friction = m_isDrifting ? DRIFT_FRICTION : FRICTION;
-  float lateralFriction = m_isDrifting ? DRIFT_SLIDE_FACTOR : 0.9f;
+  T friction = m_isDrifting ? m_physics.driftFriction : m_physics.friction;
+  T lateralFriction = m_isDrifting ? m_physics.driftSlide : m_physics.grip;
 
   // Apply friction
   forwardSpeed *= friction;
@@ -151,32 +189,31 @@ void Player::applyPhysics(float deltaTime) {
   m_position += m_velocity * deltaTime;
 
   // Very low speed = stop completely (prevent jittering)
-  if (getSpeed() < 5.0f && !m_isDrifting) {
-    m_velocity = sf::Vector2f(0.0f, 0.0f);
+  if (getSimSpeed() < m_physics.stopSpeed && !m_isDrifting) {
+    m_velocity = Vec2<T>(T(0.0f), T(0.0f));
   }
 }
 
-void Player::updateVisuals() {
-  m_shape.setPosition(m_position);
-  m_shape.setRotation(sf::degrees(m_rotation));
-
+template <typename T> void BasicPlayer<T>::updateVisuals() {
   // Color shift based on drift and speed
   if (m_isDrifting) {
     // Blend towards magenta when drifting
-    float blend = m_driftAmount;
+    float blend = getDriftAmount();
     std::uint8_t r = static_cast<std::uint8_t>(m_baseColor.r * (1.0f - blend) +
                                                m_glowColor.r * blend);
     std::uint8_t g = static_cast<std::uint8_t>(m_baseColor.g * (1.0f - blend) +
                                                m_glowColor.g * blend);
     std::uint8_t b = static_cast<std::uint8_t>(m_baseColor.b * (1.0f - blend) +
                                                m_glowColor.b * blend);
-    m_shape.setFillColor(sf::Color(r, g, b));
+    m_fillColor = sf::Color(r, g, b);
   } else {
     // Speed-based color intensity
-    float speedRatio = getSpeed() / MAX_SPEED;
+    float speedRatio =
+        getSpeed() / scalar::toFloat(m_physics.maxSpeed);
     std::uint8_t intensity = static_cast<std::uint8_t>(180 + 75 * speedRatio);
-    m_shape.setFillColor(sf::Color(0, intensity, intensity));
+    m_fillColor = sf::Color(0, intensity, intensity);
   }
 }
 
-void Player::render(sf::RenderWindow &window) { window.draw(m_shape); }
+template class BasicPlayer<float>;
+template class BasicPlayer<Fixed>;
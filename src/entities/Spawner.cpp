@@ -0,0 +1,207 @@
+#include "entities/Spawner.hpp"
+
+namespace {
+
+constexpr ComponentMask OBSTACLE_ARCHETYPE =
+    componentMask<Transform, Velocity, Collider, Renderable>();
+constexpr ComponentMask PICKUP_ARCHETYPE =
+    componentMask<Transform, Collider, Renderable, Lifetime>();
+
+constexpr std::uint32_t SPAWNED_LAYERS =
+    CollisionLayer::Obstacle | CollisionLayer::PICKUPS;
+
+} // namespace
+
+Spawner::Spawner(std::uint32_t seed)
+    : m_rng(seed), m_boostTimer(SimScalar(BASE_BOOST_INTERVAL)),
+      m_comboTimer(SimScalar(BASE_COMBO_INTERVAL)), m_obstacleCount(0),
+      m_boostCount(0), m_comboCount(0) {}
+
+void Spawner::reserve(EntityWorld &world) {
+  world.reserve(OBSTACLE_ARCHETYPE, MAX_OBSTACLES);
+  world.reserve(PICKUP_ARCHETYPE, MAX_BOOST_PICKUPS + MAX_COMBO_PICKUPS);
+}
+
+void Spawner::update(EntityWorld &world, SimScalar deltaTime,
+                     SimScalar difficulty,
+                     const Vec2<SimScalar> &playerPosition,
+                     const Vec2<SimScalar> &playerHeading) {
+  despawnPassed(world, playerPosition);
+
+  // Obstacles: keep the population at the difficulty's density
+  SimScalar target = SimScalar(BASE_OBSTACLES) +
+                     SimScalar(OBSTACLES_PER_DIFFICULTY) * difficulty;
+  std::size_t targetCount = static_cast<std::size_t>(scalar::floor(target));
+  if (targetCount > MAX_OBSTACLES)
+    targetCount = MAX_OBSTACLES;
+  for (int i = 0; i < MAX_SPAWNS_PER_TICK && m_obstacleCount < targetCount;
+       ++i) {
+    spawnObstacle(world, difficulty, playerPosition, playerHeading);
+  }
+
+  // Pickups: intervals shrink as difficulty rises
+  m_boostTimer -= deltaTime;
+  if (m_boostTimer <= SimScalar(0.0f)) {
+    m_boostTimer = SimScalar(BASE_BOOST_INTERVAL) +
+                   SimScalar(BOOST_INTERVAL_PER_DIFFICULTY) * difficulty;
+    if (m_boostCount < MAX_BOOST_PICKUPS)
+      spawnPickup(world, CollisionLayer::BoostPickup, playerPosition,
+                  playerHeading);
+  }
+
+  m_comboTimer -= deltaTime;
+  if (m_comboTimer <= SimScalar(0.0f)) {
+    m_comboTimer = SimScalar(BASE_COMBO_INTERVAL) +
+                   SimScalar(COMBO_INTERVAL_PER_DIFFICULTY) * difficulty;
+    if (m_comboCount < MAX_COMBO_PICKUPS)
+      spawnPickup(world, CollisionLayer::ComboPickup, playerPosition,
+                  playerHeading);
+  }
+}
+
+void Spawner::despawnPassed(EntityWorld &world,
+                            const Vec2<SimScalar> &playerPosition) {
+  // Anything this far from the player is behind it or was never reached
+  const SimScalar radiusSq =
+      SimScalar(DESPAWN_RADIUS) * SimScalar(DESPAWN_RADIUS);
+
+  // Recount survivors in the same pass (pickups also expire via Lifetime)
+  m_obstacleCount = 0;
+  m_boostCount = 0;
+  m_comboCount = 0;
+  world.each<Transform, Collider>([&](std::size_t count,
+                                      const Entity *entities,
+                                      const Transform *transforms,
+                                      const Collider *colliders) {
+    for (std::size_t i = 0; i < count; ++i) {
+      std::uint32_t layer = colliders[i].layer;
+      if ((layer & SPAWNED_LAYERS) == 0)
+        continue;
+
+      Vec2<SimScalar> offset = transforms[i].position - playerPosition;
+      if (offset.dot(offset) > radiusSq) {
+        world.destroyDeferred(entities[i]);
+        continue;
+      }
+      m_obstacleCount += (layer & CollisionLayer::Obstacle) != 0;
+      m_boostCount += (layer & CollisionLayer::BoostPickup) != 0;
+      m_comboCount += (layer & CollisionLayer::ComboPickup) != 0;
+    }
+  });
+  world.flushDestroyed();
+}
+
+Vec2<SimScalar> Spawner::spawnPoint(const Vec2<SimScalar> &origin,
+                                    const Vec2<SimScalar> &heading) {
+  Vec2<SimScalar> right(-heading.y, heading.x);
+  SimScalar ahead = scalar::uniform(m_rng, SimScalar(SPAWN_DISTANCE_MIN),
+                                    SimScalar(SPAWN_DISTANCE_MAX));
+  SimScalar lateral = scalar::uniform(m_rng, SimScalar(-SPAWN_LATERAL),
+                                      SimScalar(SPAWN_LATERAL));
+  return origin + heading * ahead + right * lateral;
+}
+
+void Spawner::spawnObstacle(EntityWorld &world, SimScalar difficulty,
+                            const Vec2<SimScalar> &origin,
+                            const Vec2<SimScalar> &heading) {
+  Entity entity = world.create(OBSTACLE_ARCHETYPE);
+  ++m_obstacleCount;
+
+  SimScalar size =
+      scalar::uniform(m_rng, SimScalar(14.0f), SimScalar(30.0f));
+  world.get<Transform>(entity)->position = spawnPoint(origin, heading);
+
+  // Higher difficulty: more obstacles drift, and faster
+  Velocity *velocity = world.get<Velocity>(entity);
+  bool drifting =
+      scalar::uniform(m_rng, SimScalar(0.0f), SimScalar(1.0f)) <
+      SimScalar(0.25f) + SimScalar(0.25f) * difficulty;
+  if (drifting) {
+    SimScalar angle =
+        scalar::uniform(m_rng, SimScalar(0.0f), SimScalar(360.0f));
+    SimScalar speed = SimScalar(30.0f) +
+                      SimScalar(OBSTACLE_SPEED_PER_DIFFICULTY) * difficulty;
+    SimScalar s, c;
+    scalar::sinCosDeg(angle, s, c);
+    velocity->linear = Vec2<SimScalar>(c * speed, s * speed);
+    velocity->angular =
+        scalar::uniform(m_rng, SimScalar(-90.0f), SimScalar(90.0f));
+  } else {
+    *velocity = Velocity();
+  }
+
+  Collider *collider = world.get<Collider>(entity);
+  collider->radius = size;
+  collider->layer = CollisionLayer::Obstacle;
+  collider->mask = 0;
+
+  Renderable *renderable = world.get<Renderable>(entity);
+  renderable->shape = drifting ? RenderShape::Diamond : RenderShape::Square;
+  renderable->color =
+      drifting ? sf::Color(255, 120, 30) : sf::Color(255, 40, 140);
+  renderable->size = scalar::toFloat(size);
+}
+
+void Spawner::spawnPickup(EntityWorld &world, std::uint32_t layer,
+                          const Vec2<SimScalar> &origin,
+                          const Vec2<SimScalar> &heading) {
+  Entity entity = world.create(PICKUP_ARCHETYPE);
+  bool boost = layer == CollisionLayer::BoostPickup;
+  if (boost)
+    ++m_boostCount;
+  else
+    ++m_comboCount;
+
+  world.get<Transform>(entity)->position = spawnPoint(origin, heading);
+  world.get<Lifetime>(entity)->remaining = SimScalar(PICKUP_LIFETIME);
+
+  Collider *collider = world.get<Collider>(entity);
+  collider->radius = SimScalar(16.0f);
+  collider->layer = layer;
+  collider->mask = 0;
+
+  Renderable *renderable = world.get<Renderable>(entity);
+  renderable->shape = boost ? RenderShape::Circle : RenderShape::Diamond;
+  renderable->color = boost ? sf::Color(0, 255, 140) : sf::Color(255, 220, 0);
+  renderable->size = 10.0f;
+}
+
+void Spawner::clear(EntityWorld &world) {
+  world.each<Collider>([&world](std::size_t count, const Entity *entities,
+                                const Collider *colliders) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (colliders[i].layer & SPAWNED_LAYERS)
+        world.destroyDeferred(entities[i]);
+    }
+  });
+  world.flushDestroyed();
+
+  m_obstacleCount = 0;
+  m_boostCount = 0;
+  m_comboCount = 0;
+  m_boostTimer = SimScalar(BASE_BOOST_INTERVAL);
+  m_comboTimer = SimScalar(BASE_COMBO_INTERVAL);
+}
+
+void Spawner::saveState(StateWriter &writer) const {
+  writer.write(m_rng);
+  writer.write(m_boostTimer);
+  writer.write(m_comboTimer);
+  writer.write(static_cast<std::uint32_t>(m_obstacleCount));
+  writer.write(static_cast<std::uint32_t>(m_boostCount));
+  writer.write(static_cast<std::uint32_t>(m_comboCount));
+}
+
+bool Spawner::loadState(StateReader &reader) {
+  std::uint32_t obstacles = 0, boosts = 0, combos = 0;
+  reader.read(m_rng);
+  reader.read(m_boostTimer);
+  reader.read(m_comboTimer);
+  reader.read(obstacles);
+  reader.read(boosts);
+  reader.read(combos);
+  m_obstacleCount = obstacles;
+  m_boostCount = boosts;
+  m_comboCount = combos;
+  return reader.ok();
+}
@@ -0,0 +1,87 @@
+#include "entities/Systems.hpp"
+
+namespace systems {
+
+void integrateMotion(EntityWorld &world, SimScalar deltaTime) {
+  world.each<Transform, Velocity>([deltaTime](std::size_t count,
+                                               const Entity *,
+                                               Transform *transforms,
+                                               Velocity *velocities) {
+    for (std::size_t i = 0; i < count; ++i) {
+      transforms[i].position += velocities[i].linear * deltaTime;
+      transforms[i].rotation += velocities[i].angular * deltaTime;
+    }
+  });
+}
+
+void updateLifetimes(EntityWorld &world, SimScalar deltaTime) {
+  world.each<Lifetime>([&world, deltaTime](std::size_t count,
+                                           const Entity *entities,
+                                           Lifetime *lifetimes) {
+    for (std::size_t i = 0; i < count; ++i) {
+      lifetimes[i].remaining -= deltaTime;
+      if (lifetimes[i].remaining <= SimScalar(0.0f))
+        world.destroyDeferred(entities[i]);
+    }
+  });
+  world.flushDestroyed();
+}
+
+std::size_t findContacts(const EntityWorld &world, Entity subject,
+                         Contact *contacts, std::size_t maxContacts) {
+  const Transform *subjectTransform = world.get<Transform>(subject);
+  const Collider *subjectCollider = world.get<Collider>(subject);
+  if (!subjectTransform || !subjectCollider || maxContacts == 0)
+    return 0;
+
+  const Vec2<SimScalar> center = subjectTransform->position;
+  const SimScalar radius = subjectCollider->radius;
+  const std::uint32_t mask = subjectCollider->mask;
+
+  std::size_t found = 0;
+  world.each<Transform, Collider, Renderable>(
+      [&](std::size_t count, const Entity *entities,
+          const Transform *transforms, const Collider *colliders,
+          const Renderable *renderables) {
+        for (std::size_t i = 0; i < count && found < maxContacts; ++i) {
+          if ((colliders[i].layer & mask) == 0 || entities[i] == subject)
+            continue;
+
+          Vec2<SimScalar> offset = transforms[i].position - center;
+          SimScalar reach = radius + colliders[i].radius;
+          if (offset.dot(offset) >= reach * reach)
+            continue;
+
+          contacts[found++] = {entities[i], colliders[i].layer,
+                               transforms[i].position.toSf(),
+                               renderables[i].color};
+        }
+      });
+  return found;
+}
+
+void buildRenderList(const EntityWorld &world,
+                     std::vector<RenderInstance> &instances) {
+  // Size once, then fill by index (no per-entity growth checks)
+  std::size_t total = 0;
+  world.each<Transform, Renderable>(
+      [&total](std::size_t count, const Entity *, const Transform *,
+               const Renderable *) { total += count; });
+  instances.resize(total);
+
+  RenderInstance *out = instances.data();
+  world.each<Transform, Renderable>([&out](std::size_t count, const Entity *,
+                                           const Transform *transforms,
+                                           const Renderable *renderables) {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i].position = transforms[i].position.toSf();
+      out[i].rotation = scalar::toFloat(transforms[i].rotation);
+      out[i].size = renderables[i].size;
+      out[i].color = renderables[i].color;
+      out[i].shape = renderables[i].shape;
+    }
+    out += count;
+  });
+}
+
+} // namespace systems
@@ -0,0 +1,164 @@
+#include "graphics/BackgroundLayer.hpp"
+#include "math/Random.hpp"
+#include <cmath>
+
+namespace {
+
+// Grid: dim purple minor lines, glowing cyan (vertical) and magenta
+// (horizontal) major lines
+const sf::Color MINOR_COLOR(70, 30, 110, 70);
+const sf::Color MAJOR_COLORS[2] = {sf::Color(0, 220, 255, 120),
+                                   sf::Color(255, 60, 200, 120)};
+constexpr float MINOR_WIDTH = 1.0f;
+constexpr float MAJOR_WIDTH = 2.0f;
+constexpr float GLOW_WIDTH = 10.0f;
+constexpr std::uint8_t GLOW_ALPHA = 24;
+
+const sf::Color GLINT_COLORS[3] = {sf::Color(0, 255, 255),
+                                   sf::Color(255, 80, 220),
+                                   sf::Color(170, 120, 255)};
+constexpr float GLINT_RADIUS_MIN = 3.0f;
+constexpr float GLINT_RADIUS_MAX = 7.0f;
+constexpr float FLARE_LENGTH = 4.0f; // Of the radius
+
+// Upper bound on one tile's decoration (lines on both edges, five
+// diamonds' worth of glints)
+constexpr std::size_t MAX_TILE_VERTICES = 1024;
+
+void appendQuad(std::vector<sf::Vertex> &vertices, const sf::FloatRect &rect,
+                sf::Color color) {
+  sf::Vector2f a = rect.position;
+  sf::Vector2f c = rect.position + rect.size;
+  sf::Vector2f b(c.x, a.y);
+  sf::Vector2f d(a.x, c.y);
+  for (sf::Vector2f corner : {a, b, c, a, c, d})
+    vertices.push_back({corner, color, {}});
+}
+
+// Four triangles fading from a bright center to transparent tips
+void appendDiamond(std::vector<sf::Vertex> &vertices, sf::Vector2f center,
+                   sf::Vector2f halfSize, sf::Color color) {
+  sf::Color clear = color;
+  clear.a = 0;
+  const sf::Vector2f tips[5] = {{halfSize.x, 0.0f},
+                                {0.0f, halfSize.y},
+                                {-halfSize.x, 0.0f},
+                                {0.0f, -halfSize.y},
+                                {halfSize.x, 0.0f}};
+  for (int i = 0; i < 4; ++i) {
+    vertices.push_back({center, color, {}});
+    vertices.push_back({center + tips[i], clear, {}});
+    vertices.push_back({center + tips[i + 1], clear, {}});
+  }
+}
+
+} // namespace
+
+BackgroundLayer::BackgroundLayer() : m_atlas(TILE_SIZE), m_tilesDrawn(0) {}
+
+bool BackgroundLayer::init(sf::Vector2f viewSize) {
+  if (!m_atlas.init(viewSize))
+    return false;
+  m_tileVertices.reserve(MAX_TILE_VERTICES);
+  m_quads.reserve(m_atlas.getSlotCount() * 6);
+  return true;
+}
+
+void BackgroundLayer::invalidate() { m_atlas.invalidate(); }
+
+void BackgroundLayer::invalidate(const sf::FloatRect &area) {
+  m_atlas.invalidate(area);
+}
+
+void BackgroundLayer::render(sf::RenderTarget &target, const sf::View &view) {
+  // A larger view than the atlas was sized for keeps the flat background
+  sf::Vector2i min;
+  sf::Vector2i max;
+  if (!m_atlas.isAvailable() || !m_atlas.visibleTiles(view, min, max))
+    return;
+
+  bool redrawn = false;
+  m_quads.clear();
+  for (int y = min.y; y <= max.y; ++y) {
+    for (int x = min.x; x <= max.x; ++x) {
+      sf::Vector2i tile(x, y);
+      if (!m_atlas.holds(tile)) {
+        drawTile(tile);
+        m_atlas.claim(tile);
+        redrawn = true;
+      }
+      m_atlas.appendQuad(m_quads, tile);
+    }
+  }
+  if (redrawn)
+    m_atlas.getTarget().display();
+
+  target.draw(m_quads.data(), m_quads.size(), sf::PrimitiveType::Triangles,
+              sf::RenderStates(&m_atlas.getTexture()));
+}
+
+void BackgroundLayer::drawTile(sf::Vector2i tile) {
+  const float size = static_cast<float>(TILE_SIZE);
+  sf::Vector2f origin(tile.x * size, tile.y * size);
+  sf::RenderTexture &target = m_atlas.beginTile(tile);
+
+  // The background replaces whatever tile the slot held
+  m_tileVertices.clear();
+  appendQuad(m_tileVertices, sf::FloatRect(origin, {size, size}),
+             BACKGROUND_COLOR);
+  target.draw(m_tileVertices.data(), m_tileVertices.size(),
+              sf::PrimitiveType::Triangles, sf::RenderStates(sf::BlendNone));
+
+  // Grid lines, including the far edges so lines on tile borders are
+  // whole once both neighbors are drawn
+  m_tileVertices.clear();
+  constexpr int LINES = TILE_SIZE / MINOR_SPACING;
+  for (int axis = 0; axis < 2; ++axis) {
+    bool vertical = axis == 0;
+    int first = (vertical ? tile.x : tile.y) * LINES;
+    for (int i = 0; i <= LINES; ++i) {
+      bool major = positiveModulo(first + i, MAJOR_EVERY) == 0;
+      sf::Color color = major ? MAJOR_COLORS[axis] : MINOR_COLOR;
+      float width = major ? MAJOR_WIDTH : MINOR_WIDTH;
+      float at = (vertical ? origin.x : origin.y) + i * MINOR_SPACING;
+
+      auto line = [&](float lineWidth, sf::Color lineColor) {
+        sf::FloatRect rect =
+            vertical ? sf::FloatRect({at - lineWidth * 0.5f, origin.y},
+                                     {lineWidth, size})
+                     : sf::FloatRect({origin.x, at - lineWidth * 0.5f},
+                                     {size, lineWidth});
+        appendQuad(m_tileVertices, rect, lineColor);
+      };
+      if (major) {
+        sf::Color glow = color;
+        glow.a = GLOW_ALPHA;
+        line(GLOW_WIDTH, glow);
+      }
+      line(width, color);
+    }
+  }
+
+  // Glints on inner grid crossings (flares stay inside the tile), the
+  // same for a tile every time it is drawn
+  Pcg32 rng((std::uint64_t(std::uint32_t(tile.x)) << 32) |
+            std::uint32_t(tile.y));
+  for (int i = 0; i < GLINTS_PER_TILE; ++i) {
+    auto crossing = [&rng]() {
+      return static_cast<float>(1 + rng() % (LINES - 1)) * MINOR_SPACING;
+    };
+    sf::Vector2f center(origin.x + crossing(), origin.y + crossing());
+    float radius = GLINT_RADIUS_MIN +
+                   rng.nextFloat() * (GLINT_RADIUS_MAX - GLINT_RADIUS_MIN);
+    float flare = radius * FLARE_LENGTH;
+    sf::Color color = GLINT_COLORS[rng() % 3];
+    appendDiamond(m_tileVertices, center, {flare, radius * 0.5f}, color);
+    appendDiamond(m_tileVertices, center, {radius * 0.5f, flare}, color);
+    appendDiamond(m_tileVertices, center, {radius, radius}, color);
+  }
+
+  // Light adds up where lines cross and glints sit
+  target.draw(m_tileVertices.data(), m_tileVertices.size(),
+              sf::PrimitiveType::Triangles, sf::RenderStates(sf::BlendAdd));
+  ++m_tilesDrawn;
+}
@@ -0,0 +1,105 @@
+#include "graphics/CommandList.hpp"
+#include "core/AllocationTracker.hpp"
+#include <algorithm>
+
+void CommandList::clear() {
+  m_vertices.clear();
+  m_batches.clear();
+  m_submissions = 0;
+}
+
+void CommandList::submit(const sf::Vertex *vertices, std::size_t count,
+                         sf::PrimitiveType type, const DrawState &state) {
+  std::size_t triangles = triangleVertexCount(count, type);
+  if (triangles == 0)
+    return; // Points and lines have no batched form
+  ++m_submissions;
+
+  // Same state as the last batch: extend it, first taking ownership of
+  // its vertices so the two are contiguous (unless copying a large list
+  // would cost more than the draw call it saves)
+  bool copyNew = type != sf::PrimitiveType::Triangles ||
+                 triangles <= MAX_MERGE_VERTICES;
+  if (copyNew && !m_batches.empty() && m_batches.back().state == state &&
+      (!m_batches.back().external ||
+       m_batches.back().count <= MAX_MERGE_VERTICES)) {
+    Batch &last = m_batches.back();
+    if (last.external) {
+      reserve(last.count + triangles);
+      const sf::Vertex *external = last.external;
+      last.external = nullptr;
+      last.first = m_vertices.size();
+      m_vertices.insert(m_vertices.end(), external, external + last.count);
+    } else {
+      reserve(triangles);
+    }
+    appendTriangles(vertices, count, type);
+    last.count += triangles;
+    return;
+  }
+
+  if (type == sf::PrimitiveType::Triangles) {
+    addBatch({state, vertices, 0, triangles});
+    return;
+  }
+  reserve(triangles);
+  std::size_t first = m_vertices.size();
+  appendTriangles(vertices, count, type);
+  addBatch({state, nullptr, first, triangles});
+}
+
+void CommandList::reserve(std::size_t count) {
+  if (m_vertices.size() + count <= m_vertices.capacity())
+    return;
+  AllocationScope scope(AllocTag::Growth);
+  m_vertices.reserve(
+      std::max(m_vertices.capacity() * 2, m_vertices.size() + count));
+}
+
+void CommandList::addBatch(const Batch &batch) {
+  if (m_batches.size() == m_batches.capacity()) {
+    AllocationScope scope(AllocTag::Growth);
+    m_batches.reserve(std::max<std::size_t>(m_batches.capacity() * 2, 16));
+  }
+  m_batches.push_back(batch);
+}
+
+void CommandList::appendTriangles(const sf::Vertex *vertices,
+                                  std::size_t count, sf::PrimitiveType type) {
+  switch (type) {
+  case sf::PrimitiveType::Triangles:
+    m_vertices.insert(m_vertices.end(), vertices,
+                      vertices + count / 3 * 3);
+    break;
+  case sf::PrimitiveType::TriangleStrip:
+    // Winding alternates, which no backend culls on
+    for (std::size_t i = 2; i < count; ++i) {
+      m_vertices.push_back(vertices[i - 2]);
+      m_vertices.push_back(vertices[i - 1]);
+      m_vertices.push_back(vertices[i]);
+    }
+    break;
+  case sf::PrimitiveType::TriangleFan:
+    for (std::size_t i = 2; i < count; ++i) {
+      m_vertices.push_back(vertices[0]);
+      m_vertices.push_back(vertices[i - 1]);
+      m_vertices.push_back(vertices[i]);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+std::size_t CommandList::triangleVertexCount(std::size_t count,
+                                             sf::PrimitiveType type) {
+  switch (type) {
+  case sf::PrimitiveType::Triangles:
+    return count / 3 * 3;
+  case sf::PrimitiveType::TriangleStrip:
+  case sf::PrimitiveType::TriangleFan:
+    return count >= 3 ? (count - 2) * 3 : 0;
+  default:
+    return 0;
+  }
+}
@@ -0,0 +1,271 @@
+#include "graphics/CpuRasterizer.hpp"
+#include "math/FastMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Twice the signed area of (a, b, c); for c a pixel center, the weight of
+// the vertex opposite edge a-b
+float edge(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c) {
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Pixel centers exactly on an edge belong to one of the two triangles
+// sharing it: the one seeing the edge run this way
+bool ownsEdge(sf::Vector2f a, sf::Vector2f b) {
+  return b.y > a.y || (b.y == a.y && b.x < a.x);
+}
+
+// x * y / 255, rounded
+std::uint8_t mul255(unsigned x, unsigned y) {
+  unsigned product = x * y + 128;
+  return static_cast<std::uint8_t>((product + (product >> 8)) >> 8);
+}
+
+std::uint8_t channel(float value) {
+  return static_cast<std::uint8_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+}
+
+// dst.rgb += src.rgb * src.a, dst.a += src.a, saturating (sf::BlendAdd)
+void addSpan(std::uint8_t *dst, const std::uint8_t *src, std::size_t count) {
+  std::size_t i = 0;
+#ifdef NEONDRIFT_FASTMATH_SSE2
+  // Four pixels per step, widened to 16 bits for the multiply. The alpha
+  // lanes are scaled by 255 so they come out unchanged.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+  const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+  const __m128i round = _mm_set1_epi16(128);
+  auto premultiply = [&](__m128i pixels) {
+    __m128i alpha = _mm_shufflehi_epi16(
+        _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+        _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), alphaOne);
+    __m128i product = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), round);
+    return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)),
+                          8);
+  };
+  for (; i + 4 <= count; i += 4) {
+    __m128i source =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+    __m128i weighted =
+        _mm_packus_epi16(premultiply(_mm_unpacklo_epi8(source, zero)),
+                         premultiply(_mm_unpackhi_epi8(source, zero)));
+    __m128i *target = reinterpret_cast<__m128i *>(dst + i * 4);
+    _mm_storeu_si128(target,
+                     _mm_adds_epu8(_mm_loadu_si128(target), weighted));
+  }
+#endif
+  for (; i < count; ++i) {
+    const std::uint8_t *s = src + i * 4;
+    std::uint8_t *d = dst + i * 4;
+    for (int c = 0; c < 3; ++c)
+      d[c] = static_cast<std::uint8_t>(
+          std::min(255u, d[c] + unsigned(mul255(s[c], s[3]))));
+    d[3] = static_cast<std::uint8_t>(std::min(255u, unsigned(d[3]) + s[3]));
+  }
+}
+
+// dst = src * src.a + dst * (1 - src.a), alpha likewise (sf::BlendAlpha)
+void alphaSpan(std::uint8_t *dst, const std::uint8_t *src,
+               std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint8_t *s = src + i * 4;
+    std::uint8_t *d = dst + i * 4;
+    unsigned inverse = 255u - s[3];
+    for (int c = 0; c < 3; ++c)
+      d[c] = static_cast<std::uint8_t>(mul255(s[c], s[3]) +
+                                       mul255(d[c], inverse));
+    d[3] = static_cast<std::uint8_t>(
+        std::min(255u, s[3] + unsigned(mul255(d[3], inverse))));
+  }
+}
+
+} // namespace
+
+CpuRasterizer::CpuRasterizer(sf::Vector2u size)
+    : m_size(size), m_pixels(std::size_t(size.x) * size.y * 4),
+      m_span(std::size_t(size.x) * 4) {}
+
+void CpuRasterizer::clear(sf::Color color) {
+  const std::uint8_t pixel[4] = {color.r, color.g, color.b, color.a};
+  for (std::size_t i = 0; i < m_pixels.size(); i += 4)
+    std::memcpy(&m_pixels[i], pixel, 4);
+}
+
+sf::Image CpuRasterizer::toImage() const {
+  sf::Image image;
+  image.resize(m_size, m_pixels.data());
+  return image;
+}
+
+CpuRasterizer::Blend CpuRasterizer::classify(const sf::BlendMode &mode) {
+  if (mode == sf::BlendAdd)
+    return Blend::Add;
+  if (mode == sf::BlendNone)
+    return Blend::Replace;
+  return Blend::Alpha;
+}
+
+void CpuRasterizer::draw(const CommandList &commands, const sf::View &view) {
+  // World to pixels, as the view's viewport places it in the framebuffer
+  const sf::FloatRect &rect = view.getViewport();
+  sf::Vector2f size(static_cast<float>(m_size.x),
+                    static_cast<float>(m_size.y));
+  sf::Vector2f offset(rect.position.x * size.x, rect.position.y * size.y);
+  sf::Vector2f extent(rect.size.x * size.x, rect.size.y * size.y);
+
+  Viewport viewport;
+  viewport.origin = view.getCenter() - view.getSize() * 0.5f;
+  viewport.scale = {extent.x / view.getSize().x, extent.y / view.getSize().y};
+  viewport.offset = offset;
+  viewport.left = std::max(0, static_cast<int>(std::lround(offset.x)));
+  viewport.top = std::max(0, static_cast<int>(std::lround(offset.y)));
+  viewport.right = std::min(static_cast<int>(m_size.x),
+                            static_cast<int>(std::lround(offset.x + extent.x)));
+  viewport.bottom =
+      std::min(static_cast<int>(m_size.y),
+               static_cast<int>(std::lround(offset.y + extent.y)));
+
+  for (const CommandList::Batch &batch : commands.getBatches()) {
+    ++m_stats.batches;
+    Blend blend = classify(batch.state.blendMode);
+    const sf::Vertex *vertices = commands.vertices(batch);
+    for (std::size_t i = 0; i + 3 <= batch.count; i += 3)
+      drawTriangle(vertices + i, viewport, blend);
+  }
+}
+
+void CpuRasterizer::drawTriangle(const sf::Vertex *vertices,
+                                 const Viewport &viewport, Blend blend) {
+  sf::Vector2f p[3];
+  sf::Color color[3];
+  for (int i = 0; i < 3; ++i) {
+    sf::Vector2f world = vertices[i].position - viewport.origin;
+    p[i] = {world.x * viewport.scale.x + viewport.offset.x,
+            world.y * viewport.scale.y + viewport.offset.y};
+    color[i] = vertices[i].color;
+  }
+
+  // One winding, so inside means all three weights are positive
+  float area = edge(p[0], p[1], p[2]);
+  if (!(std::fabs(area) > 0.0f) || !std::isfinite(area))
+    return; // Degenerate (e.g. strip joins)
+  if (area < 0.0f) {
+    std::swap(p[1], p[2]);
+    std::swap(color[1], color[2]);
+    area = -area;
+  }
+  ++m_stats.triangles;
+
+  // Pixels whose centers the bounding box covers
+  float minX = std::min({p[0].x, p[1].x, p[2].x});
+  float maxX = std::max({p[0].x, p[1].x, p[2].x});
+  float minY = std::min({p[0].y, p[1].y, p[2].y});
+  float maxY = std::max({p[0].y, p[1].y, p[2].y});
+  int left = std::max(viewport.left, static_cast<int>(std::ceil(minX - 0.5f)));
+  int right = std::min(viewport.right - 1,
+                       static_cast<int>(std::floor(maxX - 0.5f)));
+  int top = std::max(viewport.top, static_cast<int>(std::ceil(minY - 0.5f)));
+  int bottom = std::min(viewport.bottom - 1,
+                        static_cast<int>(std::floor(maxY - 0.5f)));
+  if (left > right || top > bottom)
+    return;
+
+  // Weight of vertex i comes from the edge opposite it; each weight is
+  // linear, stepping by stepX per pixel
+  const sf::Vector2f *edges[3][2] = {
+      {&p[1], &p[2]}, {&p[2], &p[0]}, {&p[0], &p[1]}};
+  float stepX[3];
+  bool owned[3];
+  for (int i = 0; i < 3; ++i) {
+    stepX[i] = -(edges[i][1]->y - edges[i][0]->y);
+    owned[i] = ownsEdge(*edges[i][0], *edges[i][1]);
+  }
+  auto inside = [&](const float (&w)[3]) {
+    for (int i = 0; i < 3; ++i) {
+      if (w[i] < 0.0f || (w[i] == 0.0f && !owned[i]))
+        return false;
+    }
+    return true;
+  };
+
+  bool flat = color[0] == color[1] && color[0] == color[2];
+  const float base[4] = {float(color[0].r), float(color[0].g),
+                         float(color[0].b), float(color[0].a)};
+  float delta[2][4];
+  for (int v = 0; v < 2; ++v) {
+    const sf::Color &c = color[v + 1];
+    const float values[4] = {float(c.r), float(c.g), float(c.b), float(c.a)};
+    for (int k = 0; k < 4; ++k)
+      delta[v][k] = (values[k] - base[k]) / area;
+  }
+
+  for (int y = top; y <= bottom; ++y) {
+    sf::Vector2f center(left + 0.5f, y + 0.5f);
+    float w[3];
+    for (int i = 0; i < 3; ++i)
+      w[i] = edge(*edges[i][0], *edges[i][1], center);
+
+    // Rows of a triangle are one run of pixels
+    int first = -1;
+    int last = -1;
+    float start[3] = {0.0f, 0.0f, 0.0f};
+    for (int x = left; x <= right; ++x) {
+      if (inside(w)) {
+        if (first < 0) {
+          first = x;
+          std::copy(w, w + 3, start);
+        }
+        last = x;
+      } else if (first >= 0) {
+        break;
+      }
+      for (int i = 0; i < 3; ++i)
+        w[i] += stepX[i];
+    }
+    if (first < 0)
+      continue;
+
+    std::size_t count = static_cast<std::size_t>(last - first + 1);
+    std::uint8_t *span = m_span.data();
+    if (flat) {
+      const std::uint8_t pixel[4] = {color[0].r, color[0].g, color[0].b,
+                                     color[0].a};
+      for (std::size_t i = 0; i < count; ++i)
+        std::memcpy(span + i * 4, pixel, 4);
+    } else {
+      float w1 = start[1];
+      float w2 = start[2];
+      for (std::size_t i = 0; i < count; ++i) {
+        for (int k = 0; k < 4; ++k)
+          span[i * 4 + k] =
+              channel(base[k] + w1 * delta[0][k] + w2 * delta[1][k]);
+        w1 += stepX[1];
+        w2 += stepX[2];
+      }
+    }
+
+    std::uint8_t *dst =
+        m_pixels.data() + (std::size_t(y) * m_size.x + std::size_t(first)) * 4;
+    blendSpan(dst, count, blend);
+    m_stats.pixels += count;
+  }
+}
+
+void CpuRasterizer::blendSpan(std::uint8_t *dst, std::size_t count,
+                              Blend blend) {
+  switch (blend) {
+  case Blend::Replace:
+    std::memcpy(dst, m_span.data(), count * 4);
+    break;
+  case Blend::Alpha:
+    alphaSpan(dst, m_span.data(), count);
+    break;
+  case Blend::Add:
+    addSpan(dst, m_span.data(), count);
+    break;
+  }
+}
@@ -0,0 +1,146 @@
+#include "graphics/DriftRibbon.hpp"
+#include "math/FastMath.hpp"
+#include <cmath>
+
+namespace {
+
+// Same neon range as the particle drift trail
+const sf::Color CALM_COLOR(0, 255, 255);
+const sf::Color DRIFT_COLOR(255, 178, 255);
+
+std::uint8_t mix(std::uint8_t a, std::uint8_t b, float t) {
+  return static_cast<std::uint8_t>(a + (b - a) * t);
+}
+
+} // namespace
+
+DriftRibbon::DriftRibbon()
+    : m_samples(), m_head(0), m_count(0), m_time(0.0f), m_broken(true) {}
+
+void DriftRibbon::update(float deltaTime) {
+  m_time += deltaTime;
+  while (m_count > 0 && m_time - sample(0).time > LIFETIME) {
+    m_head = (m_head + 1) % CAPACITY;
+    --m_count;
+  }
+}
+
+void DriftRibbon::addSample(const sf::Vector2f &carPosition, float rotation,
+                            float driftAmount) {
+  // Overwrite the oldest sample when full
+  if (m_count == CAPACITY) {
+    m_head = (m_head + 1) % CAPACITY;
+    --m_count;
+  }
+
+  float angle = rotation * fastmath::DEG_TO_RAD;
+  Sample &s = m_samples[(m_head + m_count) % CAPACITY];
+  s.position = carPosition - sf::Vector2f(std::cos(angle), std::sin(angle)) *
+                                 REAR_AXLE;
+  s.driftAmount = driftAmount;
+  s.time = m_time;
+  s.segmentStart = m_broken ? 1 : 0;
+  ++m_count;
+  m_broken = false;
+}
+
+void DriftRibbon::clear() {
+  m_head = 0;
+  m_count = 0;
+  m_broken = true;
+}
+
+std::size_t DriftRibbon::appendVertices(std::vector<sf::Vertex> &strip,
+                                        std::size_t count) const {
+  if (strip.size() < count + MAX_VERTICES)
+    strip.resize(count + MAX_VERTICES);
+
+  std::size_t first = 0;
+  while (first < m_count) {
+    // Find the segment [first, last)
+    std::size_t last = first + 1;
+    while (last < m_count && !sample(last).segmentStart)
+      ++last;
+    if (last - first < 2) {
+      first = last;
+      continue; // A lone sample has no direction to draw
+    }
+
+    bool join = count > 0;
+    sf::Vector2f normal(0.0f, 0.0f);
+    for (std::size_t i = first; i < last; ++i) {
+      const Sample &s = sample(i);
+
+      // Perpendicular to the path through the neighbouring samples
+      const Sample &prev = sample(i > first ? i - 1 : i);
+      const Sample &next = sample(i + 1 < last ? i + 1 : i);
+      sf::Vector2f tangent = next.position - prev.position;
+      float length = std::sqrt(tangent.x * tangent.x + tangent.y * tangent.y);
+      if (length > 1.0e-3f)
+        normal = sf::Vector2f(-tangent.y / length, tangent.x / length);
+
+      // Older samples narrow and fade toward the tail
+      float fade = 1.0f - (m_time - s.time) / LIFETIME;
+      fade = fade < 0.0f ? 0.0f : fade;
+      float halfWidth =
+          HALF_WIDTH_MIN + (HALF_WIDTH_MAX - HALF_WIDTH_MIN) * s.driftAmount;
+      halfWidth *= 0.3f + 0.7f * fade;
+      sf::Color color(mix(CALM_COLOR.r, DRIFT_COLOR.r, s.driftAmount),
+                      mix(CALM_COLOR.g, DRIFT_COLOR.g, s.driftAmount),
+                      mix(CALM_COLOR.b, DRIFT_COLOR.b, s.driftAmount),
+                      static_cast<std::uint8_t>(MAX_ALPHA * fade));
+
+      sf::Vertex left, right;
+      left.position = s.position + normal * halfWidth;
+      right.position = s.position - normal * halfWidth;
+      left.color = right.color = color;
+
+      // Degenerate triangles bridge from whatever the strip held before
+      if (join) {
+        strip[count] = strip[count - 1];
+        strip[count + 1] = left;
+        count += 2;
+        join = false;
+      }
+      strip[count++] = left;
+      strip[count++] = right;
+    }
+    first = last;
+  }
+  return count;
+}
+
+void DriftRibbon::render(CommandList &commands,
+                         const std::vector<sf::Vertex> &strip,
+                         std::size_t vertexCount) {
+  if (vertexCount < 3)
+    return;
+
+  // Additive like the particles it replaces
+  DrawState state;
+  state.blendMode = sf::BlendAdd;
+  commands.submit(strip.data(), vertexCount, sf::PrimitiveType::TriangleStrip,
+                  state);
+}
+
+void DriftRibbon::saveState(StateWriter &writer) const {
+  writer.write(m_samples);
+  writer.write(static_cast<std::uint32_t>(m_head));
+  writer.write(static_cast<std::uint32_t>(m_count));
+  writer.write(m_time);
+  writer.write(m_broken);
+}
+
+bool DriftRibbon::loadState(StateReader &reader) {
+  std::uint32_t head = 0, count = 0;
+  reader.read(m_samples);
+  reader.read(head);
+  reader.read(count);
+  reader.read(m_time);
+  reader.read(m_broken);
+  if (head >= CAPACITY || count > CAPACITY)
+    return reader.fail();
+  m_head = head;
+  m_count = count;
+  return reader.ok();
+}
@@ -0,0 +1,191 @@
+#include "graphics/EmitterDescriptor.hpp"
+#include "core/IniReader.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
+namespace {
+
+// "r g b [a]"
+bool parseColor(const std::string &text, sf::Color &color) {
+  std::istringstream ss(text);
+  int r, g, b, a = 255;
+  if (!(ss >> r >> g >> b))
+    return false;
+  ss >> a;
+  auto channel = [](int v) {
+    return static_cast<std::uint8_t>(std::clamp(v, 0, 255));
+  };
+  color = sf::Color(channel(r), channel(g), channel(b), channel(a));
+  return true;
+}
+
+// "min [max]" - a single value sets both
+template <typename T> void parseRange(const std::string &text, T &lo, T &hi) {
+  std::istringstream ss(text);
+  T a;
+  if (!(ss >> a))
+    return;
+  T b = a;
+  ss >> b;
+  lo = std::min(a, b);
+  hi = std::max(a, b);
+}
+
+// "essential", "normal" or "cosmetic"
+void parsePriority(const std::string &text, EffectPriority &priority) {
+  if (text == "essential")
+    priority = EffectPriority::Essential;
+  else if (text == "normal")
+    priority = EffectPriority::Normal;
+  else if (text == "cosmetic")
+    priority = EffectPriority::Cosmetic;
+}
+
+template <typename T> void parseValue(const std::string &text, T &value) {
+  std::istringstream ss(text);
+  T parsed;
+  if (ss >> parsed)
+    value = parsed;
+}
+
+void applyKey(EmitterDescriptor &d, const std::string &key,
+              const std::string &value) {
+  if (key == "rate")
+    parseRange(value, d.rateMin, d.rateMax);
+  else if (key == "burst")
+    parseRange(value, d.burstMin, d.burstMax);
+  else if (key == "spread")
+    parseValue(value, d.spread);
+  else if (key == "speed")
+    parseRange(value, d.speedMin, d.speedMax);
+  else if (key == "inherit_speed")
+    parseValue(value, d.inheritSpeed);
+  else if (key == "offset")
+    parseValue(value, d.offset);
+  else if (key == "lifetime")
+    parseRange(value, d.lifetimeMin, d.lifetimeMax);
+  else if (key == "color_low")
+    parseColor(value, d.colorLow);
+  else if (key == "color_high")
+    parseColor(value, d.colorHigh);
+  else if (key == "color") {
+    parseColor(value, d.colorLow);
+    d.colorHigh = d.colorLow;
+  } else if (key == "color_intensity")
+    parseValue(value, d.colorIntensity);
+  else if (key == "gradient") {
+    // Comma-separated colors
+    d.gradient.clear();
+    std::istringstream ss(value);
+    std::string item;
+    sf::Color color;
+    while (std::getline(ss, item, ',')) {
+      if (parseColor(item, color))
+        d.gradient.push_back(color);
+    }
+  } else if (key == "fade")
+    parseValue(value, d.fade);
+  else if (key == "drag")
+    parseValue(value, d.drag);
+  else if (key == "size")
+    parseRange(value, d.sizeMin, d.sizeMax);
+  else if (key == "size_intensity")
+    parseValue(value, d.sizeIntensity);
+  else if (key == "size_end")
+    parseValue(value, d.sizeEnd);
+  else if (key == "priority")
+    parsePriority(value, d.priority);
+}
+
+} // namespace
+
+unsigned EmitterDescriptor::features() const {
+  unsigned mask = 0;
+  if (drag < 1.0f)
+    mask |= ParticleFeature::Drag;
+  if (sizeEnd != 1.0f)
+    mask |= ParticleFeature::Shrink;
+  if (fade)
+    mask |= ParticleFeature::Fade;
+  if (gradient.size() >= 2)
+    mask |= ParticleFeature::Gradient;
+  return mask;
+}
+
+std::vector<EmitterDescriptor> defaultEmitterDescriptors() {
+  std::vector<EmitterDescriptor> descriptors(3);
+
+  // Neon trail behind a drifting car, cyan to magenta with drift amount
+  EmitterDescriptor &drift = descriptors[0];
+  drift.name = "drift_trail";
+  drift.rateMin = 120.0f;
+  drift.rateMax = 240.0f;
+  drift.spread = 30.0f;
+  drift.speedMin = 20.0f;
+  drift.speedMax = 60.0f;
+  drift.lifetimeMin = 0.42f;
+  drift.lifetimeMax = 0.78f;
+  drift.colorLow = sf::Color(0, 255, 255);
+  drift.colorHigh = sf::Color(255, 178, 255);
+  drift.colorIntensity = 0.8f;
+  drift.drag = 0.3f;
+  drift.sizeIntensity = 0.5f;
+  drift.sizeEnd = 0.7f;
+
+  // Orange-red sparks in all directions
+  EmitterDescriptor &collision = descriptors[1];
+  collision.name = "collision_burst";
+  collision.burstMin = 15;
+  collision.burstMax = 25;
+  collision.spread = 360.0f;
+  collision.speedMin = 150.0f;
+  collision.speedMax = 350.0f;
+  collision.lifetimeMin = 0.2f;
+  collision.lifetimeMax = 0.4f;
+  collision.colorLow = sf::Color(255, 100, 0);
+  collision.colorHigh = sf::Color(255, 200, 50);
+  collision.drag = 0.3f;
+  collision.sizeMin = 3.2f;
+  collision.sizeMax = 5.6f;
+  collision.sizeEnd = 0.8f;
+  collision.priority = EffectPriority::Essential;
+
+  // White/cyan streaks left behind at high speed
+  EmitterDescriptor &speed = descriptors[2];
+  speed.name = "speed_lines";
+  speed.rateMax = 60.0f;
+  speed.inheritSpeed = 0.3f;
+  speed.offset = 30.0f;
+  speed.lifetimeMin = 0.15f;
+  speed.lifetimeMax = 0.15f;
+  speed.colorLow = sf::Color(200, 255, 255);
+  speed.colorHigh = speed.colorLow;
+  speed.drag = 0.3f;
+  speed.sizeMin = 2.0f;
+  speed.sizeMax = 2.0f;
+  speed.priority = EffectPriority::Cosmetic;
+
+  return descriptors;
+}
+
+bool loadEmitterDescriptors(const std::filesystem::path &path,
+                            std::vector<EmitterDescriptor> &descriptors) {
+  std::vector<EmitterDescriptor> loaded;
+  bool opened = ini::read(
+      path,
+      [&](const std::string &section) {
+        loaded.emplace_back();
+        loaded.back().name = section;
+      },
+      [&](const std::string &, const std::string &key,
+          const std::string &value) {
+        if (!loaded.empty()) // Ignore keys outside a section
+          applyKey(loaded.back(), key, value);
+      });
+  if (!opened)
+    return false;
+
+  descriptors = std::move(loaded);
+  return true;
+}
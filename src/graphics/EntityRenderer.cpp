@@ -0,0 +1,83 @@
+#include "graphics/EntityRenderer.hpp"
+#include "math/FastMath.hpp"
+#include <array>
+
+namespace {
+
+// Unit circle points for the circle fan, computed once
+template <int Segments> std::array<sf::Vector2f, Segments> makeUnitCircle() {
+  std::array<sf::Vector2f, Segments> points;
+  for (int i = 0; i < Segments; ++i) {
+    float s, c;
+    fastmath::sincos(2.0f * fastmath::PI * i / Segments, s, c);
+    points[i] = sf::Vector2f(c, s);
+  }
+  return points;
+}
+
+} // namespace
+
+void EntityRenderer::render(CommandList &commands,
+                            const std::vector<RenderInstance> &instances) {
+  m_vertices.clear();
+  for (const RenderInstance &instance : instances) {
+    if (instance.shape != RenderShape::Vehicle)
+      appendShape(instance);
+  }
+
+  if (!m_vertices.empty()) {
+    commands.submit(m_vertices.data(), m_vertices.size(),
+                    sf::PrimitiveType::Triangles);
+  }
+
+  // Vehicles last so they sit on top of the world
+  for (const RenderInstance &instance : instances) {
+    if (instance.shape == RenderShape::Vehicle)
+      m_vehicle.render(commands, instance);
+  }
+}
+
+void EntityRenderer::appendShape(const RenderInstance &instance) {
+  static const auto UNIT_CIRCLE = makeUnitCircle<CIRCLE_SEGMENTS>();
+
+  const sf::Vector2f center = instance.position;
+  const sf::Color color = instance.color;
+  auto vertex = [&](sf::Vector2f position) {
+    sf::Vertex v;
+    v.position = position;
+    v.color = color;
+    m_vertices.push_back(v);
+  };
+
+  if (instance.shape == RenderShape::Circle) {
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+      const sf::Vector2f &a = UNIT_CIRCLE[i];
+      const sf::Vector2f &b = UNIT_CIRCLE[(i + 1) % CIRCLE_SEGMENTS];
+      vertex(center);
+      vertex(center + a * instance.size);
+      vertex(center + b * instance.size);
+    }
+    return;
+  }
+
+  // Diamond and square: rotated quad (diamond is a square turned 45 degrees)
+  float angle = instance.rotation +
+                (instance.shape == RenderShape::Diamond ? 45.0f : 0.0f);
+  float s, c;
+  fastmath::sincosDeg(angle, s, c);
+  float half = instance.size * 0.7071f; // Corners on the bounding circle
+  sf::Vector2f axisX(c * half, s * half);
+  sf::Vector2f axisY(-s * half, c * half);
+
+  sf::Vector2f topLeft = center - axisX - axisY;
+  sf::Vector2f topRight = center + axisX - axisY;
+  sf::Vector2f bottomRight = center + axisX + axisY;
+  sf::Vector2f bottomLeft = center - axisX + axisY;
+
+  vertex(topLeft);
+  vertex(topRight);
+  vertex(bottomRight);
+  vertex(topLeft);
+  vertex(bottomRight);
+  vertex(bottomLeft);
+}
@@ -0,0 +1,460 @@
+#include "graphics/FrameCapture.hpp"
+#include "core/LatencyTracker.hpp"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+// Pixel buffer objects (OpenGL 2.1 / ARB_pixel_buffer_object), loaded at
+// run time since SFML only guarantees OpenGL 1.1 headers
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_READ_ONLY
+#define GL_READ_ONLY 0x88B8
+#endif
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+/**
+ * Framebuffer readback for one capture size
+ * With pixel buffer objects each frame is copied into one of SLOTS GPU
+ * buffers without waiting, and mapped SLOTS frames later when the copy has
+ * long finished. Without them the read is synchronous.
+ */
+class CaptureReadback {
+public:
+  static constexpr std::size_t SLOTS = 3;
+
+  // Needs the target's GL context to be active
+  explicit CaptureReadback(sf::Vector2u size)
+      : m_size(size), m_bytes(std::size_t(size.x) * size.y * 4),
+        m_async(false), m_buffers(), m_pending(), m_next(0) {
+    if (!sf::Context::isExtensionAvailable("GL_ARB_pixel_buffer_object"))
+      return;
+    load(m_genBuffers, "glGenBuffers");
+    load(m_deleteBuffers, "glDeleteBuffers");
+    load(m_bindBuffer, "glBindBuffer");
+    load(m_bufferData, "glBufferData");
+    load(m_mapBuffer, "glMapBuffer");
+    load(m_unmapBuffer, "glUnmapBuffer");
+    if (!m_genBuffers || !m_deleteBuffers || !m_bindBuffer || !m_bufferData ||
+        !m_mapBuffer || !m_unmapBuffer)
+      return;
+
+    m_genBuffers(static_cast<GLsizei>(SLOTS), m_buffers.data());
+    for (GLuint buffer : m_buffers) {
+      m_bindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+      m_bufferData(GL_PIXEL_PACK_BUFFER, static_cast<std::ptrdiff_t>(m_bytes),
+                   nullptr, GL_STREAM_READ);
+    }
+    m_bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_async = true;
+  }
+
+  bool isAsync() const { return m_async; }
+
+  // The slot the next issue() reuses holds the oldest readback
+  bool oldestPending() const { return m_pending[m_next]; }
+
+  // Copy the oldest readback out (nullptr discards it)
+  void collectOldest(std::uint8_t *out) {
+    m_pending[m_next] = false;
+    if (!out)
+      return;
+    m_bindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[m_next]);
+    if (const void *pixels = m_mapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)) {
+      std::memcpy(out, pixels, m_bytes);
+      m_unmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    m_bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  }
+
+  // Start copying the current framebuffer into the next slot
+  void issue() {
+    m_bindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[m_next]);
+    readPixels(nullptr);
+    m_bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_pending[m_next] = true;
+    m_next = (m_next + 1) % SLOTS;
+  }
+
+  // Skip to the next slot (after collecting or when flushing)
+  void advance() { m_next = (m_next + 1) % SLOTS; }
+
+  void readPixels(std::uint8_t *out) const {
+    glReadPixels(0, 0, static_cast<GLsizei>(m_size.x),
+                 static_cast<GLsizei>(m_size.y), GL_RGBA, GL_UNSIGNED_BYTE,
+                 out);
+  }
+
+  // Free the GPU buffers (context active)
+  void release() {
+    if (m_async)
+      m_deleteBuffers(static_cast<GLsizei>(SLOTS), m_buffers.data());
+    m_async = false;
+  }
+
+private:
+  using GenBuffersFn = void(APIENTRY *)(GLsizei, GLuint *);
+  using DeleteBuffersFn = void(APIENTRY *)(GLsizei, const GLuint *);
+  using BindBufferFn = void(APIENTRY *)(GLenum, GLuint);
+  using BufferDataFn = void(APIENTRY *)(GLenum, std::ptrdiff_t, const void *,
+                                        GLenum);
+  using MapBufferFn = void *(APIENTRY *)(GLenum, GLenum);
+  using UnmapBufferFn = GLboolean(APIENTRY *)(GLenum);
+
+  template <typename Fn> static void load(Fn &fn, const char *name) {
+    fn = reinterpret_cast<Fn>(sf::Context::getFunction(name));
+  }
+
+  sf::Vector2u m_size;
+  std::size_t m_bytes;
+  bool m_async;
+  std::array<GLuint, SLOTS> m_buffers;
+  std::array<bool, SLOTS> m_pending;
+  std::size_t m_next;
+
+  GenBuffersFn m_genBuffers = nullptr;
+  DeleteBuffersFn m_deleteBuffers = nullptr;
+  BindBufferFn m_bindBuffer = nullptr;
+  BufferDataFn m_bufferData = nullptr;
+  MapBufferFn m_mapBuffer = nullptr;
+  UnmapBufferFn m_unmapBuffer = nullptr;
+};
+
+/**
+ * Encodes frames (RGBA, bottom row first) on the writer thread
+ */
+class CaptureWriter {
+public:
+  virtual ~CaptureWriter() = default;
+  virtual bool write(const std::uint8_t *rgba) = 0;
+
+  // nullptr when the output cannot be created
+  static std::unique_ptr<CaptureWriter> create(const CaptureConfig &config,
+                                               sf::Vector2u size);
+};
+
+namespace {
+
+/**
+ * YUV4MPEG2 with full-range BT.601 4:2:0 chroma (C420jpeg)
+ */
+class Y4mWriter : public CaptureWriter {
+public:
+  Y4mWriter(const std::filesystem::path &path, sf::Vector2u size,
+            unsigned int frameRate)
+      : m_file(path, std::ios::binary | std::ios::trunc), m_size(size),
+        m_chromaSize((size.x + 1) / 2, (size.y + 1) / 2),
+        m_planes(std::size_t(size.x) * size.y +
+                 2 * std::size_t(m_chromaSize.x) * m_chromaSize.y) {
+    char header[96];
+    int length = std::snprintf(
+        header, sizeof(header), "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n",
+        size.x, size.y, frameRate);
+    m_file.write(header, length);
+  }
+
+  bool isOpen() const { return m_file.good(); }
+
+  bool write(const std::uint8_t *rgba) override {
+    convert(rgba);
+    m_file.write("FRAME\n", 6);
+    m_file.write(reinterpret_cast<const char *>(m_planes.data()),
+                 static_cast<std::streamsize>(m_planes.size()));
+    return m_file.good();
+  }
+
+private:
+  // Top row first; chroma averages each 2x2 block
+  void convert(const std::uint8_t *rgba) {
+    const std::size_t stride = std::size_t(m_size.x) * 4;
+    std::uint8_t *luma = m_planes.data();
+    std::uint8_t *cb = luma + std::size_t(m_size.x) * m_size.y;
+    std::uint8_t *cr = cb + std::size_t(m_chromaSize.x) * m_chromaSize.y;
+
+    for (unsigned int y = 0; y < m_size.y; ++y) {
+      const std::uint8_t *row = rgba + (m_size.y - 1 - y) * stride;
+      std::uint8_t *out = luma + std::size_t(y) * m_size.x;
+      for (unsigned int x = 0; x < m_size.x; ++x) {
+        const std::uint8_t *p = row + x * 4;
+        out[x] = static_cast<std::uint8_t>(
+            (77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+      }
+    }
+
+    for (unsigned int cy = 0; cy < m_chromaSize.y; ++cy) {
+      unsigned int y0 = cy * 2;
+      unsigned int y1 = std::min(y0 + 1, m_size.y - 1);
+      const std::uint8_t *row0 = rgba + (m_size.y - 1 - y0) * stride;
+      const std::uint8_t *row1 = rgba + (m_size.y - 1 - y1) * stride;
+      for (unsigned int cx = 0; cx < m_chromaSize.x; ++cx) {
+        unsigned int x0 = cx * 2 * 4;
+        unsigned int x1 = std::min(cx * 2 + 1, m_size.x - 1) * 4;
+        int r = row0[x0] + row0[x1] + row1[x0] + row1[x1];
+        int g = row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1];
+        int b = row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2];
+        std::size_t i = std::size_t(cy) * m_chromaSize.x + cx;
+        // Sums of four samples: scale by 1/4 along with the 8-bit weights
+        cb[i] = static_cast<std::uint8_t>(
+            std::clamp(((-43 * r - 85 * g + 128 * b + 512) >> 10) + 128, 0,
+                       255));
+        cr[i] = static_cast<std::uint8_t>(
+            std::clamp(((128 * r - 107 * g - 21 * b + 512) >> 10) + 128, 0,
+                       255));
+      }
+    }
+  }
+
+  std::ofstream m_file;
+  sf::Vector2u m_size;
+  sf::Vector2u m_chromaSize;
+  std::vector<std::uint8_t> m_planes; // Y, Cb, Cr
+};
+
+/**
+ * Raw RGBA frames back to back, top row first
+ */
+class RawWriter : public CaptureWriter {
+public:
+  RawWriter(const std::filesystem::path &path, sf::Vector2u size)
+      : m_file(path, std::ios::binary | std::ios::trunc), m_size(size) {}
+
+  bool isOpen() const { return m_file.good(); }
+
+  bool write(const std::uint8_t *rgba) override {
+    const std::size_t stride = std::size_t(m_size.x) * 4;
+    for (unsigned int y = m_size.y; y-- > 0;)
+      m_file.write(reinterpret_cast<const char *>(rgba + y * stride),
+                   static_cast<std::streamsize>(stride));
+    return m_file.good();
+  }
+
+private:
+  std::ofstream m_file;
+  sf::Vector2u m_size;
+};
+
+/**
+ * Numbered PNG files (frame_000000.png, ...)
+ */
+class ImageWriter : public CaptureWriter {
+public:
+  ImageWriter(const std::filesystem::path &directory, sf::Vector2u size)
+      : m_directory(directory), m_size(size),
+        m_flipped(std::size_t(size.x) * size.y * 4), m_frame(0) {}
+
+  bool write(const std::uint8_t *rgba) override {
+    const std::size_t stride = std::size_t(m_size.x) * 4;
+    for (unsigned int y = 0; y < m_size.y; ++y)
+      std::memcpy(m_flipped.data() + y * stride,
+                  rgba + (m_size.y - 1 - y) * stride, stride);
+    m_image.resize(m_size, m_flipped.data());
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06u.png", m_frame++);
+    return m_image.saveToFile(m_directory / name);
+  }
+
+private:
+  std::filesystem::path m_directory;
+  sf::Vector2u m_size;
+  std::vector<std::uint8_t> m_flipped;
+  sf::Image m_image;
+  unsigned int m_frame;
+};
+
+} // namespace
+
+std::unique_ptr<CaptureWriter>
+CaptureWriter::create(const CaptureConfig &config, sf::Vector2u size) {
+  switch (config.format) {
+  case CaptureFormat::Y4m: {
+    auto writer =
+        std::make_unique<Y4mWriter>(config.path, size, config.frameRate);
+    if (writer->isOpen())
+      return writer;
+    break;
+  }
+  case CaptureFormat::Raw: {
+    auto writer = std::make_unique<RawWriter>(config.path, size);
+    if (writer->isOpen())
+      return writer;
+    break;
+  }
+  case CaptureFormat::ImageSequence: {
+    std::error_code error;
+    std::filesystem::create_directories(config.path, error);
+    if (std::filesystem::is_directory(config.path, error))
+      return std::make_unique<ImageWriter>(config.path, size);
+    break;
+  }
+  }
+  return nullptr;
+}
+
+CaptureFormat CaptureConfig::formatFor(const std::filesystem::path &path) {
+  std::filesystem::path extension = path.extension();
+  if (extension == ".y4m")
+    return CaptureFormat::Y4m;
+  if (extension == ".rgba" || extension == ".raw")
+    return CaptureFormat::Raw;
+  return CaptureFormat::ImageSequence;
+}
+
+FrameCapture::FrameCapture() = default;
+
+FrameCapture::~FrameCapture() { stop(); }
+
+bool FrameCapture::start(const CaptureConfig &config, sf::Vector2u frameSize) {
+  if (m_running.load() || frameSize.x == 0 || frameSize.y == 0)
+    return false;
+
+  m_config = config;
+  m_config.bufferCount = std::clamp<std::size_t>(config.bufferCount, 2,
+                                                 MAX_BUFFERS);
+  m_size = frameSize;
+  m_writer = CaptureWriter::create(m_config, m_size);
+  if (!m_writer)
+    return false;
+
+  // Every frame buffer is allocated here and recycled through m_free
+  std::uint32_t index = 0;
+  while (m_free.tryPop(index)) {
+  }
+  while (m_ready.tryPop(index)) {
+  }
+  m_buffers.assign(m_config.bufferCount,
+                   std::vector<std::uint8_t>(std::size_t(m_size.x) *
+                                             m_size.y * 4));
+  for (std::uint32_t i = 0; i < m_buffers.size(); ++i)
+    m_free.tryPush(i);
+
+  m_readback.reset();
+  m_captured = 0;
+  m_renderDropped = 0;
+  m_captureMs = 0.0;
+  m_maxCaptureMs = 0.0;
+  m_written.store(0);
+  m_writeFailed.store(0);
+
+  m_running.store(true);
+  m_thread = std::thread(&FrameCapture::writerLoop, this);
+  return true;
+}
+
+std::uint32_t FrameCapture::acquireBuffer() {
+  std::uint32_t index = NO_BUFFER;
+  if (!m_free.tryPop(index)) {
+    ++m_renderDropped;
+    return NO_BUFFER;
+  }
+  return index;
+}
+
+void FrameCapture::collect() {
+  std::uint32_t index = acquireBuffer();
+  m_readback->collectOldest(index != NO_BUFFER ? m_buffers[index].data()
+                                               : nullptr);
+  if (index != NO_BUFFER) {
+    m_ready.tryPush(index); // Cannot be full: only bufferCount indices exist
+    ++m_captured;
+  }
+}
+
+void FrameCapture::capture(sf::RenderTarget &target) {
+  if (!isRunning())
+    return;
+
+  std::int64_t start = LatencyTracker::now();
+  if (target.getSize() != m_size || !target.setActive(true)) {
+    ++m_renderDropped;
+    return;
+  }
+  if (!m_readback)
+    m_readback = std::make_unique<CaptureReadback>(m_size);
+
+  if (m_readback->isAsync()) {
+    // The slot being reused was read SLOTS frames ago and is complete
+    if (m_readback->oldestPending())
+      collect();
+    m_readback->issue();
+  } else {
+    std::uint32_t index = acquireBuffer();
+    if (index != NO_BUFFER) {
+      m_readback->readPixels(m_buffers[index].data());
+      m_ready.tryPush(index);
+      ++m_captured;
+    }
+  }
+
+  double ms = (LatencyTracker::now() - start) * 1.0e-6;
+  m_captureMs += ms;
+  m_maxCaptureMs = std::max(m_maxCaptureMs, ms);
+}
+
+void FrameCapture::stop() {
+  if (!isRunning())
+    return;
+
+  // Readbacks still in flight are the last frames; collect them in order
+  if (m_readback) {
+    sf::Context context;
+    for (std::size_t i = 0; i < CaptureReadback::SLOTS; ++i) {
+      if (m_readback->oldestPending()) {
+        // Give the writer a moment rather than dropping the final frames
+        for (int wait = 0; wait < 100 && m_free.size() == 0; ++wait)
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        collect();
+      }
+      m_readback->advance();
+    }
+    m_readback->release();
+  }
+  m_readback.reset();
+
+  m_running.store(false);
+  if (m_thread.joinable())
+    m_thread.join();
+  m_writer.reset();
+}
+
+FrameCapture::Stats FrameCapture::getStats() const {
+  Stats stats;
+  stats.captured = m_captured;
+  stats.written = m_written.load(std::memory_order_relaxed);
+  stats.dropped =
+      m_renderDropped + m_writeFailed.load(std::memory_order_relaxed);
+  stats.captureMs = m_captureMs;
+  stats.maxCaptureMs = m_maxCaptureMs;
+  return stats;
+}
+
+void FrameCapture::drainReady() {
+  std::uint32_t index = 0;
+  while (m_ready.tryPop(index)) {
+    if (m_writer->write(m_buffers[index].data()))
+      m_written.fetch_add(1, std::memory_order_relaxed);
+    else
+      m_writeFailed.fetch_add(1, std::memory_order_relaxed);
+    m_free.tryPush(index);
+  }
+}
+
+void FrameCapture::writerLoop() {
+  // Poll like the telemetry writer, so capturing never pays for a wakeup
+  while (m_running.load(std::memory_order_relaxed)) {
+    drainReady();
+    std::this_thread::sleep_for(std::chrono::milliseconds(WRITER_POLL_MS));
+  }
+  drainReady();
+}
@@ -0,0 +1,38 @@
+#include "graphics/ParticleBudget.hpp"
+#include <algorithm>
+
+ParticleBudget::ParticleBudget(float targetFrameMs)
+    : m_targetMs(targetFrameMs), m_frameMs(0.0f), m_particleMs(0.0f),
+      m_msPerParticle(0.0f), m_budget(1.0f) {}
+
+float ParticleBudget::update(const FrameCost &cost) {
+  m_frameMs += (cost.frameMs - m_frameMs) * SMOOTHING;
+  m_particleMs += (cost.particleMs - m_particleMs) * SMOOTHING;
+
+  // Per-particle cost, from frames with enough particles to measure
+  if (cost.liveParticles >= MIN_SAMPLE_PARTICLES) {
+    float perParticle = cost.particleMs / cost.liveParticles;
+    m_msPerParticle = m_msPerParticle > 0.0f
+                          ? m_msPerParticle +
+                                (perParticle - m_msPerParticle) * SMOOTHING
+                          : perParticle;
+  }
+
+  // Everything else keeps its cost; particles get what is left of the
+  // target. Live particles scale with the budget, so the count the effects
+  // want at full rate is about live / budget.
+  float wanted = 1.0f;
+  float available = m_targetMs * HEADROOM - (m_frameMs - m_particleMs);
+  if (m_msPerParticle > 0.0f && cost.liveParticles > 0) {
+    float fits = available / m_msPerParticle;
+    float demand = cost.liveParticles / m_budget;
+    wanted = fits / demand;
+  } else if (m_frameMs > m_targetMs * HEADROOM) {
+    wanted = 0.0f; // No estimate yet, but over budget: back off
+  }
+  wanted = std::clamp(wanted, MIN_BUDGET, 1.0f);
+
+  float step = wanted < m_budget ? DECREASE : RECOVER;
+  m_budget += (wanted - m_budget) * step;
+  return m_budget;
+}
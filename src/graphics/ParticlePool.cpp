@@ -0,0 +1,85 @@
+#include "graphics/ParticlePool.hpp"
+#include "core/AllocationTracker.hpp"
+
+void ParticleChunkPool::configure(std::size_t maxChunks,
+                                  std::size_t preallocate) {
+  m_chunks.clear();
+  m_chunks.reserve(maxChunks);
+  m_free.assign(maxChunks, nullptr);
+  m_maxChunks = maxChunks;
+  m_nextFree = 0;
+  m_freeCount = 0;
+
+  for (std::size_t i = 0; i < preallocate && i < maxChunks; ++i) {
+    m_chunks.push_back(std::make_unique<StoredParticle[]>(CHUNK_SIZE));
+    release(m_chunks.back().get());
+  }
+}
+
+StoredParticle *ParticleChunkPool::acquire() {
+  if (m_freeCount > 0) {
+    StoredParticle *chunk = m_free[m_nextFree];
+    m_nextFree = (m_nextFree + 1) % m_maxChunks;
+    --m_freeCount;
+    return chunk;
+  }
+  if (m_chunks.size() < m_maxChunks) {
+    AllocationScope scope(AllocTag::Growth);
+    m_chunks.push_back(std::make_unique<StoredParticle[]>(CHUNK_SIZE));
+    return m_chunks.back().get();
+  }
+  return nullptr;
+}
+
+void ParticleChunkPool::release(StoredParticle *chunk) {
+  m_free[(m_nextFree + m_freeCount) % m_maxChunks] = chunk;
+  ++m_freeCount;
+}
+
+bool ParticleQueue::push(ParticleChunkPool &pool,
+                         const StoredParticle &particle) {
+  std::size_t tail = m_head + m_size;
+  std::size_t chunk = tail / ParticleChunkPool::CHUNK_SIZE;
+  if (chunk == m_chunks.size()) {
+    StoredParticle *storage = pool.acquire();
+    if (!storage)
+      return false;
+    m_chunks.push_back(storage);
+  }
+  m_chunks[chunk][tail % ParticleChunkPool::CHUNK_SIZE] = particle;
+  ++m_size;
+  return true;
+}
+
+void ParticleQueue::dropOldest(ParticleChunkPool &pool, std::size_t count) {
+  if (count >= m_size) {
+    clear(pool);
+    return;
+  }
+  m_head += count;
+  m_size -= count;
+
+  // Hand back chunks the head has moved past
+  std::size_t passed = m_head / ParticleChunkPool::CHUNK_SIZE;
+  if (passed > 0) {
+    for (std::size_t i = 0; i < passed; ++i)
+      pool.release(m_chunks[i]);
+    m_chunks.erase(m_chunks.begin(), m_chunks.begin() + passed);
+    m_head -= passed * ParticleChunkPool::CHUNK_SIZE;
+  }
+}
+
+void ParticleQueue::truncate(ParticleChunkPool &pool, std::size_t count) {
+  if (count < m_size)
+    m_size = count;
+  if (m_size == 0)
+    m_head = 0;
+
+  // Hand back chunks past the newest particle
+  std::size_t needed =
+      m_size > 0 ? ParticleChunkPool::chunksFor(m_head + m_size) : 0;
+  for (std::size_t i = needed; i < m_chunks.size(); ++i)
+    pool.release(m_chunks[i]);
+  if (needed < m_chunks.size())
+    m_chunks.resize(needed);
+}
@@ -1,195 +1,685 @@
 #include "graphics/ParticleSystem.hpp"
+#include "math/FastMath.hpp"
+#include "math/Half.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <random>
+#include <utility>
 
-// Random number generator
-static std::random_device rd;
-static std::mt19937 rng(rd());
-static std::uniform_real_distribution<float> randFloat(0.0f, 1.0f);
-static std::uniform_real_distribution<float> randAngle(0.0f, 360.0f);
+namespace {
 
-ParticleSystem::ParticleSystem(std::size_t maxParticles)
-    : m_particles(maxParticles), m_vertices(sf::PrimitiveType::Triangles) {
-  // Initialize all particles as inactive
-  for (auto &p : m_particles) {
-    p.active = false;
+float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<float, std::milli>(Clock::now() - start)
+      .count();
+}
+
+sf::Color lerpColor(const sf::Color &a, const sf::Color &b, float t) {
+  auto channel = [t](std::uint8_t x, std::uint8_t y) {
+    return static_cast<std::uint8_t>(x + (y - x) * t);
+  };
+  return sf::Color(channel(a.r, b.r), channel(a.g, b.g), channel(a.b, b.b),
+                   channel(a.a, b.a));
+}
+
+/**
+ * What the vertex kernels need from an effect
+ */
+struct VertexParams {
+  const sf::Color *gradientLut;
+  std::size_t lutSize;
+  float sizeEnd;
+  const sf::Color *palette; // Compact storage: spawn colors
+  sf::Vector2f origin;      // Compact storage: emitter origin
+};
+
+/**
+ * Write two triangles for one particle, applying the life-dependent
+ * features
+ */
+template <unsigned Features>
+sf::Vertex *writeQuad(sf::Vector2f position, float size, sf::Color color,
+                      float lifeRatio, const VertexParams &params,
+                      sf::Vertex *out) {
+  // Tint by gradient over life
+  if constexpr ((Features & ParticleFeature::Gradient) != 0) {
+    std::size_t index = static_cast<std::size_t>(
+        (1.0f - lifeRatio) * (params.lutSize - 1) + 0.5f);
+    const sf::Color &tint = params.gradientLut[index];
+    color.r = static_cast<std::uint8_t>(color.r * tint.r / 255);
+    color.g = static_cast<std::uint8_t>(color.g * tint.g / 255);
+    color.b = static_cast<std::uint8_t>(color.b * tint.b / 255);
+    color.a = static_cast<std::uint8_t>(color.a * tint.a / 255);
   }
+
+  // Fade out based on lifetime
+  if constexpr ((Features & ParticleFeature::Fade) != 0) {
+    color.a = static_cast<std::uint8_t>(color.a * lifeRatio);
+  }
+
+  // Shrink along the size curve
+  float halfSize = size * 0.5f;
+  if constexpr ((Features & ParticleFeature::Shrink) != 0) {
+    halfSize *= params.sizeEnd + (1.0f - params.sizeEnd) * lifeRatio;
+  }
+
+  // Create a quad (2 triangles) for each particle
+  sf::Vector2f topLeft = position + sf::Vector2f(-halfSize, -halfSize);
+  sf::Vector2f topRight = position + sf::Vector2f(halfSize, -halfSize);
+  sf::Vector2f bottomRight = position + sf::Vector2f(halfSize, halfSize);
+  sf::Vector2f bottomLeft = position + sf::Vector2f(-halfSize, halfSize);
+
+  // Triangle 1
+  out[0].position = topLeft;
+  out[1].position = topRight;
+  out[2].position = bottomRight;
+
+  // Triangle 2
+  out[3].position = topLeft;
+  out[4].position = bottomRight;
+  out[5].position = bottomLeft;
+
+  for (int v = 0; v < 6; ++v)
+    out[v].color = color;
+  return out + 6;
 }
 
-Particle *ParticleSystem::getAvailableParticle() {
-  for (auto &p : m_particles) {
-    if (!p.active) {
-      return &p;
+#ifdef NEONDRIFT_COMPACT_PARTICLES
+
+constexpr float MAX_OFFSET = 32767.0f; // Position units from the origin
+constexpr float REBASE_DISTANCE = 1920.0f; // Pixels, spawns beyond move it
+constexpr float REBASE_OFFSET = 1024.0f;   // Pixels, spawn to new origin
+
+std::int16_t quantize(float value) {
+  return static_cast<std::int16_t>(value + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+/**
+ * Compact storage: the same update on quantized fields. Particles that
+ * would leave the representable range around the origin die.
+ */
+template <unsigned Features>
+std::size_t updateKernel(ParticleQueue &particles, float deltaTime,
+                         float dragFactor) {
+  float moveScale = deltaTime * CompactParticle::POSITION_SCALE;
+  float lifeScale = deltaTime * CompactParticle::DECAY_SCALE;
+
+  ParticleQueue::Cursor read = particles.begin();
+  ParticleQueue::Cursor write = read;
+  std::size_t survivors = 0;
+  for (std::size_t i = particles.size(); i > 0; --i, read.advance()) {
+    CompactParticle p = *read;
+
+    // Update lifetime
+    std::uint32_t lost = static_cast<std::uint32_t>(p.decay * lifeScale + 0.5f);
+    if (lost >= p.life)
+      continue;
+    p.life = static_cast<std::uint16_t>(p.life - lost);
+
+    // Update position
+    float vx = half::toFloat(p.vx);
+    float vy = half::toFloat(p.vy);
+    float x = p.x + vx * moveScale;
+    float y = p.y + vy * moveScale;
+    if (std::fabs(x) > MAX_OFFSET || std::fabs(y) > MAX_OFFSET)
+      continue;
+    p.x = quantize(x);
+    p.y = quantize(y);
+
+    // Apply drag
+    if constexpr ((Features & ParticleFeature::Drag) != 0) {
+      p.vx = half::fromFloat(vx * dragFactor);
+      p.vy = half::fromFloat(vy * dragFactor);
     }
+
+    *write = p;
+    write.advance();
+    ++survivors;
   }
-  return nullptr; // Pool exhausted
+  return survivors;
 }
 
-void ParticleSystem::update(float deltaTime) {
-  for (auto &p : m_particles) {
-    if (!p.active)
+// Expand quantized particles into quads
+template <unsigned Features>
+sf::Vertex *vertexKernel(const ParticleQueue &particles,
+                         const VertexParams &params, sf::Vertex *out) {
+  constexpr float TO_PIXELS = 1.0f / CompactParticle::POSITION_SCALE;
+  constexpr float TO_SIZE = 1.0f / CompactParticle::SIZE_SCALE;
+  constexpr float TO_RATIO = 1.0f / CompactParticle::FULL_LIFE;
+
+  ParticleQueue::ConstCursor cursor = particles.begin();
+  for (std::size_t i = particles.size(); i > 0; --i, cursor.advance()) {
+    const CompactParticle &p = *cursor;
+    sf::Vector2f position =
+        params.origin + sf::Vector2f(p.x * TO_PIXELS, p.y * TO_PIXELS);
+    out = writeQuad<Features>(position, p.size * TO_SIZE,
+                              params.palette[p.palette], p.life * TO_RATIO,
+                              params, out);
+  }
+  return out;
+}
+
+// Re-express an effect's particles around a new origin; any that fall out
+// of range are left dead for the next update
+void rebase(ParticleQueue &particles, sf::Vector2f shift) {
+  float dx = shift.x * CompactParticle::POSITION_SCALE;
+  float dy = shift.y * CompactParticle::POSITION_SCALE;
+  ParticleQueue::Cursor cursor = particles.begin();
+  for (std::size_t i = particles.size(); i > 0; --i, cursor.advance()) {
+    CompactParticle &p = *cursor;
+    float x = p.x + dx;
+    float y = p.y + dy;
+    if (std::fabs(x) > MAX_OFFSET || std::fabs(y) > MAX_OFFSET) {
+      p.life = 0;
+      p.size = 0;
       continue;
+    }
+    p.x = quantize(x);
+    p.y = quantize(y);
+  }
+}
+
+#else
+
+/**
+ * Advance particles and compact out dead ones, keeping survivors in spawn
+ * order; returns how many survived
+ */
+template <unsigned Features>
+std::size_t updateKernel(ParticleQueue &particles, float deltaTime,
+                         float dragFactor) {
+  ParticleQueue::Cursor read = particles.begin();
+  ParticleQueue::Cursor write = read;
+  std::size_t survivors = 0;
+  for (std::size_t i = particles.size(); i > 0; --i, read.advance()) {
+    Particle p = *read;
 
     // Update lifetime
     p.lifetime -= deltaTime;
-    if (p.lifetime <= 0.0f) {
-      p.active = false;
+    if (p.lifetime <= 0.0f)
       continue;
-    }
 
     // Update position
     p.position += p.velocity * deltaTime;
 
     // Apply drag
-    p.velocity *= 0.98f;
+    if constexpr ((Features & ParticleFeature::Drag) != 0) {
+      p.velocity *= dragFactor;
+    }
 
-    // Fade out based on lifetime
-    float lifeRatio = p.lifetime / p.maxLifetime;
-    p.color.a = static_cast<std::uint8_t>(255 * lifeRatio);
+    *write = p;
+    write.advance();
+    ++survivors;
+  }
+  return survivors;
+}
 
-    // Shrink slightly
-    p.size *= (0.98f + 0.02f * lifeRatio);
+template <unsigned Features>
+sf::Vertex *vertexKernel(const ParticleQueue &particles,
+                         const VertexParams &params, sf::Vertex *out) {
+  ParticleQueue::ConstCursor cursor = particles.begin();
+  for (std::size_t i = particles.size(); i > 0; --i, cursor.advance()) {
+    const Particle &p = *cursor;
+    out = writeQuad<Features>(p.position, p.size, p.color,
+                              p.lifetime / p.maxLifetime, params, out);
   }
+  return out;
 }
 
-void ParticleSystem::render(sf::RenderWindow &window) {
-  m_vertices.clear();
+#endif
 
-  for (const auto &p : m_particles) {
-    if (!p.active)
-      continue;
+using UpdateFn = std::size_t (*)(ParticleQueue &, float, float);
+using VertexFn = sf::Vertex *(*)(const ParticleQueue &, const VertexParams &,
+                                 sf::Vertex *);
 
-    // Create a quad (2 triangles) for each particle
-    float halfSize = p.size * 0.5f;
+// One kernel instantiation per feature combination, indexed by feature mask
+template <std::size_t... Masks>
+constexpr std::array<UpdateFn, sizeof...(Masks)>
+makeUpdateKernels(std::index_sequence<Masks...>) {
+  return {{&updateKernel<static_cast<unsigned>(Masks)>...}};
+}
+template <std::size_t... Masks>
+constexpr std::array<VertexFn, sizeof...(Masks)>
+makeVertexKernels(std::index_sequence<Masks...>) {
+  return {{&vertexKernel<static_cast<unsigned>(Masks)>...}};
+}
 
-    sf::Vertex v1, v2, v3, v4;
-    v1.position = p.position + sf::Vector2f(-halfSize, -halfSize);
-    v2.position = p.position + sf::Vector2f(halfSize, -halfSize);
-    v3.position = p.position + sf::Vector2f(halfSize, halfSize);
-    v4.position = p.position + sf::Vector2f(-halfSize, halfSize);
+constexpr auto UPDATE_KERNELS = makeUpdateKernels(
+    std::make_index_sequence<ParticleFeature::COMBINATIONS>());
+constexpr auto VERTEX_KERNELS = makeVertexKernels(
+    std::make_index_sequence<ParticleFeature::COMBINATIONS>());
+
+} // namespace
+
+ParticleSystem::ParticleSystem(std::size_t maxParticles)
+    : m_maxParticles(maxParticles), m_liveCap(maxParticles), m_liveCount(0),
+      m_lastDeltaTime(1.0f / 60.0f), m_rng(std::random_device{}()),
+      m_policy(PoolPolicy::EvictOldest), m_budget(1.0f), m_updateMs(0.0f),
+      m_buildMs(0.0f), m_driftEmitter(INVALID_EMITTER),
+      m_collisionEmitter(INVALID_EMITTER), m_speedEmitter(INVALID_EMITTER) {
+  setEmitters(defaultEmitterDescriptors());
+}
 
-    v1.color = v2.color = v3.color = v4.color = p.color;
+bool ParticleSystem::loadEmitters(const std::filesystem::path &path) {
+  std::vector<EmitterDescriptor> descriptors;
+  if (!loadEmitterDescriptors(path, descriptors))
+    return false;
+  setEmitters(std::move(descriptors));
+  return true;
+}
 
-    // Triangle 1
-    m_vertices.append(v1);
-    m_vertices.append(v2);
-    m_vertices.append(v3);
+void ParticleSystem::setEmitters(std::vector<EmitterDescriptor> descriptors) {
+  clear();
+  m_descriptors = std::move(descriptors);
+  m_groups.clear();
+  m_groups.resize(m_descriptors.size());
+
+  for (std::size_t i = 0; i < m_descriptors.size(); ++i) {
+    const EmitterDescriptor &desc = m_descriptors[i];
+    ParticleGroup &group = m_groups[i];
+    group.features = desc.features();
+
+    if (group.features & ParticleFeature::Gradient) {
+      group.gradientLut.resize(GRADIENT_LUT_SIZE);
+      std::size_t segments = desc.gradient.size() - 1;
+      for (std::size_t k = 0; k < GRADIENT_LUT_SIZE; ++k) {
+        float t = static_cast<float>(k) / (GRADIENT_LUT_SIZE - 1) * segments;
+        std::size_t seg = std::min(static_cast<std::size_t>(t), segments - 1);
+        group.gradientLut[k] = lerpColor(desc.gradient[seg],
+                                         desc.gradient[seg + 1], t - seg);
+      }
+    }
 
-    // Triangle 2
-    m_vertices.append(v1);
-    m_vertices.append(v3);
-    m_vertices.append(v4);
+#ifdef NEONDRIFT_COMPACT_PARTICLES
+    // Compact particles store their spawn color as a step along the range
+    group.palette.resize(PALETTE_SIZE);
+    for (std::size_t k = 0; k < PALETTE_SIZE; ++k)
+      group.palette[k] = lerpColor(desc.colorLow, desc.colorHigh,
+                                   static_cast<float>(k) / (PALETTE_SIZE - 1));
+#endif
   }
 
-  // Enable additive blending for glow effect
-  sf::RenderStates states;
-  states.blendMode = sf::BlendAdd;
+  m_driftEmitter = findEmitter("drift_trail");
+  m_collisionEmitter = findEmitter("collision_burst");
+  m_speedEmitter = findEmitter("speed_lines");
+  configurePool();
+}
 
-  window.draw(m_vertices, states);
+void ParticleSystem::setPoolPolicy(PoolPolicy policy, std::size_t hardLimit) {
+  clear();
+  m_policy = policy;
+  m_liveCap = m_maxParticles;
+  if (policy == PoolPolicy::Grow)
+    m_liveCap = std::max(hardLimit > 0 ? hardLimit : m_maxParticles * 2,
+                         m_maxParticles);
+  configurePool();
 }
 
-void ParticleSystem::emitDriftTrail(const sf::Vector2f &position,
-                                    const sf::Vector2f &velocity,
-                                    float driftAmount, float direction) {
-  // Emit 2-4 particles per call
-  int count = 2 + static_cast<int>(driftAmount * 2);
+void ParticleSystem::configurePool() {
+  // Each effect may leave up to two chunks partly used (its oldest and
+  // newest), so this many chunks always hold the live cap
+  std::size_t slack = 2 * m_groups.size();
+  std::size_t maxChunks = ParticleChunkPool::chunksFor(m_liveCap) + slack;
+  std::size_t preallocate =
+      m_policy == PoolPolicy::Grow
+          ? ParticleChunkPool::chunksFor(m_maxParticles) + slack
+          : maxChunks;
+  m_pool.configure(maxChunks, preallocate);
+
+  // Chunk lists are sized up front so emission never grows the heap
+  for (ParticleGroup &group : m_groups)
+    group.particles.reserveChunks(maxChunks);
+
+  m_poolStats = PoolStats();
+  applyBudget();
+}
 
-  for (int i = 0; i < count; ++i) {
-    Particle *p = getAvailableParticle();
-    if (!p)
-      return;
+ParticleSystem::PoolStats ParticleSystem::getPoolStats() const {
+  PoolStats stats = m_poolStats;
+  stats.allocatedChunks = m_pool.getAllocatedChunks();
+  stats.maxChunks = m_pool.getMaxChunks();
+  return stats;
+}
 
-    p->active = true;
-    p->position = position;
+void ParticleSystem::setBudget(float budget) {
+  budget = std::clamp(budget, 0.0f, 1.0f);
+  if (budget == m_budget)
+    return;
+  m_budget = budget;
+  applyBudget();
+}
 
-    // Add some randomness to velocity
-    float spreadAngle = (randFloat(rng) - 0.5f) * 30.0f;
-    float speed = 20.0f + randFloat(rng) * 40.0f;
-    float angle = std::atan2(velocity.y, velocity.x) + 3.14159f +
-                  spreadAngle * 0.0174533f;
+void ParticleSystem::applyBudget() {
+  float normalLimit = m_liveCap * (1.0f - ESSENTIAL_RESERVE) * m_budget;
+
+  for (std::size_t i = 0; i < m_groups.size(); ++i) {
+    ParticleGroup &group = m_groups[i];
+    switch (m_descriptors[i].priority) {
+    case EffectPriority::Essential:
+      group.rateScale = 1.0f;
+      group.liveLimit = m_liveCap;
+      break;
+    case EffectPriority::Normal:
+      group.rateScale = m_budget;
+      group.liveLimit = static_cast<std::size_t>(normalLimit);
+      break;
+    case EffectPriority::Cosmetic:
+      group.rateScale = m_budget * m_budget;
+      group.liveLimit = static_cast<std::size_t>(normalLimit * COSMETIC_SHARE);
+      break;
+    }
+  }
+}
+
+ParticleSystem::EmitterId
+ParticleSystem::findEmitter(const std::string &name) const {
+  for (std::size_t i = 0; i < m_descriptors.size(); ++i) {
+    if (m_descriptors[i].name == name)
+      return static_cast<EmitterId>(i);
+  }
+  return INVALID_EMITTER;
+}
 
-    p->velocity =
-        sf::Vector2f(std::cos(angle) * speed, std::sin(angle) * speed);
+void ParticleSystem::update(float deltaTime) {
+  Clock::time_point start = Clock::now();
+  m_lastDeltaTime = deltaTime;
+
+  for (std::size_t i = 0; i < m_groups.size(); ++i) {
+    ParticleGroup &group = m_groups[i];
+    if (group.particles.empty())
+      continue;
 
-    // Neon colors based on drift amount
-    // Blend from cyan to magenta as drift intensifies
-    float blend = driftAmount * 0.8f + randFloat(rng) * 0.2f;
-    std::uint8_t r = static_cast<std::uint8_t>(0 + 255 * blend);
-    std::uint8_t g = static_cast<std::uint8_t>(255 * (1.0f - blend * 0.3f));
-    std::uint8_t b = static_cast<std::uint8_t>(255);
-    p->color = sf::Color(r, g, b, 200);
+    // Drag is expressed per second; convert once per group, not per particle
+    float dragFactor = 1.0f;
+    if (group.features & ParticleFeature::Drag) {
+      dragFactor = std::pow(m_descriptors[i].drag, deltaTime);
+    }
 
-    p->lifetime = DRIFT_PARTICLE_LIFETIME * (0.7f + randFloat(rng) * 0.6f);
-    p->maxLifetime = p->lifetime;
-    p->size = BASE_SIZE * (1.0f + driftAmount * 0.5f);
+    std::size_t survivors =
+        UPDATE_KERNELS[group.features](group.particles, deltaTime, dragFactor);
+    m_liveCount -= group.particles.size() - survivors;
+    group.particles.truncate(m_pool, survivors);
   }
+  m_updateMs = elapsedMs(start);
 }
 
-void ParticleSystem::emitCollisionBurst(const sf::Vector2f &position,
-                                        const sf::Color &color) {
-  // Emit 15-25 particles in all directions
-  int count = 15 + static_cast<int>(randFloat(rng) * 10);
+std::size_t
+ParticleSystem::buildVertices(std::vector<sf::Vertex> &vertices) const {
+  Clock::time_point start = Clock::now();
+  if (vertices.size() < m_liveCap * 6) {
+    vertices.resize(m_liveCap * 6);
+  }
+
+  sf::Vertex *begin = vertices.data();
+  sf::Vertex *out = begin;
+  for (std::size_t i = 0; i < m_groups.size(); ++i) {
+    const ParticleGroup &group = m_groups[i];
+    if (group.particles.empty())
+      continue;
+    VertexParams params{group.gradientLut.data(), group.gradientLut.size(),
+                        m_descriptors[i].sizeEnd, group.palette.data(),
+                        group.origin};
+    out = VERTEX_KERNELS[group.features](group.particles, params, out);
+  }
+  m_buildMs = elapsedMs(start);
+  return static_cast<std::size_t>(out - begin);
+}
 
-  for (int i = 0; i < count; ++i) {
-    Particle *p = getAvailableParticle();
-    if (!p)
-      return;
+void ParticleSystem::render(CommandList &commands,
+                            const std::vector<sf::Vertex> &vertices,
+                            std::size_t vertexCount) {
+  if (vertexCount == 0)
+    return;
 
-    p->active = true;
-    p->position = position;
+  // Enable additive blending for glow effect
+  DrawState state;
+  state.blendMode = sf::BlendAdd;
 
-    float angle = randAngle(rng) * 0.0174533f; // Convert to radians
-    float speed = 150.0f + randFloat(rng) * 200.0f;
+  commands.submit(vertices.data(), vertexCount, sf::PrimitiveType::Triangles,
+                  state);
+}
 
-    p->velocity =
-        sf::Vector2f(std::cos(angle) * speed, std::sin(angle) * speed);
+void ParticleSystem::spawn(EmitterId id, const EmitParams &params, int count) {
+  const EmitterDescriptor &desc = m_descriptors[id];
+  ParticleGroup &group = m_groups[id];
+  float intensity = std::clamp(params.intensity, 0.0f, 1.0f);
 
-    // Orange-red sparks
-    p->color =
-        sf::Color(255, static_cast<std::uint8_t>(100 + randFloat(rng) * 100),
-                  static_cast<std::uint8_t>(randFloat(rng) * 50), 255);
+  // Directions are evaluated in batches with the 4-wide sincos
+  constexpr int BATCH = 32;
+  float angles[BATCH], sinA[BATCH], cosA[BATCH];
 
-    p->lifetime = COLLISION_PARTICLE_LIFETIME * (0.5f + randFloat(rng) * 0.5f);
-    p->maxLifetime = p->lifetime;
-    p->size = BASE_SIZE * (0.8f + randFloat(rng) * 0.6f);
+  while (count > 0) {
+    int batch = std::min(count, BATCH);
+    count -= batch;
+
+    for (int i = 0; i < batch; ++i) {
+      float spreadAngle = (m_rng.nextFloat() - 0.5f) * desc.spread;
+      angles[i] = (params.direction + spreadAngle) * fastmath::DEG_TO_RAD;
+    }
+    fastmath::sincosBatch(angles, sinA, cosA, static_cast<std::size_t>(batch));
+
+    for (int i = 0; i < batch; ++i) {
+      // Pool (or this effect's budgeted share) exhausted
+      if (m_liveCount >= group.liveLimit && !evictFor(id)) {
+        m_poolStats.dropped += static_cast<std::size_t>(batch - i + count);
+        return;
+      }
+
+      sf::Vector2f dir(cosA[i], sinA[i]);
+      float speed = lerp(desc.speedMin, desc.speedMax, m_rng.nextFloat()) +
+                    desc.inheritSpeed * params.sourceSpeed;
+      float colorT = intensity * desc.colorIntensity +
+                     m_rng.nextFloat() * (1.0f - desc.colorIntensity);
+
+      Particle p;
+      p.position = params.position + dir * desc.offset;
+      p.velocity = dir * speed;
+      p.color = lerpColor(desc.colorLow, desc.colorHigh, colorT);
+      p.lifetime =
+          lerp(desc.lifetimeMin, desc.lifetimeMax, m_rng.nextFloat());
+      p.maxLifetime = p.lifetime;
+      p.size = lerp(desc.sizeMin, desc.sizeMax, m_rng.nextFloat()) *
+               (1.0f + desc.sizeIntensity * intensity);
+
+      if (!group.particles.push(m_pool, pack(group, p, colorT))) {
+        m_poolStats.dropped += static_cast<std::size_t>(batch - i + count);
+        return; // No chunk left (the cap keeps this from happening)
+      }
+      ++m_liveCount;
+      m_poolStats.peakLive = std::max(m_poolStats.peakLive, m_liveCount);
+    }
   }
 }
 
-void ParticleSystem::emitSpeedLines(const sf::Vector2f &position, float speed,
-                                    float rotation) {
-  if (speed < 200.0f)
-    return; // Only at high speeds
+StoredParticle ParticleSystem::pack(ParticleGroup &group,
+                                    const Particle &particle, float colorT) {
+#ifdef NEONDRIFT_COMPACT_PARTICLES
+  // Follow the emitter: an empty effect takes the spawn point as its
+  // origin, a busy one moves its origin only when a spawn nears the edge of
+  // the range, and then only far enough to leave the spawn REBASE_OFFSET
+  // from it, so an emitter moving steadily rebases rarely
+  sf::Vector2f offset = particle.position - group.origin;
+  if (group.particles.empty()) {
+    group.origin = particle.position;
+    offset = sf::Vector2f(0.0f, 0.0f);
+  } else if (std::fabs(offset.x) > REBASE_DISTANCE ||
+             std::fabs(offset.y) > REBASE_DISTANCE) {
+    sf::Vector2f kept(std::clamp(offset.x, -REBASE_OFFSET, REBASE_OFFSET),
+                      std::clamp(offset.y, -REBASE_OFFSET, REBASE_OFFSET));
+    sf::Vector2f origin = particle.position - kept;
+    rebase(group.particles, group.origin - origin);
+    group.origin = origin;
+    offset = kept;
+  }
+
+  float decay = CompactParticle::FULL_LIFE /
+                (particle.maxLifetime * CompactParticle::DECAY_SCALE);
+  CompactParticle compact;
+  compact.x = quantize(offset.x * CompactParticle::POSITION_SCALE);
+  compact.y = quantize(offset.y * CompactParticle::POSITION_SCALE);
+  compact.vx = half::fromFloat(particle.velocity.x);
+  compact.vy = half::fromFloat(particle.velocity.y);
+  compact.life = CompactParticle::FULL_LIFE;
+  compact.decay = static_cast<std::uint16_t>(std::clamp(decay, 1.0f, 65535.0f));
+  compact.palette =
+      static_cast<std::uint8_t>(colorT * (PALETTE_SIZE - 1) + 0.5f);
+  compact.size = static_cast<std::uint8_t>(std::clamp(
+      particle.size * CompactParticle::SIZE_SCALE + 0.5f, 0.0f, 255.0f));
+  compact.padding = 0;
+  return compact;
+#else
+  (void)group;
+  (void)colorT;
+  return particle;
+#endif
+}
 
-  // Emit based on speed
-  float intensity = (speed - 200.0f) / 400.0f;
-  if (randFloat(rng) > intensity)
+bool ParticleSystem::evictFor(EmitterId id) {
+  if (m_policy == PoolPolicy::Drop)
+    return false;
+
+  // Only effects no more important than the spawning one give way: the
+  // least important first, and the spawning effect ahead of its peers
+  EffectPriority priority = m_descriptors[id].priority;
+  EmitterId victim = INVALID_EMITTER;
+  for (std::size_t i = 0; i < m_groups.size(); ++i) {
+    EffectPriority candidate = m_descriptors[i].priority;
+    if (m_groups[i].particles.empty() || candidate < priority)
+      continue;
+    if (victim == INVALID_EMITTER ||
+        candidate > m_descriptors[victim].priority ||
+        (candidate == m_descriptors[victim].priority &&
+         static_cast<EmitterId>(i) == id))
+      victim = static_cast<EmitterId>(i);
+  }
+  if (victim == INVALID_EMITTER)
+    return false;
+
+  m_groups[victim].particles.dropOldest(m_pool, 1);
+  --m_liveCount;
+  ++m_poolStats.evicted;
+  return true;
+}
+
+void ParticleSystem::emitContinuous(EmitterId id, const EmitParams &params,
+                                    float deltaTime) {
+  if (id == INVALID_EMITTER)
     return;
 
-  Particle *p = getAvailableParticle();
-  if (!p)
+  // Accumulate fractional particles so low rates still emit over time
+  const EmitterDescriptor &desc = m_descriptors[id];
+  ParticleGroup &group = m_groups[id];
+  float rate = lerp(desc.rateMin, desc.rateMax,
+                    std::clamp(params.intensity, 0.0f, 1.0f)) *
+               group.rateScale;
+  group.spawnAccumulator += rate * deltaTime;
+
+  int count = static_cast<int>(group.spawnAccumulator);
+  group.spawnAccumulator -= static_cast<float>(count);
+  spawn(id, params, count);
+}
+
+void ParticleSystem::emitBurst(EmitterId id, const EmitParams &params) {
+  if (id == INVALID_EMITTER)
     return;
 
-  p->active = true;
+  const EmitterDescriptor &desc = m_descriptors[id];
+  int range = desc.burstMax - desc.burstMin + 1;
+  int count = desc.burstMin +
+              std::min(range - 1, static_cast<int>(m_rng.nextFloat() * range));
+
+  // Thinner bursts under load, but never none
+  float scale = m_groups[id].rateScale;
+  if (scale < 1.0f && count > 0)
+    count = std::max(1, static_cast<int>(count * scale + 0.5f));
+  spawn(id, params, count);
+}
+
+void ParticleSystem::emitDriftTrail(const sf::Vector2f &position,
+                                    const sf::Vector2f &velocity,
+                                    float driftAmount, float direction) {
+  (void)direction;
+
+  // Trail points away from the direction of travel
+  EmitParams params;
+  params.position = position;
+  params.direction =
+      fastmath::atan2(velocity.y, velocity.x) * fastmath::RAD_TO_DEG + 180.0f;
+  params.intensity = driftAmount;
+  emitContinuous(m_driftEmitter, params, m_lastDeltaTime);
+}
 
-  // Spawn slightly behind player
-  float rad = rotation * 0.0174533f;
-  p->position =
-      position - sf::Vector2f(std::cos(rad) * 30.0f, std::sin(rad) * 30.0f);
+void ParticleSystem::emitCollisionBurst(const sf::Vector2f &position,
+                                        const sf::Color &color) {
+  (void)color;
 
-  // Move opposite to player direction
-  p->velocity = sf::Vector2f(-std::cos(rad) * speed * 0.3f,
-                             -std::sin(rad) * speed * 0.3f);
+  EmitParams params;
+  params.position = position;
+  emitBurst(m_collisionEmitter, params);
+}
 
-  // White/cyan speed lines
-  p->color = sf::Color(200, 255, 255, 150);
+void ParticleSystem::emitSpeedLines(const sf::Vector2f &position, float speed,
+                                    float rotation) {
+  if (speed < 200.0f)
+    return; // Only at high speeds
 
-  p->lifetime = 0.15f;
-  p->maxLifetime = p->lifetime;
-  p->size = BASE_SIZE * 0.5f;
+  // Emit based on speed, opposite to the player direction
+  EmitParams params;
+  params.position = position;
+  params.direction = rotation + 180.0f;
+  params.intensity = (speed - 200.0f) / 400.0f;
+  params.sourceSpeed = speed;
+  emitContinuous(m_speedEmitter, params, m_lastDeltaTime);
 }
 
 void ParticleSystem::clear() {
-  for (auto &p : m_particles) {
-    p.active = false;
+  for (auto &group : m_groups) {
+    group.particles.clear(m_pool);
+    group.spawnAccumulator = 0.0f;
+  }
+  m_liveCount = 0;
+}
+
+void ParticleSystem::saveState(StateWriter &writer) const {
+  writer.write(m_rng);
+  writer.write(m_lastDeltaTime);
+  writer.write(static_cast<std::uint32_t>(m_groups.size()));
+  for (const ParticleGroup &group : m_groups) {
+    writer.write(group.spawnAccumulator);
+    writer.write(group.origin);
+    writer.write(static_cast<std::uint32_t>(group.particles.size()));
+    ParticleQueue::ConstCursor cursor = group.particles.begin();
+    for (std::size_t i = group.particles.size(); i > 0; --i, cursor.advance())
+      writer.write(*cursor);
+  }
+}
+
+bool ParticleSystem::loadState(StateReader &reader) {
+  reader.read(m_rng);
+  reader.read(m_lastDeltaTime);
+  if (!reader.expect(static_cast<std::uint32_t>(m_groups.size())))
+    return false;
+
+  clear();
+  for (ParticleGroup &group : m_groups) {
+    std::uint32_t count = 0;
+    reader.read(group.spawnAccumulator);
+    reader.read(group.origin);
+    reader.read(count);
+    if (m_liveCount + count > m_liveCap)
+      return reader.fail();
+
+    StoredParticle p;
+    for (std::uint32_t i = 0; i < count && reader.read(p); ++i) {
+      if (!group.particles.push(m_pool, p))
+        return reader.fail();
+      ++m_liveCount;
+    }
   }
+  return reader.ok();
 }
@@ -0,0 +1,11 @@
+#include "graphics/RenderBackend.hpp"
+
+void SfmlBackend::draw(const CommandList &commands, const sf::View &view) {
+  m_target.setView(view);
+  for (const CommandList::Batch &batch : commands.getBatches()) {
+    sf::RenderStates states(batch.state.texture);
+    states.blendMode = batch.state.blendMode;
+    m_target.draw(commands.vertices(batch), batch.count,
+                  sf::PrimitiveType::Triangles, states);
+  }
+}
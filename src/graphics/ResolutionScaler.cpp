@@ -0,0 +1,60 @@
+#include "graphics/ResolutionScaler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Snap to whole steps so repeated changes never drift off the grid
+float snap(float scale) {
+  scale = std::round(scale / ResolutionScaler::STEP) * ResolutionScaler::STEP;
+  return std::clamp(scale, ResolutionScaler::MIN_SCALE, 1.0f);
+}
+
+} // namespace
+
+ResolutionScaler::ResolutionScaler(float targetFrameMs)
+    : m_targetMs(targetFrameMs), m_frameMs(0.0f), m_scale(1.0f),
+      m_cooldown(0), m_onTimeFrames(0), m_probeWait(PROBE_WAIT),
+      m_probeFrames(0) {}
+
+void ResolutionScaler::reset() {
+  m_frameMs = 0.0f;
+  m_onTimeFrames = 0;
+  m_cooldown = 0;
+}
+
+float ResolutionScaler::update(float frameMs) {
+  m_frameMs = m_frameMs > 0.0f ? m_frameMs + (frameMs - m_frameMs) * SMOOTHING
+                               : frameMs;
+
+  // Let the average catch up with the last change before judging it
+  if (m_cooldown > 0) {
+    --m_cooldown;
+    return m_scale;
+  }
+
+  if (m_frameMs > m_targetMs * LATE) {
+    m_onTimeFrames = 0;
+    if (m_scale > MIN_SCALE) {
+      // A step up that did not hold makes the next probe wait longer
+      if (m_probeFrames > 0)
+        m_probeWait = std::min(m_probeWait * 2, MAX_PROBE_WAIT);
+      m_probeFrames = 0;
+      m_scale = snap(m_scale - STEP);
+      m_cooldown = COOLDOWN_FRAMES;
+    }
+    return m_scale;
+  }
+
+  if (m_probeFrames > 0 && --m_probeFrames == 0)
+    m_probeWait = PROBE_WAIT; // The step up held
+
+  ++m_onTimeFrames;
+  if (m_scale < 1.0f && m_onTimeFrames >= m_probeWait) {
+    m_scale = snap(m_scale + STEP);
+    m_onTimeFrames = 0;
+    m_cooldown = COOLDOWN_FRAMES;
+    m_probeFrames = PROBE_FRAMES;
+  }
+  return m_scale;
+}
@@ -0,0 +1,203 @@
+#include "graphics/SkidMarkLayer.hpp"
+#include "math/FastMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Faint violet rubber, glowing slightly against the dark grid
+const sf::Color MARK_COLOR(150, 50, 200);
+
+// The atlas holds premultiplied color, so fading scales color and alpha
+// together and compositing needs no extra pass
+const sf::BlendMode
+    BLEND_PREMULTIPLIED(sf::BlendMode::Factor::One,
+                        sf::BlendMode::Factor::OneMinusSrcAlpha);
+const sf::BlendMode BLEND_FADE(sf::BlendMode::Factor::One,
+                               sf::BlendMode::Factor::One,
+                               sf::BlendMode::Equation::ReverseSubtract);
+
+// Two triangles covering rect
+void writeRect(sf::Vertex (&quad)[6], const sf::FloatRect &rect,
+               sf::Color color) {
+  sf::Vector2f a = rect.position;
+  sf::Vector2f c = rect.position + rect.size;
+  const sf::Vector2f corners[6] = {a, {c.x, a.y}, c, a, c, {a.x, c.y}};
+  for (int i = 0; i < 6; ++i)
+    quad[i] = sf::Vertex{corners[i], color, {}};
+}
+
+sf::Color premultiplied(float alpha) {
+  auto scale = [alpha](std::uint8_t channel) {
+    return static_cast<std::uint8_t>(channel * alpha / 255.0f);
+  };
+  return sf::Color(scale(MARK_COLOR.r), scale(MARK_COLOR.g),
+                   scale(MARK_COLOR.b), static_cast<std::uint8_t>(alpha));
+}
+
+} // namespace
+
+SkidMarkLayer::SkidMarkLayer()
+    : m_atlas(TILE_SIZE), m_tracks(), m_min(0, 0), m_max(0, 0),
+      m_visible(false), m_fadeStep(0), m_started(false) {}
+
+bool SkidMarkLayer::init(sf::Vector2f viewSize) {
+  if (!m_atlas.init(viewSize))
+    return false;
+  m_atlas.getTarget().clear(sf::Color::Transparent);
+  m_stamps.reserve(MAX_SOURCES * 2 * 6);
+  m_quads.reserve(m_atlas.getSlotCount() * 6);
+  return true;
+}
+
+void SkidMarkLayer::clear() {
+  // Slots are wiped as they are claimed again
+  m_atlas.invalidate();
+  for (Track &track : m_tracks)
+    track.active = false;
+  m_started = false;
+}
+
+void SkidMarkLayer::update(const sf::View &view, const SkidSource *sources,
+                           std::size_t count, std::uint64_t step) {
+  if (!m_atlas.isAvailable())
+    return;
+  if (m_started && step < m_fadeStep)
+    clear();
+  if (!m_started) {
+    m_fadeStep = step;
+    m_started = true;
+  }
+
+  m_visible = m_atlas.visibleTiles(view, m_min, m_max);
+  if (!m_visible)
+    return;
+
+  // Tiles new to their slot start without marks
+  bool drawn = false;
+  for (int y = m_min.y; y <= m_max.y; ++y) {
+    for (int x = m_min.x; x <= m_max.x; ++x) {
+      sf::Vector2i tile(x, y);
+      if (m_atlas.holds(tile))
+        continue;
+      sf::Vertex wipe[6];
+      writeRect(wipe, m_atlas.tileBounds(tile), sf::Color::Transparent);
+      m_atlas.beginTile(tile).draw(wipe, 6, sf::PrimitiveType::Triangles,
+                                   sf::RenderStates(sf::BlendNone));
+      m_atlas.claim(tile);
+      drawn = true;
+    }
+  }
+
+  // Stamp the wheels' movement into every visible tile it touches
+  m_stamps.clear();
+  count = std::min(count, MAX_SOURCES);
+  for (std::size_t i = 0; i < count; ++i)
+    stampWheels(m_tracks[i], sources[i]);
+  for (std::size_t i = count; i < MAX_SOURCES; ++i)
+    m_tracks[i].active = false;
+
+  if (!m_stamps.empty()) {
+    sf::Vector2f low = m_stamps[0].position;
+    sf::Vector2f high = low;
+    for (const sf::Vertex &vertex : m_stamps) {
+      low = {std::min(low.x, vertex.position.x),
+             std::min(low.y, vertex.position.y)};
+      high = {std::max(high.x, vertex.position.x),
+              std::max(high.y, vertex.position.y)};
+    }
+    sf::Vector2i first = m_atlas.tileAt(low);
+    sf::Vector2i last = m_atlas.tileAt(high);
+    for (int y = std::max(first.y, m_min.y); y <= std::min(last.y, m_max.y);
+         ++y) {
+      for (int x = std::max(first.x, m_min.x); x <= std::min(last.x, m_max.x);
+           ++x) {
+        // Max keeps overlapping stamps from darkening where they meet
+        m_atlas.beginTile({x, y}).draw(m_stamps.data(), m_stamps.size(),
+                                       sf::PrimitiveType::Triangles,
+                                       sf::RenderStates(sf::BlendMax));
+      }
+    }
+    drawn = true;
+  }
+
+  // One pass over the whole atlas per FADE_TICKS, however many marks
+  std::uint64_t passes = (step - m_fadeStep) / FADE_TICKS;
+  if (passes > 0) {
+    m_fadeStep += passes * FADE_TICKS;
+    fade(static_cast<std::uint8_t>(
+        std::min<std::uint64_t>(255, passes * FADE_AMOUNT)));
+    drawn = true;
+  }
+
+  if (drawn)
+    m_atlas.getTarget().display();
+}
+
+void SkidMarkLayer::render(sf::RenderTarget &target) {
+  if (!m_atlas.isAvailable() || !m_visible)
+    return;
+
+  m_quads.clear();
+  for (int y = m_min.y; y <= m_max.y; ++y) {
+    for (int x = m_min.x; x <= m_max.x; ++x)
+      m_atlas.appendQuad(m_quads, {x, y});
+  }
+  sf::RenderStates states(&m_atlas.getTexture());
+  states.blendMode = BLEND_PREMULTIPLIED;
+  target.draw(m_quads.data(), m_quads.size(), sf::PrimitiveType::Triangles,
+              states);
+}
+
+void SkidMarkLayer::stampWheels(Track &track, const SkidSource &source) {
+  if (source.intensity <= 0.0f) {
+    track.active = false;
+    return;
+  }
+
+  float angle = source.rotation * fastmath::DEG_TO_RAD;
+  sf::Vector2f forward(std::cos(angle), std::sin(angle));
+  sf::Vector2f side(-forward.y, forward.x);
+  sf::Vector2f axle = source.position - forward * REAR_AXLE;
+  sf::Vector2f wheels[2] = {axle - side * HALF_TRACK,
+                            axle + side * HALF_TRACK};
+
+  // A jump (restart, rollback) starts a new mark instead of a long streak
+  sf::Vector2f moved = wheels[0] - track.wheels[0];
+  bool connected = track.active && moved.x * moved.x + moved.y * moved.y <=
+                                       MAX_SEGMENT * MAX_SEGMENT;
+  if (connected) {
+    sf::Color from = premultiplied(MAX_ALPHA * track.intensity);
+    sf::Color to = premultiplied(MAX_ALPHA * source.intensity);
+    for (int w = 0; w < 2; ++w) {
+      sf::Vector2f a = track.wheels[w];
+      sf::Vector2f b = wheels[w];
+      sf::Vector2f along = b - a;
+      float length = std::sqrt(along.x * along.x + along.y * along.y);
+      if (length < 0.5f)
+        continue;
+      sf::Vector2f across =
+          sf::Vector2f(-along.y, along.x) * (MARK_WIDTH * 0.5f / length);
+      const sf::Vertex quad[6] = {
+          {a - across, from, {}}, {a + across, from, {}},
+          {b + across, to, {}},   {a - across, from, {}},
+          {b + across, to, {}},   {b - across, to, {}}};
+      m_stamps.insert(m_stamps.end(), std::begin(quad), std::end(quad));
+    }
+  }
+
+  track.wheels[0] = wheels[0];
+  track.wheels[1] = wheels[1];
+  track.intensity = source.intensity;
+  track.active = true;
+}
+
+void SkidMarkLayer::fade(std::uint8_t amount) {
+  sf::RenderTexture &target = m_atlas.getTarget();
+  target.setView(target.getDefaultView());
+  sf::Vertex pass[6];
+  writeRect(pass, sf::FloatRect({0.0f, 0.0f}, sf::Vector2f(target.getSize())),
+            sf::Color(amount, amount, amount, amount));
+  target.draw(pass, 6, sf::PrimitiveType::Triangles,
+              sf::RenderStates(BLEND_FADE));
+}
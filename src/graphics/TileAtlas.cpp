@@ -0,0 +1,98 @@
+#include "graphics/TileAtlas.hpp"
+#include <cmath>
+
+TileAtlas::TileAtlas(int tileSize)
+    : m_available(false), m_tileSize(tileSize), m_columns(0), m_rows(0) {}
+
+bool TileAtlas::init(sf::Vector2f viewSize) {
+  // Enough tiles to cover the view at any offset
+  float size = static_cast<float>(m_tileSize);
+  m_columns = static_cast<int>(std::ceil(viewSize.x / size)) + 1;
+  m_rows = static_cast<int>(std::ceil(viewSize.y / size)) + 1;
+  sf::Vector2u atlasSize(static_cast<unsigned int>(m_columns * m_tileSize),
+                         static_cast<unsigned int>(m_rows * m_tileSize));
+  m_available = m_atlas.resize(atlasSize);
+  if (!m_available)
+    return false;
+
+  // Tiles are drawn 1:1, and filtering would blend neighboring slots
+  m_atlas.setSmooth(false);
+  m_slots.assign(static_cast<std::size_t>(m_columns * m_rows), Slot());
+  return true;
+}
+
+bool TileAtlas::visibleTiles(const sf::View &view, sf::Vector2i &min,
+                             sf::Vector2i &max) const {
+  sf::Vector2f half = view.getSize() * 0.5f;
+  min = tileAt(view.getCenter() - half);
+  max = tileAt(view.getCenter() + half);
+  return max.x - min.x < m_columns && max.y - min.y < m_rows;
+}
+
+bool TileAtlas::holds(sf::Vector2i tile) const {
+  const Slot &slot = m_slots[slotIndex(tile)];
+  return slot.valid && slot.tile == tile;
+}
+
+void TileAtlas::claim(sf::Vector2i tile) {
+  Slot &slot = m_slots[slotIndex(tile)];
+  slot.tile = tile;
+  slot.valid = true;
+}
+
+void TileAtlas::invalidate() {
+  for (Slot &slot : m_slots)
+    slot.valid = false;
+}
+
+void TileAtlas::invalidate(const sf::FloatRect &area) {
+  for (Slot &slot : m_slots) {
+    if (tileBounds(slot.tile).findIntersection(area))
+      slot.valid = false;
+  }
+}
+
+sf::RenderTexture &TileAtlas::beginTile(sf::Vector2i tile) {
+  // The tile's world square onto its slot; clipping keeps geometry that
+  // crosses the tile's edges out of neighboring slots
+  sf::Vector2f atlasSize(m_atlas.getSize());
+  sf::Vector2f slot(slotOrigin(tile));
+  float size = static_cast<float>(m_tileSize);
+  sf::View view(tileBounds(tile));
+  view.setViewport(sf::FloatRect({slot.x / atlasSize.x, slot.y / atlasSize.y},
+                                 {size / atlasSize.x, size / atlasSize.y}));
+  m_atlas.setView(view);
+  return m_atlas;
+}
+
+void TileAtlas::appendQuad(std::vector<sf::Vertex> &vertices,
+                           sf::Vector2i tile) const {
+  sf::Vector2f world = tileBounds(tile).position;
+  sf::Vector2f texture(slotOrigin(tile));
+  float size = static_cast<float>(m_tileSize);
+  const sf::Vector2f corners[6] = {{0.0f, 0.0f}, {size, 0.0f}, {size, size},
+                                   {0.0f, 0.0f}, {size, size}, {0.0f, size}};
+  for (const sf::Vector2f &corner : corners)
+    vertices.push_back({world + corner, sf::Color::White, texture + corner});
+}
+
+sf::FloatRect TileAtlas::tileBounds(sf::Vector2i tile) const {
+  float size = static_cast<float>(m_tileSize);
+  return sf::FloatRect({tile.x * size, tile.y * size}, {size, size});
+}
+
+sf::Vector2i TileAtlas::tileAt(sf::Vector2f position) const {
+  float size = static_cast<float>(m_tileSize);
+  return {static_cast<int>(std::floor(position.x / size)),
+          static_cast<int>(std::floor(position.y / size))};
+}
+
+std::size_t TileAtlas::slotIndex(sf::Vector2i tile) const {
+  return static_cast<std::size_t>(positiveModulo(tile.y, m_rows) * m_columns +
+                                  positiveModulo(tile.x, m_columns));
+}
+
+sf::Vector2i TileAtlas::slotOrigin(sf::Vector2i tile) const {
+  return {positiveModulo(tile.x, m_columns) * m_tileSize,
+          positiveModulo(tile.y, m_rows) * m_tileSize};
+}
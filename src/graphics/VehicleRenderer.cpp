@@ -0,0 +1,73 @@
+#include "graphics/VehicleRenderer.hpp"
+#include "math/FastMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+sf::Vector2f unitNormal(sf::Vector2f a, sf::Vector2f b) {
+  sf::Vector2f normal(a.y - b.y, b.x - a.x);
+  float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+  return length > 0.0f ? normal / length : normal;
+}
+
+float dot(sf::Vector2f a, sf::Vector2f b) { return a.x * b.x + a.y * b.y; }
+
+} // namespace
+
+VehicleRenderer::VehicleRenderer() {
+  // Create arrow/car shaped polygon
+  m_points = {sf::Vector2f(30.0f, 0.0f),    // Front tip
+              sf::Vector2f(-15.0f, -18.0f), // Back left outer
+              sf::Vector2f(-8.0f, 0.0f),    // Back center indent
+              sf::Vector2f(-15.0f, 18.0f)}; // Back right outer
+
+  // Fan from the middle of the bounds
+  sf::Vector2f low = m_points[0];
+  sf::Vector2f high = m_points[0];
+  for (const sf::Vector2f &point : m_points) {
+    low = {std::min(low.x, point.x), std::min(low.y, point.y)};
+    high = {std::max(high.x, point.x), std::max(high.y, point.y)};
+  }
+  m_center = (low + high) * 0.5f;
+
+  // Each corner pushed out along its mitered edge normals
+  for (std::size_t i = 0; i < POINTS; ++i) {
+    sf::Vector2f previous = m_points[(i + POINTS - 1) % POINTS];
+    sf::Vector2f point = m_points[i];
+    sf::Vector2f next = m_points[(i + 1) % POINTS];
+    sf::Vector2f n1 = unitNormal(previous, point);
+    sf::Vector2f n2 = unitNormal(point, next);
+    if (dot(n1, m_center - point) > 0.0f)
+      n1 = -n1;
+    if (dot(n2, m_center - point) > 0.0f)
+      n2 = -n2;
+    float factor = 1.0f + dot(n1, n2);
+    m_outer[i] = point + (n1 + n2) / factor * OUTLINE_THICKNESS;
+  }
+}
+
+void VehicleRenderer::render(CommandList &commands,
+                             const RenderInstance &instance) {
+  float s, c;
+  fastmath::sincosDeg(instance.rotation, s, c);
+  auto place = [&](sf::Vector2f local) {
+    return instance.position +
+           sf::Vector2f(local.x * c - local.y * s, local.x * s + local.y * c);
+  };
+
+  sf::Vertex fill[POINTS + 2];
+  fill[0] = sf::Vertex{place(m_center), instance.color, {}};
+  for (std::size_t i = 0; i <= POINTS; ++i)
+    fill[i + 1] = sf::Vertex{place(m_points[i % POINTS]), instance.color, {}};
+  commands.submit(fill, POINTS + 2, sf::PrimitiveType::TriangleFan);
+
+  sf::Vertex outline[(POINTS + 1) * 2];
+  for (std::size_t i = 0; i <= POINTS; ++i) {
+    outline[i * 2] =
+        sf::Vertex{place(m_points[i % POINTS]), sf::Color::White, {}};
+    outline[i * 2 + 1] =
+        sf::Vertex{place(m_outer[i % POINTS]), sf::Color::White, {}};
+  }
+  commands.submit(outline, (POINTS + 1) * 2, sf::PrimitiveType::TriangleStrip);
+}
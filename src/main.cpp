@@ -4,9 +4,58 @@
  */
 
 #include "core/Game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
-int main() {
-  Game game;
+int main(int argc, char *argv[]) {
+  GameOptions options;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--late-input") == 0)
+      options.lateInputSampling = true;
+    else if (std::strcmp(argv[i], "--latency-report") == 0)
+      options.reportLatency = true;
+    else if (std::strcmp(argv[i], "--fixed-particles") == 0)
+      options.adaptiveParticles = false;
+    else if (std::strcmp(argv[i], "--native-resolution") == 0)
+      options.dynamicResolution = false;
+    else if (std::strcmp(argv[i], "--particle-pool") == 0 && i + 1 < argc) {
+      const char *policy = argv[++i];
+      if (std::strcmp(policy, "drop") == 0)
+        options.particlePool = PoolPolicy::Drop;
+      else if (std::strcmp(policy, "grow") == 0)
+        options.particlePool = PoolPolicy::Grow;
+      else
+        options.particlePool = PoolPolicy::EvictOldest;
+    } else if (std::strcmp(argv[i], "--physics") == 0 && i + 1 < argc)
+      options.physicsPath = argv[++i];
+    else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+      options.recordPath = argv[++i];
+    else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+      options.capturePath = argv[++i];
+    else if (std::strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+      options.logPath = argv[++i];
+    else if (std::strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+      if (!Log::parseLevel(argv[++i], options.logLevel))
+        std::fprintf(stderr, "Unknown log level %s\n", argv[i]);
+    } else if (std::strcmp(argv[i], "--versus") == 0 && i + 4 < argc) {
+      options.versus = true;
+      options.localPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+      options.peerHost = argv[++i];
+      options.peerPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+      options.versusSlot = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+      options.versusSeed =
+          static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    else if (std::strcmp(argv[i], "--net-latency") == 0 && i + 1 < argc)
+      options.network.latencyMs = std::strtof(argv[++i], nullptr);
+    else if (std::strcmp(argv[i], "--net-jitter") == 0 && i + 1 < argc)
+      options.network.jitterMs = std::strtof(argv[++i], nullptr);
+    else if (std::strcmp(argv[i], "--net-loss") == 0 && i + 1 < argc)
+      options.network.lossPercent = std::strtof(argv[++i], nullptr);
+  }
+
+  Game game(options);
   game.run();
   return 0;
 }
@@ -0,0 +1,178 @@
+#include "net/RollbackSession.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr std::uint32_t PACKET_MAGIC = 0x3152444E; // "NDR1" little-endian
+
+// Unacknowledged inputs resent in every packet (covers lost packets)
+constexpr std::uint32_t MAX_PACKET_INPUTS = 32;
+
+} // namespace
+
+RollbackSession::RollbackSession(Simulation &simulation, UdpLink &link)
+    : m_simulation(simulation), m_link(link), m_tick(0),
+      m_localInputs(INPUT_DELAY), m_remoteInputs(0), m_peerAck(0),
+      m_rollbackTick(0), m_peerChecksumPending(false), m_peerChecksumTick(0),
+      m_peerChecksum(0), m_stalledFrames(0) {
+  m_packet.reserve(UdpLink::MAX_PACKET);
+}
+
+bool RollbackSession::advance(const ControlInput &local) {
+  m_link.poll();
+
+  // Local input applies INPUT_DELAY ticks from now (the first ticks run
+  // with no input). While stalled the queue is full and input is dropped.
+  if (m_localInputs <= m_tick + INPUT_DELAY)
+    record(m_localInputs++).local = local;
+
+  receivePackets();
+  rollback();
+
+  // Too far ahead of the peer: wait instead of predicting further
+  if (m_tick >= m_remoteInputs + MAX_PREDICTION) {
+    ++m_stats.stalls;
+    ++m_stalledFrames;
+    sendPacket();
+    return false;
+  }
+
+  simulate(m_tick, false);
+  m_rollbackTick = ++m_tick;
+
+  compareChecksum();
+  sendPacket();
+  return true;
+}
+
+ControlInput RollbackSession::remoteInput(std::uint32_t tick) const {
+  // Predict that the peer keeps holding what it held last
+  if (tick < m_remoteInputs)
+    return m_history[tick % HISTORY].remote;
+  return m_lastRemote;
+}
+
+void RollbackSession::receivePackets() {
+  while (m_link.receive(m_packet)) {
+    m_stalledFrames = 0;
+    readPacket(m_packet);
+  }
+}
+
+void RollbackSession::readPacket(const std::vector<std::uint8_t> &packet) {
+  StateReader reader(packet.data(), packet.size());
+  std::uint32_t firstTick = 0;
+  std::uint8_t count = 0;
+  reader.expect(PACKET_MAGIC);
+  reader.read(firstTick);
+  reader.read(count);
+  if (!reader.ok())
+    return;
+
+  for (std::uint32_t i = 0; i < count; ++i) {
+    ControlInput input;
+    if (!reader.read(input.bits))
+      return;
+
+    // Inputs arrive in order; anything older is a duplicate
+    std::uint32_t tick = firstTick + i;
+    if (tick != m_remoteInputs || tick >= m_tick + HISTORY / 2)
+      continue;
+
+    // A wrong guess for a tick already simulated means rolling back to it
+    TickRecord &entry = record(tick);
+    if (tick < m_tick && entry.remote != input)
+      m_rollbackTick = std::min(m_rollbackTick, tick);
+    entry.remote = input;
+    m_lastRemote = input;
+    ++m_remoteInputs;
+  }
+
+  std::uint32_t ack = 0, finalized = 0, checksum = 0;
+  reader.read(ack);
+  reader.read(finalized);
+  reader.read(checksum);
+  if (!reader.ok() || !reader.atEnd())
+    return;
+
+  if (ack > m_peerAck && ack <= m_localInputs)
+    m_peerAck = ack;
+
+  // Keep only the newest checksum; older ones add nothing
+  if (finalized > 0 &&
+      (!m_peerChecksumPending || finalized - 1 > m_peerChecksumTick)) {
+    m_peerChecksumPending = true;
+    m_peerChecksumTick = finalized - 1;
+    m_peerChecksum = checksum;
+  }
+}
+
+void RollbackSession::sendPacket() {
+  m_packet.clear();
+  StateWriter writer(m_packet);
+
+  // Every input the peer has not confirmed yet
+  std::uint32_t count = std::min(m_localInputs - m_peerAck, MAX_PACKET_INPUTS);
+  writer.write(PACKET_MAGIC);
+  writer.write(m_peerAck);
+  writer.write(static_cast<std::uint8_t>(count));
+  for (std::uint32_t i = 0; i < count; ++i)
+    writer.write(record(m_peerAck + i).local.bits);
+
+  // Our newest tick that will never be rolled back, and its checksum
+  std::uint32_t finalized = std::min(m_remoteInputs, m_tick);
+  writer.write(m_remoteInputs);
+  writer.write(finalized);
+  writer.write(finalized > 0 ? record(finalized - 1).checksum : 0u);
+
+  m_link.send(m_packet.data(), m_packet.size());
+}
+
+void RollbackSession::rollback() {
+  if (m_rollbackTick >= m_tick)
+    return;
+
+  // Back to the state before the first wrong tick, then replay up to now
+  // with the inputs as known now (held keys belong to the present)
+  std::uint32_t depth = m_tick - m_rollbackTick;
+  m_simulation.loadState(record(m_rollbackTick).state, true);
+  for (std::uint32_t tick = m_rollbackTick; tick < m_tick; ++tick)
+    simulate(tick, true);
+
+  ++m_stats.rollbacks;
+  m_stats.resimulatedTicks += depth;
+  m_stats.maxRollback = std::max(m_stats.maxRollback, depth);
+  m_rollbackTick = m_tick;
+  ND_LOG_EVERY(1.0, Debug, "net", "Rolled back {} ticks to tick {}", depth,
+               m_tick - depth);
+}
+
+void RollbackSession::simulate(std::uint32_t tick, bool resimulated) {
+  TickRecord &entry = record(tick);
+
+  // The first replayed tick starts from the state just restored
+  if (!resimulated || tick != m_rollbackTick)
+    m_simulation.saveState(entry.state);
+
+  entry.remote = remoteInput(tick);
+  m_simulation.stepVersus(entry.local, entry.remote, resimulated);
+  entry.checksum = m_simulation.getVersusChecksum();
+}
+
+void RollbackSession::compareChecksum() {
+  std::uint32_t finalized = std::min(m_remoteInputs, m_tick);
+  if (!m_peerChecksumPending || m_peerChecksumTick >= finalized)
+    return;
+
+  // Too old to compare: our record has been reused
+  m_peerChecksumPending = false;
+  if (m_peerChecksumTick + HISTORY < m_tick)
+    return;
+
+  ++m_stats.checksums;
+  if (record(m_peerChecksumTick).checksum != m_peerChecksum) {
+    ++m_stats.desyncs;
+    ND_LOG(Warn, "net", "Checksum mismatch at tick {}", m_peerChecksumTick);
+  }
+}
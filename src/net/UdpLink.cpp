@@ -0,0 +1,94 @@
+#include "net/UdpLink.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <optional>
+
+namespace {
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+UdpLink::UdpLink() : m_peer(sf::IpAddress::LocalHost), m_peerPort(0) {
+  m_socket.setBlocking(false);
+}
+
+bool UdpLink::open(unsigned short localPort, const sf::IpAddress &peer,
+                   unsigned short peerPort) {
+  m_peer = peer;
+  m_peerPort = peerPort;
+  return m_socket.bind(localPort) == sf::Socket::Status::Done;
+}
+
+void UdpLink::setConditions(const LinkConditions &conditions,
+                            std::uint64_t seed) {
+  m_conditions = conditions;
+  m_rng = Pcg32(seed);
+}
+
+void UdpLink::send(const std::uint8_t *data, std::size_t size) {
+  if (size > MAX_PACKET)
+    return;
+
+  if (m_rng.nextFloat() * 100.0f < m_conditions.lossPercent) {
+    ++m_stats.dropped;
+    return;
+  }
+
+  float delayMs =
+      m_conditions.latencyMs + m_rng.nextFloat() * m_conditions.jitterMs;
+  if (delayMs <= 0.0f) {
+    transmit(data, size);
+    return;
+  }
+
+  // Jitter can reorder packets, just like a real link
+  Delayed &delayed = m_delayed.emplace_back();
+  delayed.dueNs = nowNs() + static_cast<std::int64_t>(delayMs * 1.0e6f);
+  delayed.size = size;
+  std::memcpy(delayed.data.data(), data, size);
+}
+
+void UdpLink::poll() {
+  if (m_delayed.empty())
+    return;
+
+  std::int64_t now = nowNs();
+  auto due = std::stable_partition(
+      m_delayed.begin(), m_delayed.end(),
+      [now](const Delayed &delayed) { return delayed.dueNs > now; });
+  for (auto it = due; it != m_delayed.end(); ++it)
+    transmit(it->data.data(), it->size);
+  m_delayed.erase(due, m_delayed.end());
+}
+
+void UdpLink::transmit(const std::uint8_t *data, std::size_t size) {
+  // A full socket buffer is just more packet loss
+  if (m_socket.send(data, size, m_peer, m_peerPort) ==
+      sf::Socket::Status::Done)
+    ++m_stats.sent;
+  else
+    ++m_stats.dropped;
+}
+
+bool UdpLink::receive(std::vector<std::uint8_t> &packet) {
+  std::size_t received = 0;
+  std::optional<sf::IpAddress> sender;
+  unsigned short senderPort = 0;
+  while (m_socket.receive(m_receiveBuffer.data(), m_receiveBuffer.size(),
+                          received, sender, senderPort) ==
+         sf::Socket::Status::Done) {
+    if (!sender || *sender != m_peer || senderPort != m_peerPort)
+      continue;
+
+    ++m_stats.received;
+    packet.assign(m_receiveBuffer.begin(), m_receiveBuffer.begin() + received);
+    return true;
+  }
+  return false;
+}
@@ -1,12 +1,22 @@
 #include "ui/UIManager.hpp"
+#include <algorithm>
 #include <cmath>
-#include <iomanip>
-#include <sstream>
 
-UIManager::UIManager()
-    : m_fontLoaded(false), m_windowWidth(1280), m_windowHeight(720),
-      m_menuPulse(0.0f), m_neonCyan(0, 255, 255), m_neonMagenta(255, 0, 255),
-      m_neonWhite(240, 240, 255) {}
+UIManager::UIManager(FrameArena &arena)
+    : m_arena(arena), m_fontLoaded(false), m_windowWidth(1280),
+      m_windowHeight(720), m_menuPulse(0.0f), m_neonCyan(0, 255, 255),
+      m_neonMagenta(255, 0, 255), m_neonWhite(240, 240, 255),
+      m_scoreText(m_font, "", 28), m_comboText(m_font, "", 36),
+      m_speedText(m_font, "", 32), m_rivalText(m_font, "", 28),
+      m_titleText(m_font, "NEON DRIFT", 72),
+      m_startText(m_font, "Press ENTER to Start", 28),
+      m_controlsText(m_font,
+                     "WASD/Arrows to move | SPACE to drift | ESC to pause", 18),
+      m_pausedText(m_font, "PAUSED", 64),
+      m_resumeText(m_font, "Press ESC to Resume", 24),
+      m_gameOverText(m_font, "GAME OVER", 72),
+      m_finalScoreText(m_font, "", 36),
+      m_restartText(m_font, "Press ENTER to Play Again", 28) {}
 
 bool UIManager::init(unsigned int windowWidth, unsigned int windowHeight) {
   m_windowWidth = windowWidth;
@@ -19,42 +29,93 @@ bool UIManager::init(unsigned int windowWidth, unsigned int windowHeight) {
     m_fontLoaded = true;
   }
 
+  // HUD styles that never change
+  m_scoreText.setPosition(sf::Vector2f(20.0f, 20.0f));
+  m_scoreText.setFillColor(m_neonCyan);
+  m_scoreText.setOutlineColor(sf::Color(0, 100, 100));
+  m_scoreText.setOutlineThickness(2.0f);
+
+  m_comboText.setPosition(sf::Vector2f(20.0f, 55.0f));
+  m_comboText.setOutlineThickness(1.0f);
+
+  m_speedText.setOutlineThickness(2.0f);
+
+  m_rivalText.setFillColor(m_neonMagenta);
+  m_rivalText.setOutlineColor(sf::Color(100, 0, 80));
+  m_rivalText.setOutlineThickness(2.0f);
+
+  m_comboBar.setSize(sf::Vector2f(COMBO_BAR_WIDTH, COMBO_BAR_HEIGHT));
+  m_comboBar.setPosition(COMBO_BAR_POSITION);
+  m_comboBar.setFillColor(sf::Color(40, 40, 60, 150));
+  m_comboBar.setOutlineColor(sf::Color(80, 80, 120));
+  m_comboBar.setOutlineThickness(1.0f);
+  m_comboFill.setPosition(COMBO_BAR_POSITION);
+
+  m_overlay.setSize(sf::Vector2f(static_cast<float>(m_windowWidth),
+                                 static_cast<float>(m_windowHeight)));
+
+  // Screen texts (fixed strings, centered once the font is known)
+  centerText(m_titleText, m_windowHeight * 0.25f);
+  m_titleText.setOutlineColor(m_neonMagenta);
+  m_titleText.setOutlineThickness(3.0f);
+  centerText(m_startText, m_windowHeight * 0.55f);
+  centerText(m_controlsText, m_windowHeight * 0.85f);
+  m_controlsText.setFillColor(sf::Color(150, 150, 180));
+
+  centerText(m_pausedText, m_windowHeight * 0.4f);
+  m_pausedText.setFillColor(m_neonCyan);
+  m_pausedText.setOutlineColor(m_neonMagenta);
+  m_pausedText.setOutlineThickness(2.0f);
+  centerText(m_resumeText, m_windowHeight * 0.55f);
+  m_resumeText.setFillColor(sf::Color(200, 200, 220));
+
+  centerText(m_gameOverText, m_windowHeight * 0.25f);
+  m_gameOverText.setFillColor(sf::Color(255, 50, 100));
+  m_gameOverText.setOutlineColor(sf::Color(150, 0, 50));
+  m_gameOverText.setOutlineThickness(3.0f);
+  m_finalScoreText.setFillColor(m_neonCyan);
+  centerText(m_restartText, m_windowHeight * 0.65f);
+
   return true;
 }
 
-void UIManager::update(float deltaTime) {
-  m_menuPulse += deltaTime * 2.0f;
-  if (m_menuPulse > 6.28318f)
-    m_menuPulse -= 6.28318f;
+void UIManager::setText(sf::Text &text, const char *ascii) {
+  // One character at a time, so each temporary fits sf::String's small
+  // buffer; the scratch and the text then reuse their storage
+  m_scratch.clear();
+  for (; *ascii != '\0'; ++ascii)
+    m_scratch += sf::String(static_cast<char32_t>(*ascii));
+  text.setString(m_scratch);
+}
+
+void UIManager::centerText(sf::Text &text, float y) {
+  sf::FloatRect bounds = text.getLocalBounds();
+  text.setPosition(sf::Vector2f((m_windowWidth - bounds.size.x) / 2.0f, y));
 }
 
-std::string UIManager::formatScore(std::uint64_t score) {
-  std::stringstream ss;
-  ss << std::setfill('0') << std::setw(8) << score;
-  return ss.str();
+float UIManager::advancePulse(float pulse, float deltaTime) {
+  pulse += deltaTime * 2.0f;
+  if (pulse > 6.28318f)
+    pulse -= 6.28318f;
+  return pulse;
 }
 
-void UIManager::renderHUD(sf::RenderWindow &window, const ScoreManager &score,
+void UIManager::renderHUD(sf::RenderTarget &target, const ScoreManager &score,
                           float playerSpeed) {
   if (!m_fontLoaded)
     return;
 
   // Score display (top left)
-  sf::Text scoreText(m_font, "SCORE: " + formatScore(score.getScore()), 28);
-  scoreText.setPosition(sf::Vector2f(20.0f, 20.0f));
-  scoreText.setFillColor(m_neonCyan);
-  scoreText.setOutlineColor(sf::Color(0, 100, 100));
-  scoreText.setOutlineThickness(2.0f);
-  window.draw(scoreText);
+  setText(m_scoreText,
+          m_arena.format("SCORE: %08llu", static_cast<unsigned long long>(
+                                              score.getScore())));
+  target.draw(m_scoreText);
 
   // Combo multiplier (top left, below score)
   if (score.isComboActive()) {
-    std::stringstream comboSS;
-    comboSS << "x" << std::fixed << std::setprecision(1)
-            << score.getComboMultiplier();
-
-    sf::Text comboText(m_font, comboSS.str(), 36);
-    comboText.setPosition(sf::Vector2f(20.0f, 55.0f));
+    setText(m_comboText,
+            m_arena.format("x%.1f", static_cast<double>(
+                                        score.getComboMultiplier())));
 
     // Pulse color based on multiplier
     float pulse = (std::sin(m_menuPulse * 3.0f) + 1.0f) * 0.5f;
@@ -62,176 +123,123 @@ void UIManager::renderHUD(sf::RenderWindow &window, const ScoreManager &score,
     std::uint8_t r =
         static_cast<std::uint8_t>(255 * std::min(1.0f, multiplier / 4.0f));
     std::uint8_t g = static_cast<std::uint8_t>(255 - r);
-    comboText.setFillColor(
+    m_comboText.setFillColor(
         sf::Color(r, g, 255, static_cast<std::uint8_t>(200 + 55 * pulse)));
-    comboText.setOutlineThickness(1.0f);
-    window.draw(comboText);
+    target.draw(m_comboText);
   }
 
   // Draw combo timer bar
-  drawComboMeter(window, score);
+  drawComboMeter(target, score);
 
   // Speed display (bottom right)
-  drawSpeedometer(window, playerSpeed);
+  drawSpeedometer(target, playerSpeed);
 }
 
-void UIManager::drawComboMeter(sf::RenderWindow &window,
-                               const ScoreManager &score) {
-  float barWidth = 200.0f;
-  float barHeight = 8.0f;
-  float x = 20.0f;
-  float y = 100.0f;
+void UIManager::renderRivalScore(sf::RenderTarget &target,
+                                 std::uint64_t score) {
+  if (!m_fontLoaded)
+    return;
+
+  // Versus opponent's score (top right)
+  setText(m_rivalText, m_arena.format("RIVAL: %08llu",
+                                      static_cast<unsigned long long>(score)));
+  m_rivalText.setPosition(sf::Vector2f(
+      m_windowWidth - m_rivalText.getLocalBounds().size.x - 20.0f, 20.0f));
+  target.draw(m_rivalText);
+}
 
+void UIManager::drawComboMeter(sf::RenderTarget &target,
+                               const ScoreManager &score) {
   // Background bar
-  sf::RectangleShape bgBar(sf::Vector2f(barWidth, barHeight));
-  bgBar.setPosition(sf::Vector2f(x, y));
-  bgBar.setFillColor(sf::Color(40, 40, 60, 150));
-  bgBar.setOutlineColor(sf::Color(80, 80, 120));
-  bgBar.setOutlineThickness(1.0f);
-  window.draw(bgBar);
+  target.draw(m_comboBar);
 
   // Combo timer fill
   if (score.isComboActive()) {
     float fillRatio = score.getComboTimer() / score.getMaxComboTimer();
-    sf::RectangleShape fillBar(sf::Vector2f(barWidth * fillRatio, barHeight));
-    fillBar.setPosition(sf::Vector2f(x, y));
+    m_comboFill.setSize(
+        sf::Vector2f(COMBO_BAR_WIDTH * fillRatio, COMBO_BAR_HEIGHT));
 
     // Color based on time remaining
     std::uint8_t r = static_cast<std::uint8_t>(255 * (1.0f - fillRatio));
     std::uint8_t g = static_cast<std::uint8_t>(255 * fillRatio);
-    fillBar.setFillColor(sf::Color(r, g, 200));
-    window.draw(fillBar);
+    m_comboFill.setFillColor(sf::Color(r, g, 200));
+    target.draw(m_comboFill);
   }
 }
 
-void UIManager::drawSpeedometer(sf::RenderWindow &window, float speed) {
+void UIManager::drawSpeedometer(sf::RenderTarget &target, float speed) {
   if (!m_fontLoaded)
     return;
 
-  std::stringstream ss;
-  ss << static_cast<int>(speed) << " km/h";
-
-  sf::Text speedText(m_font, ss.str(), 32);
+  setText(m_speedText, m_arena.format("%d km/h", static_cast<int>(speed)));
 
   // Position bottom right
-  sf::FloatRect bounds = speedText.getLocalBounds();
-  speedText.setPosition(sf::Vector2f(m_windowWidth - bounds.size.x - 30.0f,
-                                     m_windowHeight - 50.0f));
+  sf::FloatRect bounds = m_speedText.getLocalBounds();
+  m_speedText.setPosition(sf::Vector2f(m_windowWidth - bounds.size.x - 30.0f,
+                                       m_windowHeight - 50.0f));
 
   // Color based on speed (green to red)
   float speedRatio = std::min(1.0f, speed / 600.0f);
   std::uint8_t r = static_cast<std::uint8_t>(100 + 155 * speedRatio);
   std::uint8_t g = static_cast<std::uint8_t>(255 * (1.0f - speedRatio * 0.5f));
-  speedText.setFillColor(sf::Color(r, g, 255));
-  speedText.setOutlineColor(sf::Color(r / 4, g / 4, 100));
-  speedText.setOutlineThickness(2.0f);
+  m_speedText.setFillColor(sf::Color(r, g, 255));
+  m_speedText.setOutlineColor(sf::Color(r / 4, g / 4, 100));
 
-  window.draw(speedText);
+  target.draw(m_speedText);
 }
 
 void UIManager::renderMenu(sf::RenderWindow &window) {
   if (!m_fontLoaded)
     return;
 
-  // Title
-  sf::Text title(m_font, "NEON DRIFT", 72);
-  sf::FloatRect titleBounds = title.getLocalBounds();
-  title.setPosition(sf::Vector2f((m_windowWidth - titleBounds.size.x) / 2.0f,
-                                 m_windowHeight * 0.25f));
-
-  // Pulsing glow effect
+  // Title with a pulsing glow
   float pulse = (std::sin(m_menuPulse) + 1.0f) * 0.5f;
-  title.setFillColor(
+  m_titleText.setFillColor(
       sf::Color(static_cast<std::uint8_t>(200 + 55 * pulse), 255, 255));
-  title.setOutlineColor(m_neonMagenta);
-  title.setOutlineThickness(3.0f);
-  window.draw(title);
+  window.draw(m_titleText);
 
   // Press Enter to start
-  sf::Text startText(m_font, "Press ENTER to Start", 28);
-  sf::FloatRect startBounds = startText.getLocalBounds();
-  startText.setPosition(sf::Vector2f(
-      (m_windowWidth - startBounds.size.x) / 2.0f, m_windowHeight * 0.55f));
-  startText.setFillColor(
+  m_startText.setFillColor(
       sf::Color(255, 255, 255, static_cast<std::uint8_t>(150 + 105 * pulse)));
-  window.draw(startText);
+  window.draw(m_startText);
 
   // Controls hint
-  sf::Text controlsText(
-      m_font, "WASD/Arrows to move | SPACE to drift | ESC to pause", 18);
-  sf::FloatRect controlsBounds = controlsText.getLocalBounds();
-  controlsText.setPosition(sf::Vector2f(
-      (m_windowWidth - controlsBounds.size.x) / 2.0f, m_windowHeight * 0.85f));
-  controlsText.setFillColor(sf::Color(150, 150, 180));
-  window.draw(controlsText);
+  window.draw(m_controlsText);
 }
 
 void UIManager::renderPauseOverlay(sf::RenderWindow &window) {
   // Semi-transparent overlay
-  sf::RectangleShape overlay(sf::Vector2f(static_cast<float>(m_windowWidth),
-                                          static_cast<float>(m_windowHeight)));
-  overlay.setFillColor(sf::Color(10, 5, 20, 180));
-  window.draw(overlay);
+  m_overlay.setFillColor(sf::Color(10, 5, 20, 180));
+  window.draw(m_overlay);
 
   if (!m_fontLoaded)
     return;
 
-  // Paused text
-  sf::Text pausedText(m_font, "PAUSED", 64);
-  sf::FloatRect bounds = pausedText.getLocalBounds();
-  pausedText.setPosition(sf::Vector2f((m_windowWidth - bounds.size.x) / 2.0f,
-                                      m_windowHeight * 0.4f));
-  pausedText.setFillColor(m_neonCyan);
-  pausedText.setOutlineColor(m_neonMagenta);
-  pausedText.setOutlineThickness(2.0f);
-  window.draw(pausedText);
-
-  // Resume hint
-  sf::Text resumeText(m_font, "Press ESC to Resume", 24);
-  sf::FloatRect resumeBounds = resumeText.getLocalBounds();
-  resumeText.setPosition(sf::Vector2f(
-      (m_windowWidth - resumeBounds.size.x) / 2.0f, m_windowHeight * 0.55f));
-  resumeText.setFillColor(sf::Color(200, 200, 220));
-  window.draw(resumeText);
+  window.draw(m_pausedText);
+  window.draw(m_resumeText);
 }
 
 void UIManager::renderGameOver(sf::RenderWindow &window,
                                const ScoreManager &score) {
   // Dark overlay
-  sf::RectangleShape overlay(sf::Vector2f(static_cast<float>(m_windowWidth),
-                                          static_cast<float>(m_windowHeight)));
-  overlay.setFillColor(sf::Color(20, 5, 30, 200));
-  window.draw(overlay);
+  m_overlay.setFillColor(sf::Color(20, 5, 30, 200));
+  window.draw(m_overlay);
 
   if (!m_fontLoaded)
     return;
 
-  // Game Over text
-  sf::Text gameOverText(m_font, "GAME OVER", 72);
-  sf::FloatRect bounds = gameOverText.getLocalBounds();
-  gameOverText.setPosition(sf::Vector2f((m_windowWidth - bounds.size.x) / 2.0f,
-                                        m_windowHeight * 0.25f));
-  gameOverText.setFillColor(sf::Color(255, 50, 100));
-  gameOverText.setOutlineColor(sf::Color(150, 0, 50));
-  gameOverText.setOutlineThickness(3.0f);
-  window.draw(gameOverText);
+  window.draw(m_gameOverText);
 
   // Final score
-  sf::Text scoreText(m_font, "FINAL SCORE: " + formatScore(score.getScore()),
-                     36);
-  sf::FloatRect scoreBounds = scoreText.getLocalBounds();
-  scoreText.setPosition(sf::Vector2f(
-      (m_windowWidth - scoreBounds.size.x) / 2.0f, m_windowHeight * 0.45f));
-  scoreText.setFillColor(m_neonCyan);
-  window.draw(scoreText);
+  setText(m_finalScoreText,
+          m_arena.format("FINAL SCORE: %08llu",
+                         static_cast<unsigned long long>(score.getScore())));
+  centerText(m_finalScoreText, m_windowHeight * 0.45f);
+  window.draw(m_finalScoreText);
 
   // Restart hint
   float pulse = (std::sin(m_menuPulse * 2.0f) + 1.0f) * 0.5f;
-  sf::Text restartText(m_font, "Press ENTER to Play Again", 28);
-  sf::FloatRect restartBounds = restartText.getLocalBounds();
-  restartText.setPosition(sf::Vector2f(
-      (m_windowWidth - restartBounds.size.x) / 2.0f, m_windowHeight * 0.65f));
-  restartText.setFillColor(
+  m_restartText.setFillColor(
       sf::Color(255, 255, 255, static_cast<std::uint8_t>(150 + 105 * pulse)));
-  window.draw(restartText);
+  window.draw(m_restartText);
 }
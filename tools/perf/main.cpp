@@ -0,0 +1,354 @@
+/**
+ * NeonDrift - Performance regression gate
+ * Replays a fixed set of recorded sessions headlessly through the full tick
+ * and render-preparation path (every simulation phase, snapshot building
+ * and HUD drawing) a few times each, and compares per-tick p99 times with a
+ * stored baseline. Any p99 beyond its threshold fails the run with a
+ * per-subsystem breakdown. Baselines are machine-specific: write one with
+ * --write-baseline on the machine that runs the gate.
+ */
+
+#include "core/IniReader.hpp"
+#include "core/InputRecording.hpp"
+#include "core/LatencyTracker.hpp"
+#include "core/Simulation.hpp"
+#include "ui/UIManager.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct PerfOptions {
+  std::filesystem::path sessionsPath = "perf/sessions.ini";
+  std::filesystem::path baselinePath = "perf/baseline.ini";
+  bool writeBaseline = false;
+  int repeats = 5;         // Runs per session; medians are compared
+  float tolerance = 0.10f; // Allowed p99 growth (fraction)
+};
+
+/**
+ * One recorded session: controls from a recording, obstacles from a seed
+ */
+struct Session {
+  std::string name;
+  std::filesystem::path recording;
+  std::uint32_t seed = 1;
+};
+
+// Timed per tick: the simulation phases, then render preparation and totals
+constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(TickPhase::Count);
+constexpr std::size_t SNAPSHOT = PHASE_COUNT; // Simulation::writeSnapshot
+constexpr std::size_t HUD = PHASE_COUNT + 1;  // UIManager::renderHUD
+constexpr std::size_t TICK = PHASE_COUNT + 2; // Whole simulation tick
+constexpr std::size_t FRAME = PHASE_COUNT + 3; // Tick, snapshot and HUD
+constexpr std::size_t METRIC_COUNT = PHASE_COUNT + 4;
+
+constexpr std::size_t WARMUP_TICKS = 60; // Pools and buffers still growing
+constexpr unsigned int HUD_WIDTH = 1280;
+constexpr unsigned int HUD_HEIGHT = 720;
+
+// Threshold over the baseline p99: the largest of the tolerance, a
+// multiple of the baseline's run-to-run spread and a floor for phases
+// that take microseconds
+constexpr float SPREAD_FACTOR = 3.0f;
+constexpr float MIN_SLACK_MS = 0.001f;
+
+const char *metricName(std::size_t metric) {
+  if (metric < PHASE_COUNT)
+    return TickProfile::phaseName(static_cast<TickPhase>(metric));
+  switch (metric) {
+  case SNAPSHOT:
+    return "snapshot";
+  case HUD:
+    return "hud";
+  case TICK:
+    return "tick";
+  default:
+    return "frame";
+  }
+}
+
+/**
+ * Per-tick distribution of one metric, in milliseconds
+ */
+struct MetricStats {
+  float p50 = 0.0f;
+  float p99 = 0.0f;
+  float spread = 0.0f; // Median absolute deviation of p99 across runs
+};
+
+using SessionStats = std::array<MetricStats, METRIC_COUNT>;
+using Samples = std::array<std::vector<float>, METRIC_COUNT>;
+
+void printUsage() {
+  std::printf("Usage: NeonDriftPerf [--sessions <file>] [--baseline <file>] "
+              "[--write-baseline] [--repeats <n>] [--tolerance <percent>]\n");
+}
+
+bool parseArgs(int argc, char *argv[], PerfOptions &options) {
+  for (int i = 1; i < argc; ++i) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--sessions") == 0 && hasValue)
+      options.sessionsPath = argv[++i];
+    else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+      options.baselinePath = argv[++i];
+    else if (std::strcmp(argv[i], "--write-baseline") == 0)
+      options.writeBaseline = true;
+    else if (std::strcmp(argv[i], "--repeats") == 0 && hasValue)
+      options.repeats = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue)
+      options.tolerance = std::strtof(argv[++i], nullptr) / 100.0f;
+    else
+      return false;
+  }
+  return options.repeats > 0 && options.tolerance >= 0.0f;
+}
+
+// Walk "key = value" lines inside a section; keys outside one are skipped
+template <typename OnKey>
+bool readIni(const std::filesystem::path &path, OnKey onKey) {
+  return ini::read(
+      path, [](const std::string &) {},
+      [&](const std::string &section, const std::string &key,
+          const std::string &value) {
+        if (!section.empty())
+          onKey(section, key, value);
+      });
+}
+
+// Sessions in manifest order; recordings are relative to the manifest
+std::vector<Session> loadSessions(const std::filesystem::path &path) {
+  std::vector<Session> sessions;
+  std::filesystem::path directory = path.parent_path();
+  readIni(path, [&](const std::string &section, const std::string &key,
+                    const std::string &value) {
+    if (sessions.empty() || sessions.back().name != section) {
+      sessions.emplace_back();
+      sessions.back().name = section;
+    }
+    if (key == "recording")
+      sessions.back().recording = directory / value;
+    else if (key == "seed")
+      sessions.back().seed =
+          static_cast<std::uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+  });
+  return sessions;
+}
+
+// "metric = p50 p99 spread" per session section
+std::map<std::string, SessionStats>
+loadBaseline(const std::filesystem::path &path) {
+  std::map<std::string, SessionStats> baseline;
+  readIni(path, [&](const std::string &section, const std::string &key,
+                    const std::string &value) {
+    for (std::size_t metric = 0; metric < METRIC_COUNT; ++metric) {
+      if (key != metricName(metric))
+        continue;
+      MetricStats &stats = baseline[section][metric];
+      std::istringstream(value) >> stats.p50 >> stats.p99 >> stats.spread;
+    }
+  });
+  return baseline;
+}
+
+bool writeBaseline(const std::filesystem::path &path,
+                   const std::vector<Session> &sessions,
+                   const std::vector<SessionStats> &results) {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file)
+    return false;
+  file << "# NeonDriftPerf baseline: per-tick p50, p99 and p99 spread (ms)\n";
+  for (std::size_t i = 0; i < sessions.size(); ++i) {
+    file << "\n[" << sessions[i].name << "]\n";
+    for (std::size_t metric = 0; metric < METRIC_COUNT; ++metric) {
+      const MetricStats &stats = results[i][metric];
+      file << metricName(metric) << " = " << stats.p50 << ' ' << stats.p99
+           << ' ' << stats.spread << '\n';
+    }
+  }
+  return static_cast<bool>(file);
+}
+
+// Play the recording once, appending every tick's timings after warm-up
+void playSession(const Session &session, const InputRecording &recording,
+                 sf::RenderTarget &hudTarget, UIManager &ui,
+                 FrameArena &arena, Samples &samples) {
+  Simulation simulation(session.seed);
+  simulation.loadEffects("assets/effects/emitters.ini");
+  simulation.loadPhysics("assets/physics/handling.ini");
+  simulation.enableProfiling();
+  simulation.handleKey(sf::Keyboard::Key::Enter, true);
+  simulation.handleKey(sf::Keyboard::Key::Enter, false);
+
+  FrameSnapshot snapshot;
+  for (std::size_t tick = 0; tick < recording.ticks.size(); ++tick) {
+    std::int64_t start = LatencyTracker::now();
+    simulation.step(recording.ticks[tick]);
+    std::int64_t stepped = LatencyTracker::now();
+    simulation.writeSnapshot(snapshot);
+    std::int64_t prepared = LatencyTracker::now();
+    ui.setPulse(snapshot.uiPulse);
+    ui.renderHUD(hudTarget, snapshot.score, snapshot.playerSpeed);
+    std::int64_t drawn = LatencyTracker::now();
+    arena.reset();
+
+    if (tick < WARMUP_TICKS)
+      continue;
+    const TickProfile &profile = simulation.getTickProfile();
+    for (std::size_t phase = 0; phase < PHASE_COUNT; ++phase)
+      samples[phase].push_back(profile.ms[phase]);
+    samples[SNAPSHOT].push_back((prepared - stepped) * 1.0e-6f);
+    samples[HUD].push_back((drawn - prepared) * 1.0e-6f);
+    samples[TICK].push_back((stepped - start) * 1.0e-6f);
+    samples[FRAME].push_back((drawn - start) * 1.0e-6f);
+  }
+}
+
+// Median p50/p99 over the runs, with the p99s' median absolute deviation
+MetricStats summarize(std::vector<float> &p50s, std::vector<float> &p99s) {
+  MetricStats stats;
+  stats.p50 = percentile(p50s, 0.5f);
+  stats.p99 = percentile(p99s, 0.5f);
+  std::vector<float> deviations;
+  for (float p99 : p99s)
+    deviations.push_back(std::abs(p99 - stats.p99));
+  stats.spread = percentile(deviations, 0.5f);
+  return stats;
+}
+
+SessionStats measureSession(const Session &session,
+                            const InputRecording &recording, int repeats,
+                            sf::RenderTarget &hudTarget, UIManager &ui,
+                            FrameArena &arena) {
+  std::array<std::vector<float>, METRIC_COUNT> p50s;
+  std::array<std::vector<float>, METRIC_COUNT> p99s;
+  Samples samples;
+  for (std::vector<float> &values : samples)
+    values.reserve(recording.ticks.size());
+
+  for (int run = 0; run < repeats; ++run) {
+    for (std::vector<float> &values : samples)
+      values.clear();
+    playSession(session, recording, hudTarget, ui, arena, samples);
+    for (std::size_t metric = 0; metric < METRIC_COUNT; ++metric) {
+      p50s[metric].push_back(percentile(samples[metric], 0.50f));
+      p99s[metric].push_back(percentile(samples[metric], 0.99f));
+    }
+  }
+
+  SessionStats stats;
+  for (std::size_t metric = 0; metric < METRIC_COUNT; ++metric)
+    stats[metric] = summarize(p50s[metric], p99s[metric]);
+  return stats;
+}
+
+// Print the breakdown against the baseline; true if any p99 regressed
+bool compareSession(const std::string &name, const SessionStats &current,
+                    const SessionStats &baseline, float tolerance) {
+  std::printf("\n%s (microseconds per tick)\n", name.c_str());
+  std::printf("  %-10s %10s %10s %10s %8s\n", "metric", "p50", "base p99",
+              "p99", "change");
+  bool regressed = false;
+  for (std::size_t metric = 0; metric < METRIC_COUNT; ++metric) {
+    const MetricStats &base = baseline[metric];
+    const MetricStats &now = current[metric];
+    float slack = std::max({base.p99 * tolerance, base.spread * SPREAD_FACTOR,
+                            MIN_SLACK_MS});
+    bool worse = now.p99 > base.p99 + slack;
+    float change =
+        base.p99 > 0.0f ? (now.p99 - base.p99) / base.p99 * 100.0f : 0.0f;
+    std::printf("  %-10s %10.2f %10.2f %10.2f %+7.1f%%%s\n",
+                metricName(metric), now.p50 * 1000.0f, base.p99 * 1000.0f,
+                now.p99 * 1000.0f, change, worse ? "  REGRESSED" : "");
+    regressed |= worse;
+  }
+  return regressed;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  PerfOptions options;
+  if (!parseArgs(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<Session> sessions = loadSessions(options.sessionsPath);
+  std::vector<InputRecording> recordings(sessions.size());
+  for (std::size_t i = 0; i < sessions.size(); ++i) {
+    if (!recordings[i].load(sessions[i].recording)) {
+      std::fprintf(stderr, "Cannot read recording %s\n",
+                   sessions[i].recording.string().c_str());
+      return 1;
+    }
+  }
+  if (sessions.empty()) {
+    std::fprintf(stderr, "No sessions in %s\n",
+                 options.sessionsPath.string().c_str());
+    return 1;
+  }
+
+  // The HUD draws into an offscreen texture like the game's world layer
+  sf::RenderTexture hudTarget;
+  if (!hudTarget.resize({HUD_WIDTH, HUD_HEIGHT})) {
+    std::fprintf(stderr, "Cannot create a %ux%u render texture\n", HUD_WIDTH,
+                 HUD_HEIGHT);
+    return 1;
+  }
+  FrameArena arena;
+  UIManager ui(arena);
+  ui.init(HUD_WIDTH, HUD_HEIGHT);
+
+  std::vector<SessionStats> results;
+  for (std::size_t i = 0; i < sessions.size(); ++i) {
+    std::printf("Replaying %s: %zu ticks x %d\n", sessions[i].name.c_str(),
+                recordings[i].ticks.size(), options.repeats);
+    std::fflush(stdout);
+    results.push_back(measureSession(sessions[i], recordings[i],
+                                     options.repeats, hudTarget, ui, arena));
+  }
+
+  if (options.writeBaseline) {
+    if (!writeBaseline(options.baselinePath, sessions, results)) {
+      std::fprintf(stderr, "Cannot write %s\n",
+                   options.baselinePath.string().c_str());
+      return 1;
+    }
+    std::printf("Baseline written to %s\n",
+                options.baselinePath.string().c_str());
+    return 0;
+  }
+
+  std::map<std::string, SessionStats> baseline =
+      loadBaseline(options.baselinePath);
+  bool regressed = false;
+  bool missing = false;
+  for (std::size_t i = 0; i < sessions.size(); ++i) {
+    auto found = baseline.find(sessions[i].name);
+    if (found == baseline.end()) {
+      std::fprintf(stderr, "No baseline for %s in %s (run --write-baseline)\n",
+                   sessions[i].name.c_str(),
+                   options.baselinePath.string().c_str());
+      missing = true;
+      continue;
+    }
+    regressed |= compareSession(sessions[i].name, results[i], found->second,
+                                options.tolerance);
+  }
+
+  if (missing)
+    return 1;
+  std::printf("\n%s\n", regressed ? "FAIL: p99 regressed" : "PASS");
+  return regressed ? 2 : 0;
+}
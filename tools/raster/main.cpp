@@ -0,0 +1,199 @@
+/**
+ * NeonDrift - Headless reference rendering
+ * Plays a game (the bot driving, or a recorded session) and draws the world
+ * of every tick with the CPU rasterizer, so it runs on build machines with
+ * no OpenGL context. Reports draw calls, triangles, overdraw and raster
+ * time per frame, can save the last frame as a golden image and checks the
+ * last frame against one.
+ */
+
+#include "core/InputRecording.hpp"
+#include "core/Simulation.hpp"
+#include "graphics/BackgroundLayer.hpp"
+#include "graphics/CpuRasterizer.hpp"
+#include "graphics/EntityRenderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+struct RasterOptions {
+  std::filesystem::path replayPath; // Empty = bot driver
+  std::filesystem::path output;     // Save the last frame (PNG)
+  std::filesystem::path golden;     // Compare the last frame
+  double seconds = 10.0;            // Bot play time
+  std::uint32_t seed = 1;
+  int tolerance = 2; // Largest channel difference that still matches
+};
+
+constexpr unsigned int WIDTH = 1280;
+constexpr unsigned int HEIGHT = 720;
+
+void printUsage() {
+  std::printf("Usage: NeonDriftRaster [--seconds <n>] [--seed <n>] "
+              "[--replay <recording>] [--output <frame.png>] "
+              "[--golden <frame.png>] [--tolerance <n>]\n");
+}
+
+bool parseArgs(int argc, char *argv[], RasterOptions &options) {
+  for (int i = 1; i < argc; ++i) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--replay") == 0 && hasValue)
+      options.replayPath = argv[++i];
+    else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+      options.output = argv[++i];
+    else if (std::strcmp(argv[i], "--golden") == 0 && hasValue)
+      options.golden = argv[++i];
+    else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue)
+      options.seconds = std::strtod(argv[++i], nullptr);
+    else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+      options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i],
+                                                             nullptr, 10));
+    else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue)
+      options.tolerance = std::atoi(argv[++i]);
+    else
+      return false;
+  }
+  return options.seconds > 0.0;
+}
+
+// Pixels of frame differing from golden by more than tolerance in any
+// channel (every pixel when the sizes differ)
+std::size_t countMismatches(const CpuRasterizer &frame,
+                            const sf::Image &golden, int tolerance) {
+  sf::Vector2u size = frame.getSize();
+  std::size_t pixels = std::size_t(size.x) * size.y;
+  if (golden.getSize() != size)
+    return pixels;
+
+  const std::uint8_t *a = frame.getPixels();
+  const std::uint8_t *b = golden.getPixelsPtr();
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < pixels; ++i) {
+    for (int c = 0; c < 4; ++c) {
+      if (std::abs(int(a[i * 4 + c]) - int(b[i * 4 + c])) > tolerance) {
+        ++mismatches;
+        break;
+      }
+    }
+  }
+  return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  RasterOptions options;
+  if (!parseArgs(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  InputRecording recording;
+  if (!options.replayPath.empty() && !recording.load(options.replayPath)) {
+    std::fprintf(stderr, "Cannot read recording %s\n",
+                 options.replayPath.string().c_str());
+    return 1;
+  }
+
+  Simulation simulation(options.seed);
+  simulation.loadEffects("assets/effects/emitters.ini");
+  simulation.loadPhysics("assets/physics/handling.ini");
+  bool replay = !options.replayPath.empty();
+  if (!replay)
+    simulation.enableBot(options.seed);
+  simulation.handleKey(sf::Keyboard::Key::Enter, true);
+  simulation.handleKey(sf::Keyboard::Key::Enter, false);
+
+  CpuRasterizer raster({WIDTH, HEIGHT});
+  EntityRenderer entities;
+  CommandList commands;
+  FrameSnapshot snapshot;
+
+  const std::size_t ticks =
+      replay ? recording.ticks.size()
+             : static_cast<std::size_t>(options.seconds *
+                                        Simulation::TICK_RATE);
+  std::size_t frames = 0;
+  std::size_t submissions = 0;
+  double totalMs = 0.0;
+  double maxMs = 0.0;
+  for (std::size_t tick = 0; tick < ticks; ++tick) {
+    // Recorded controls drive the car instead of the bot
+    if (replay)
+      simulation.step(recording.ticks[tick]);
+    else
+      simulation.step();
+    if (simulation.getState() != GameState::Playing)
+      break;
+    simulation.writeSnapshot(snapshot);
+
+    // The world's geometry as the game submits it (the grid, skid marks
+    // and HUD are drawn from GPU textures and are left out)
+    sf::View view(sf::FloatRect({0.0f, 0.0f}, sf::Vector2f(WIDTH, HEIGHT)));
+    view.setCenter(snapshot.cameraCenter + snapshot.screenShake);
+    auto start = std::chrono::steady_clock::now();
+    raster.clear(BackgroundLayer::BACKGROUND_COLOR);
+    commands.clear();
+    DriftRibbon::render(commands, snapshot.trailVertices,
+                        snapshot.trailVertexCount);
+    ParticleSystem::render(commands, snapshot.particleVertices,
+                           snapshot.particleVertexCount);
+    raster.draw(commands, view);
+    submissions += commands.getSubmissionCount();
+    commands.clear();
+    entities.render(commands, snapshot.entities);
+    raster.draw(commands, view);
+    submissions += commands.getSubmissionCount();
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    totalMs += ms;
+    maxMs = std::max(maxMs, ms);
+    ++frames;
+  }
+  if (frames == 0) {
+    std::fprintf(stderr, "No frames played\n");
+    return 1;
+  }
+
+  const CpuRasterizer::Stats &stats = raster.getStats();
+  std::printf("Rasterized %zu frames at %ux%u\n", frames, WIDTH, HEIGHT);
+  std::printf("Per frame: %.1f draw calls (%.1f submissions), %.0f "
+              "triangles, overdraw %.2fx, %.3f ms (max %.3f)\n",
+              double(stats.batches) / frames, double(submissions) / frames,
+              double(stats.triangles) / frames, raster.getOverdraw() / frames,
+              totalMs / frames, maxMs);
+
+  sf::Image image = raster.toImage();
+  if (!options.output.empty()) {
+    if (!image.saveToFile(options.output)) {
+      std::fprintf(stderr, "Cannot write %s\n",
+                   options.output.string().c_str());
+      return 1;
+    }
+    std::printf("Last frame saved to %s\n", options.output.string().c_str());
+  }
+
+  if (!options.golden.empty()) {
+    sf::Image golden;
+    if (!golden.loadFromFile(options.golden)) {
+      std::fprintf(stderr, "Cannot read golden image %s\n",
+                   options.golden.string().c_str());
+      return 1;
+    }
+    std::size_t mismatches = countMismatches(raster, golden,
+                                             options.tolerance);
+    std::printf("Golden %s: %s (%zu pixels off by more than %d)\n",
+                options.golden.string().c_str(),
+                mismatches == 0 ? "match" : "MISMATCH", mismatches,
+                options.tolerance);
+    if (mismatches > 0)
+      return 2;
+  }
+  return 0;
+}
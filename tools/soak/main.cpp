@@ -0,0 +1,224 @@
+/**
+ * NeonDrift - Soak runner
+ * Plays many independent headless games in parallel with the scripted bot
+ * driver and reports throughput, memory high-water mark and the score
+ * distribution, so long unattended runs can be compared build to build
+ */
+
+#include "core/LatencyTracker.hpp"
+#include "core/Simulation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define NEONDRIFT_HAS_RUSAGE 1
+#endif
+
+namespace {
+
+struct SoakOptions {
+  unsigned games = 0;   // 0 = one per thread
+  unsigned threads = 0; // 0 = all cores
+  double minutes = 1.0; // Simulated play time per game
+  std::uint32_t seed = 1;
+};
+
+struct GameResult {
+  std::uint64_t score = 0;
+  std::uint64_t ticks = 0;
+  ParticleSystem::PoolStats particles;
+};
+
+void printUsage() {
+  std::printf("Usage: NeonDriftSoak [--games <n>] [--threads <n>] "
+              "[--minutes <simulated minutes per game>] [--seed <n>]\n");
+}
+
+bool parseArgs(int argc, char *argv[], SoakOptions &options) {
+  for (int i = 1; i < argc; ++i) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--games") == 0 && hasValue)
+      options.games = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+      options.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--minutes") == 0 && hasValue)
+      options.minutes = std::strtod(argv[++i], nullptr);
+    else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+      options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i],
+                                                             nullptr, 10));
+    else
+      return false;
+  }
+  return options.minutes > 0.0;
+}
+
+// Peak resident set size of the process in KiB (0 if unavailable)
+long peakMemoryKiB() {
+#ifdef NEONDRIFT_HAS_RUSAGE
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+// Build configuration, so reports from different builds are comparable
+void printBuild() {
+#ifdef NEONDRIFT_DETERMINISTIC
+  const char *scalarType = "fixed-point";
+#else
+  const char *scalarType = "float";
+#endif
+#ifdef NDEBUG
+  const char *buildType = "optimized";
+#else
+  const char *buildType = "debug";
+#endif
+#ifdef __VERSION__
+  const char *compiler = __VERSION__;
+#else
+  const char *compiler = "unknown compiler";
+#endif
+  std::printf("Build: %s scalar, %s, %s\n", scalarType, buildType, compiler);
+}
+
+// One game from the menu: start, then let the bot drive for `ticks`
+GameResult playGame(std::uint32_t seed, std::uint64_t ticks,
+                    std::atomic<std::uint64_t> &ticksDone) {
+  Simulation simulation(seed);
+  simulation.enableBot(seed);
+  simulation.handleKey(sf::Keyboard::Key::Enter, true);
+
+  // Publish snapshots as the game would, so the render path soaks too
+  FrameSnapshot snapshot;
+  constexpr std::uint64_t PROGRESS_BATCH = 1024;
+  GameResult result;
+  for (std::uint64_t t = 0; t < ticks; ++t) {
+    simulation.step();
+    simulation.writeSnapshot(snapshot);
+    if ((t + 1) % PROGRESS_BATCH == 0)
+      ticksDone.fetch_add(PROGRESS_BATCH, std::memory_order_relaxed);
+  }
+  ticksDone.fetch_add(ticks % PROGRESS_BATCH, std::memory_order_relaxed);
+
+  result.score = simulation.getScore();
+  result.ticks = ticks;
+  result.particles = simulation.getParticlePoolStats();
+  return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  SoakOptions options;
+  if (!parseArgs(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  unsigned threadCount = options.threads;
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  unsigned gameCount = options.games ? options.games : threadCount;
+  threadCount = std::min(threadCount, gameCount);
+
+  const std::uint64_t ticksPerGame = static_cast<std::uint64_t>(
+      options.minutes * 60.0 * Simulation::TICK_RATE);
+  const std::uint64_t totalTicks = ticksPerGame * gameCount;
+
+  printBuild();
+  std::printf("Soaking %u games x %.1f simulated min on %u threads\n",
+              gameCount, options.minutes, threadCount);
+
+  std::vector<GameResult> results(gameCount);
+  std::atomic<unsigned> next{0};
+  std::atomic<std::uint64_t> ticksDone{0};
+  auto worker = [&]() {
+    for (unsigned i = next.fetch_add(1); i < gameCount; i = next.fetch_add(1))
+      results[i] = playGame(options.seed + i, ticksPerGame, ticksDone);
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < threadCount; ++t)
+    threads.emplace_back(worker);
+
+  // Progress once per second; memory still growing after warm-up is a leak
+  long warmMemory = 0;
+  std::uint64_t lastTicks = 0;
+  auto lastReport = start;
+  while (ticksDone.load(std::memory_order_relaxed) < totalTicks) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    auto now = std::chrono::steady_clock::now();
+    std::uint64_t done = ticksDone.load(std::memory_order_relaxed);
+    double seconds = std::chrono::duration<double>(now - lastReport).count();
+    long memory = peakMemoryKiB();
+    if (warmMemory == 0 && done >= totalTicks / 10)
+      warmMemory = memory;
+    std::printf("  %5.1f%%  %10.0f ticks/s  peak %ld KiB\n",
+                100.0 * done / totalTicks, (done - lastTicks) / seconds,
+                memory);
+    std::fflush(stdout);
+    lastTicks = done;
+    lastReport = now;
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  // Throughput and memory
+  long peakMemory = peakMemoryKiB();
+  std::printf("Ticks:     %llu in %.2f s (%.0f ticks/s, %.0f per thread)\n",
+              static_cast<unsigned long long>(totalTicks), elapsed,
+              totalTicks / elapsed, totalTicks / elapsed / threadCount);
+  std::printf("Memory:    peak %ld KiB", peakMemory);
+  if (warmMemory > 0)
+    std::printf(" (%+ld KiB after warm-up)", peakMemory - warmMemory);
+  std::printf("\n");
+
+  // Score distribution
+  std::vector<std::uint64_t> scores;
+  scores.reserve(results.size());
+  double scoreSum = 0.0;
+  for (const GameResult &result : results) {
+    scores.push_back(result.score);
+    scoreSum += static_cast<double>(result.score);
+  }
+  auto [lowest, highest] = std::minmax_element(scores.begin(), scores.end());
+  unsigned long long minScore = *lowest;
+  unsigned long long maxScore = *highest;
+  unsigned long long p10 = percentile(scores, 0.10f);
+  unsigned long long p50 = percentile(scores, 0.50f);
+  unsigned long long p90 = percentile(scores, 0.90f);
+  std::printf("Score:     min %llu  p10 %llu  p50 %llu  p90 %llu  max %llu  "
+              "mean %.0f\n",
+              minScore, p10, p50, p90, maxScore, scoreSum / scores.size());
+
+  // Particle pool pressure (the bot drifts a lot)
+  std::size_t dropped = 0, evicted = 0, peakLive = 0, chunks = 0;
+  for (const GameResult &result : results) {
+    dropped += result.particles.dropped;
+    evicted += result.particles.evicted;
+    peakLive = std::max(peakLive, result.particles.peakLive);
+    chunks = std::max(chunks, result.particles.allocatedChunks);
+  }
+  std::printf("Particles: peak %zu live  %zu chunks  %zu dropped  "
+              "%zu evicted\n",
+              peakLive, chunks, dropped, evicted);
+  return 0;
+}
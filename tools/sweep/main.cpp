@@ -0,0 +1,349 @@
+/**
+ * NeonDrift - Physics profile sweep
+ * Replays recorded driving input headless against a grid of handling
+ * profiles, one profile per task on all cores, and reports drift scoring
+ * and lap metrics for each
+ */
+
+#include "core/InputRecording.hpp"
+#include "core/ScoreManager.hpp"
+#include "entities/PhysicsProfile.hpp"
+#include "entities/Player.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * One swept parameter: steps values evenly spaced over [min, max]
+ */
+struct SweepAxis {
+  std::string key;
+  float min;
+  float max;
+  int steps;
+
+  float value(int index) const {
+    return steps > 1 ? min + (max - min) * index / (steps - 1) : min;
+  }
+};
+
+struct SweepOptions {
+  std::string replayPath;
+  float syntheticSeconds = 0.0f;
+  std::string basePath;
+  std::vector<std::pair<std::string, float>> overrides;
+  std::vector<SweepAxis> axes;
+  float lapLength = 5000.0f; // Distance driven per lap (px)
+  unsigned threads = 0;      // 0 = all cores
+  std::string csvPath;
+};
+
+struct SweepResult {
+  std::vector<float> values; // One per axis
+  std::uint64_t score = 0;
+  int drifts = 0;
+  float driftTime = 0.0f;    // Seconds spent drifting
+  float longestDrift = 0.0f; // Seconds
+  float distance = 0.0f;
+  float averageSpeed = 0.0f;
+  float topSpeed = 0.0f;
+  int laps = 0;
+  float bestLap = 0.0f; // Seconds, 0 if no lap was completed
+  float meanLap = 0.0f;
+};
+
+void printUsage() {
+  std::printf(
+      "Usage: NeonDriftSweep (--replay <file> | --synthetic <seconds>)\n"
+      "                      [--base <profile.ini>] [--set key=value]...\n"
+      "                      [--vary key=min:max:steps]... [--lap <px>]\n"
+      "                      [--threads <n>] [--csv <file>]\n");
+}
+
+bool parseAxis(const char *text, SweepAxis &axis) {
+  const char *equals = std::strchr(text, '=');
+  if (!equals)
+    return false;
+  axis.key.assign(text, equals);
+  return std::sscanf(equals + 1, "%f:%f:%d", &axis.min, &axis.max,
+                     &axis.steps) == 3 &&
+         axis.steps > 0;
+}
+
+bool parseArgs(int argc, char *argv[], SweepOptions &options) {
+  for (int i = 1; i < argc; ++i) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--replay") == 0 && hasValue) {
+      options.replayPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--synthetic") == 0 && hasValue) {
+      options.syntheticSeconds = std::strtof(argv[++i], nullptr);
+    } else if (std::strcmp(argv[i], "--base") == 0 && hasValue) {
+      options.basePath = argv[++i];
+    } else if (std::strcmp(argv[i], "--set") == 0 && hasValue) {
+      const char *text = argv[++i];
+      const char *equals = std::strchr(text, '=');
+      if (!equals)
+        return false;
+      options.overrides.emplace_back(std::string(text, equals),
+                                     std::strtof(equals + 1, nullptr));
+    } else if (std::strcmp(argv[i], "--vary") == 0 && hasValue) {
+      SweepAxis axis;
+      if (!parseAxis(argv[++i], axis))
+        return false;
+      options.axes.push_back(axis);
+    } else if (std::strcmp(argv[i], "--lap") == 0 && hasValue) {
+      options.lapLength = std::strtof(argv[++i], nullptr);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+      options.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+      options.csvPath = argv[++i];
+    } else {
+      return false;
+    }
+  }
+  return !options.replayPath.empty() || options.syntheticSeconds > 0.0f;
+}
+
+// Scripted laps of straights and alternating drifts, for sweeping without
+// a recording
+InputRecording syntheticInput(float seconds) {
+  struct Segment {
+    float seconds;
+    std::uint8_t bits;
+  };
+  const Segment pattern[] = {
+      {2.0f, ControlInput::Accelerate},
+      {1.5f, ControlInput::Accelerate | ControlInput::TurnRight |
+                 ControlInput::Drift},
+      {1.0f, ControlInput::Accelerate},
+      {1.5f, ControlInput::Accelerate | ControlInput::TurnLeft |
+                 ControlInput::Drift},
+      {0.5f, ControlInput::Brake},
+  };
+
+  InputRecording recording;
+  const std::size_t total =
+      static_cast<std::size_t>(seconds * recording.tickRate);
+  recording.ticks.reserve(total);
+  while (recording.ticks.size() < total) {
+    for (const Segment &segment : pattern) {
+      ControlInput controls;
+      controls.bits = segment.bits;
+      std::size_t ticks =
+          static_cast<std::size_t>(segment.seconds * recording.tickRate);
+      for (std::size_t t = 0; t < ticks && recording.ticks.size() < total; ++t)
+        recording.ticks.push_back(controls);
+    }
+  }
+  return recording;
+}
+
+// Drive a player through the recording; scoring follows Simulation (no
+// obstacles or pickups, so results depend on handling alone)
+SweepResult replay(const InputRecording &recording,
+                   const PhysicsProfile &profile, float lapLength) {
+  const SimScalar dt = scalar::fromRatio<SimScalar>(1, recording.tickRate);
+  const float dtSeconds = 1.0f / recording.tickRate;
+
+  Player player(profile);
+  ScoreManager score;
+  SweepResult result;
+  bool wasDrifting = false;
+  float driftLength = 0.0f;
+  float lapDistance = 0.0f;
+  float lapTime = 0.0f;
+  float lapTimeSum = 0.0f;
+  double speedSum = 0.0;
+
+  for (const ControlInput &controls : recording.ticks) {
+    sf::Vector2f before = player.getPosition();
+    player.update(dt, controls);
+    score.update(dt, player.getSimSpeed(), player.isDrifting(),
+                 player.getSimDriftAmount());
+
+    if (player.isDrifting()) {
+      if (!wasDrifting)
+        ++result.drifts;
+      driftLength += dtSeconds;
+      result.driftTime += dtSeconds;
+      result.longestDrift = std::max(result.longestDrift, driftLength);
+    } else {
+      if (wasDrifting)
+        score.onDriftEnd(player.getSimDriftAmount() * SimScalar(2.0f),
+                         player.getSimSpeed());
+      driftLength = 0.0f;
+    }
+    wasDrifting = player.isDrifting();
+
+    float speed = player.getSpeed();
+    speedSum += speed;
+    result.topSpeed = std::max(result.topSpeed, speed);
+
+    sf::Vector2f moved = player.getPosition() - before;
+    float step = moved.length();
+    result.distance += step;
+    lapDistance += step;
+    lapTime += dtSeconds;
+    if (lapLength > 0.0f && lapDistance >= lapLength) {
+      ++result.laps;
+      lapTimeSum += lapTime;
+      if (result.bestLap == 0.0f || lapTime < result.bestLap)
+        result.bestLap = lapTime;
+      lapDistance -= lapLength;
+      lapTime = 0.0f;
+    }
+  }
+
+  result.score = score.getScore();
+  if (!recording.ticks.empty())
+    result.averageSpeed =
+        static_cast<float>(speedSum / recording.ticks.size());
+  if (result.laps > 0)
+    result.meanLap = lapTimeSum / result.laps;
+  return result;
+}
+
+void writeCsv(const std::string &path, const SweepOptions &options,
+              const std::vector<SweepResult> &results) {
+  std::FILE *file = std::fopen(path.c_str(), "w");
+  if (!file) {
+    std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+    return;
+  }
+  for (const SweepAxis &axis : options.axes)
+    std::fprintf(file, "%s,", axis.key.c_str());
+  std::fprintf(file, "score,drifts,drift_time,longest_drift,distance,"
+                     "avg_speed,top_speed,laps,best_lap,mean_lap\n");
+  for (const SweepResult &r : results) {
+    for (float value : r.values)
+      std::fprintf(file, "%g,", value);
+    std::fprintf(file, "%llu,%d,%.3f,%.3f,%.1f,%.2f,%.2f,%d,%.3f,%.3f\n",
+                 static_cast<unsigned long long>(r.score), r.drifts,
+                 r.driftTime, r.longestDrift, r.distance, r.averageSpeed,
+                 r.topSpeed, r.laps, r.bestLap, r.meanLap);
+  }
+  std::fclose(file);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  SweepOptions options;
+  if (!parseArgs(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  // Input to replay
+  InputRecording recording;
+  if (!options.replayPath.empty()) {
+    if (!recording.load(options.replayPath)) {
+      std::fprintf(stderr, "Cannot read recording %s\n",
+                   options.replayPath.c_str());
+      return 1;
+    }
+  } else {
+    recording = syntheticInput(options.syntheticSeconds);
+  }
+
+  // Base profile every grid point starts from
+  PhysicsProfile base;
+  if (!options.basePath.empty() && !loadPhysicsProfile(options.basePath, base))
+    std::fprintf(stderr, "Cannot read %s, using defaults\n",
+                 options.basePath.c_str());
+  for (const auto &entry : options.overrides) {
+    if (!setPhysicsValue(base, entry.first, entry.second)) {
+      std::fprintf(stderr, "Unknown parameter %s\n", entry.first.c_str());
+      return 1;
+    }
+  }
+  for (const SweepAxis &axis : options.axes) {
+    PhysicsProfile probe;
+    if (!setPhysicsValue(probe, axis.key, 0.0f)) {
+      std::fprintf(stderr, "Unknown parameter %s\n", axis.key.c_str());
+      return 1;
+    }
+  }
+
+  std::size_t gridSize = 1;
+  for (const SweepAxis &axis : options.axes)
+    gridSize *= static_cast<std::size_t>(axis.steps);
+
+  unsigned threadCount = options.threads;
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  threadCount =
+      static_cast<unsigned>(std::min<std::size_t>(threadCount, gridSize));
+
+  std::printf("Replaying %zu ticks (%.1f s) against %zu profiles on %u "
+              "threads\n",
+              recording.ticks.size(),
+              static_cast<float>(recording.ticks.size()) / recording.tickRate,
+              gridSize, threadCount);
+
+  // Grid point i decodes to one index per axis (first axis fastest)
+  std::vector<SweepResult> results(gridSize);
+  std::atomic<std::size_t> next{0};
+  auto worker = [&]() {
+    for (std::size_t i = next.fetch_add(1); i < gridSize;
+         i = next.fetch_add(1)) {
+      PhysicsProfile profile = base;
+      std::vector<float> values;
+      std::size_t rest = i;
+      for (const SweepAxis &axis : options.axes) {
+        float value = axis.value(static_cast<int>(rest % axis.steps));
+        rest /= axis.steps;
+        setPhysicsValue(profile, axis.key, value);
+        values.push_back(value);
+      }
+      results[i] = replay(recording, profile, options.lapLength);
+      results[i].values = std::move(values);
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < threadCount; ++t)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread &thread : threads)
+    thread.join();
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::stable_sort(results.begin(), results.end(),
+                   [](const SweepResult &a, const SweepResult &b) {
+                     return a.score > b.score;
+                   });
+
+  // Table, best score first
+  for (const SweepAxis &axis : options.axes)
+    std::printf("%14s ", axis.key.c_str());
+  std::printf("%10s %6s %8s %8s %10s %8s %8s %5s %8s %8s\n", "score",
+              "drifts", "drift_s", "longest", "distance", "avg_spd",
+              "top_spd", "laps", "best_lap", "mean_lap");
+  for (const SweepResult &r : results) {
+    for (float value : r.values)
+      std::printf("%14g ", value);
+    std::printf("%10llu %6d %8.2f %8.2f %10.0f %8.1f %8.1f %5d %8.2f %8.2f\n",
+                static_cast<unsigned long long>(r.score), r.drifts,
+                r.driftTime, r.longestDrift, r.distance, r.averageSpeed,
+                r.topSpeed, r.laps, r.bestLap, r.meanLap);
+  }
+  std::printf("%zu profiles in %.3f s (%.0f ticks/s)\n", gridSize, elapsed,
+              elapsed > 0.0 ? gridSize * recording.ticks.size() / elapsed
+                            : 0.0);
+
+  if (!options.csvPath.empty())
+    writeCsv(options.csvPath, options, results);
+  return 0;
+}